@@ -33,7 +33,8 @@ public class InputStreamliner : ModuleRules
 			"ContentBrowser",
 			"EditorSubsystem",
 			"ToolMenus",
-			"Projects"
+			"Projects",
+			"SourceControl"
 		});
 	}
 }
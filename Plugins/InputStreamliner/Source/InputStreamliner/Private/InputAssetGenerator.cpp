@@ -1,7 +1,13 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "InputAssetGenerator.h"
+#include "InputGenerationManifest.h"
+#include "InputAssetManifest.h"
+#include "InputStreamlinerRuntimeSettings.h"
+#include "InputCodeGenerator.h"
+#include "InputKeyTraits.h"
 #include "InputStreamlinerModule.h"
+#include "InputStreamlinerMetrics.h"
 #include "InputAction.h"
 #include "InputMappingContext.h"
 #include "InputTriggers.h"
@@ -9,68 +15,374 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/SavePackage.h"
 #include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ScopedTransaction.h"
+#include "ObjectTools.h"
+#include "HAL/FileManager.h"
+#include "ISourceControlModule.h"
+#include "SourceControlHelpers.h"
+
+namespace InputAssetCleanup
+{
+	/** Assets loaded and deleted per step, so progress and cancellation stay responsive */
+	constexpr int32 DeleteBatchSize = 64;
+}
+
+namespace InputAssetGeneration
+{
+	/** Asset name of the runtime asset manifest */
+	const TCHAR* RuntimeManifestName = TEXT("DA_InputStreamlinerManifest");
+
+	/** Platforms whose bindings become an action's default keys, in order */
+	const ETargetPlatform DefaultKeyPlatforms[] = { ETargetPlatform::PC_Keyboard, ETargetPlatform::PC_Gamepad };
+}
 
 bool UInputAssetGenerator::GenerateInputAssets(const FInputStreamlinerConfiguration& Config, TArray<UObject*>& OutCreatedAssets)
 {
+	INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_GenerateInputAssets);
+
 	GeneratedActions.Empty();
 	OutCreatedAssets.Empty();
+	LastUnchangedCount = 0;
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Starting asset generation for %d actions"), Config.Actions.Num());
+	UE_LOG(LogInputStreamliner, Log, TEXT("Starting %s asset generation for %d actions"),
+		bIncrementalGeneration ? TEXT("incremental") : TEXT("full"), Config.Actions.Num());
 
-	// Generate Input Actions
-	for (const FInputActionDefinition& ActionDef : Config.Actions)
+	// The previous manifest is needed even for a full run so removed assets can be cleaned up
+	FInputGenerationManifest PreviousManifest;
+	if (!bTransientGeneration)
+	{
+		PreviousManifest.LoadFromDisk();
+	}
+
+	FInputGenerationManifest NewManifest;
+
+	auto IsUpToDate = [this](const FGeneratedAssetRecord* Record, const FString& AssetPath, const FString& Hash)
+	{
+		return bIncrementalGeneration && Record && Record->ContentHash == Hash && Record->AssetPath == AssetPath && DoesAssetExist(AssetPath);
+	};
+
+	const TArray<ETargetPlatform> Platforms = {
+		ETargetPlatform::PC_Keyboard,
+		ETargetPlatform::PC_Gamepad,
+		ETargetPlatform::Mac,
+		ETargetPlatform::iOS,
+		ETargetPlatform::Android
+	};
+
+	// One work unit per asset to create, plus one per asset to save (the runtime manifest included)
+	const int32 NumContexts = Config.bGenerateMappingContexts ? Platforms.Num() : 0;
+	const float TotalWork = static_cast<float>((Config.Actions.Num() + NumContexts + 1) * 2);
+
+	FScopedSlowTask SlowTask(TotalWork, NSLOCTEXT("InputStreamliner", "GeneratingAssets", "Generating input assets..."));
+	SlowTask.MakeDialog(true);
+
+	// Use the configuration's index when it is current, otherwise build one for this run
+	FInputConfigurationIndex LocalIndex;
+	if (!Config.IsIndexValid())
 	{
-		UInputAction* Action = GenerateInputAction(ActionDef, Config.InputActionsPath);
-		if (Action)
+		LocalIndex.Build(Config);
+	}
+	const FInputConfigurationIndex& Index = Config.IsIndexValid() ? Config.GetIndex() : LocalIndex;
+
+	TArray<UObject*> NewAssets;
+	bool bCancelled = false;
+	bool bHadErrors = false;
+
+	// Phase 1: create and configure every changed asset in memory
+	const double CreateStart = FPlatformTime::Seconds();
+	{
+		TOptional<FScopedTransaction> Transaction;
+		if (!bTransientGeneration)
 		{
-			GeneratedActions.Add(ActionDef.ActionName, Action);
-			OutCreatedAssets.Add(Action);
+			Transaction.Emplace(NSLOCTEXT("InputStreamliner", "GenerateInputAssetsTransaction", "Generate Input Assets"));
 		}
-		else
+
+		for (const FInputActionDefinition& ActionDef : Config.Actions)
 		{
-			UE_LOG(LogInputStreamliner, Error, TEXT("Failed to generate Input Action: %s"), *ActionDef.ActionName.ToString());
-		}
-	}
+			if (SlowTask.ShouldCancel())
+			{
+				bCancelled = true;
+				break;
+			}
+			SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("Creating IA_%s"), *ActionDef.ActionName.ToString())));
 
-	// Generate Mapping Contexts for each platform
-	if (Config.bGenerateMappingContexts)
-	{
-		TArray<ETargetPlatform> Platforms = {
-			ETargetPlatform::PC_Keyboard,
-			ETargetPlatform::PC_Gamepad,
-			ETargetPlatform::Mac,
-			ETargetPlatform::iOS,
-			ETargetPlatform::Android
-		};
+			FGeneratedAssetRecord Record;
+			Record.AssetPath = GetInputActionObjectPath(ActionDef.ActionName, Config.InputActionsPath);
+			Record.ContentHash = FInputGenerationManifest::HashActionDefinition(ActionDef);
 
-		for (ETargetPlatform Platform : Platforms)
+			if (IsUpToDate(PreviousManifest.Actions.Find(ActionDef.ActionName), Record.AssetPath, Record.ContentHash))
+			{
+				NewManifest.Actions.Add(ActionDef.ActionName, Record);
+				LastUnchangedCount++;
+				continue;
+			}
+
+			bool bIsNew = false;
+			UInputAction* Action = CreateInputActionObject(ActionDef, Config.InputActionsPath, bIsNew);
+			if (Action)
+			{
+				NewManifest.Actions.Add(ActionDef.ActionName, Record);
+				GeneratedActions.Add(ActionDef.ActionName, Action);
+				OutCreatedAssets.Add(Action);
+				if (bIsNew)
+				{
+					NewAssets.Add(Action);
+				}
+			}
+			else
+			{
+				bHadErrors = true;
+				UE_LOG(LogInputStreamliner, Error, TEXT("Failed to generate Input Action: %s"), *ActionDef.ActionName.ToString());
+			}
+		}
+
+		// Generate Mapping Contexts for each platform
+		for (int32 PlatformIndex = 0; PlatformIndex < NumContexts && !bCancelled; PlatformIndex++)
 		{
-			// Filter actions that target this platform
-			TArray<FInputActionDefinition> PlatformActions;
-			for (const FInputActionDefinition& ActionDef : Config.Actions)
+			const ETargetPlatform Platform = Platforms[PlatformIndex];
+			const FString PlatformName = GetPlatformName(Platform);
+
+			if (SlowTask.ShouldCancel())
+			{
+				bCancelled = true;
+				break;
+			}
+			SlowTask.EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("Creating IMC_%s"), *PlatformName)));
+
+			// Actions that target this platform
+			const TArray<int32>& PlatformActionIndices = Index.GetActionsForPlatform(Platform);
+			TArray<const FInputActionDefinition*> PlatformActions;
+			PlatformActions.Reserve(PlatformActionIndices.Num());
+			for (int32 ActionIndex : PlatformActionIndices)
+			{
+				PlatformActions.Add(&Config.Actions[ActionIndex]);
+			}
+
+			if (PlatformActions.Num() == 0)
 			{
-				if (ActionDef.TargetsPlatform(Platform))
+				continue;
+			}
+
+			FGeneratedAssetRecord Record;
+			Record.AssetPath = GetMappingContextObjectPath(Platform, Config.MappingContextsPath);
+			Record.ContentHash = FInputGenerationManifest::HashMappingContext(Platform, PlatformActions, Config.InputActionsPath);
+
+			if (IsUpToDate(PreviousManifest.MappingContexts.Find(PlatformName), Record.AssetPath, Record.ContentHash))
+			{
+				NewManifest.MappingContexts.Add(PlatformName, Record);
+				LastUnchangedCount++;
+				continue;
+			}
+
+			bool bIsNew = false;
+			UInputMappingContext* Context = CreateMappingContextObject(Platform, PlatformActions, Config.MappingContextsPath, Config, bIsNew);
+			if (Context)
+			{
+				NewManifest.MappingContexts.Add(PlatformName, Record);
+				OutCreatedAssets.Add(Context);
+				if (bIsNew)
 				{
-					PlatformActions.Add(ActionDef);
+					NewAssets.Add(Context);
 				}
 			}
+			else
+			{
+				bHadErrors = true;
+			}
+		}
+
+		// The runtime asset manifest, listing everything recorded above for the startup preload
+		if (!bCancelled && !bTransientGeneration && Config.Actions.Num() > 0)
+		{
+			SlowTask.EnterProgressFrame(1.0f, FText::FromString(InputAssetGeneration::RuntimeManifestName));
+
+			TArray<FString> MappingContextPaths;
+			for (const auto& Pair : NewManifest.MappingContexts)
+			{
+				MappingContextPaths.Add(Pair.Value.AssetPath);
+			}
+			MappingContextPaths.Sort();
 
-			if (PlatformActions.Num() > 0)
+			FGeneratedAssetRecord Record;
+			Record.AssetPath = GetRuntimeManifestObjectPath(Config.MappingContextsPath);
+			Record.ContentHash = FInputGenerationManifest::HashRuntimeManifest(Config.Actions, Config.InputActionsPath, MappingContextPaths);
+
+			if (IsUpToDate(&PreviousManifest.RuntimeManifest, Record.AssetPath, Record.ContentHash))
+			{
+				NewManifest.RuntimeManifest = Record;
+				LastUnchangedCount++;
+			}
+			else
 			{
-				UInputMappingContext* Context = GenerateMappingContext(Platform, PlatformActions, Config.MappingContextsPath, Config);
-				if (Context)
+				bool bIsNew = false;
+				UInputAssetManifest* RuntimeManifest = CreateRuntimeManifestObject(Config, NewManifest, bIsNew);
+				if (RuntimeManifest)
 				{
-					OutCreatedAssets.Add(Context);
+					NewManifest.RuntimeManifest = Record;
+					OutCreatedAssets.Add(RuntimeManifest);
+					if (bIsNew)
+					{
+						NewAssets.Add(RuntimeManifest);
+					}
+				}
+				else
+				{
+					bHadErrors = true;
 				}
 			}
 		}
 	}
+	const double CreateSeconds = FPlatformTime::Seconds() - CreateStart;
+
+	if (bCancelled)
+	{
+		// Nothing has been registered or written yet: discard the new objects
+		for (UObject* Asset : NewAssets)
+		{
+			Asset->ClearFlags(RF_Public | RF_Standalone);
+			Asset->MarkAsGarbage();
+		}
+
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Asset generation cancelled before saving; no files were written"));
+		GeneratedActions.Empty();
+		OutCreatedAssets.Empty();
+		return false;
+	}
+
+	// Phase 2: notify the asset registry about every new asset in one batch
+	const double RegisterStart = FPlatformTime::Seconds();
+	for (UObject* Asset : NewAssets)
+	{
+		FAssetRegistryModule::AssetCreated(Asset);
+	}
+	const double RegisterSeconds = FPlatformTime::Seconds() - RegisterStart;
+
+	if (bTransientGeneration)
+	{
+		// Nothing touches disk: no packages, manifest, project settings or C++ header
+		UE_LOG(LogInputStreamliner, Log, TEXT("Transient asset generation complete. Created %d assets in memory. Create %.1f ms, register %.1f ms"),
+			OutCreatedAssets.Num(), CreateSeconds * 1000.0, RegisterSeconds * 1000.0);
+		return !bHadErrors && OutCreatedAssets.Num() > 0;
+	}
+
+	// Phase 3: save all changed packages in one pass
+	const double SaveStart = FPlatformTime::Seconds();
+	bool bSaveCancelled = false;
+	const int32 NumSaved = SaveAssets(OutCreatedAssets, &SlowTask, &bSaveCancelled);
+	const double SaveSeconds = FPlatformTime::Seconds() - SaveStart;
+
+	if (bSaveCancelled || NumSaved < OutCreatedAssets.Num() || bHadErrors)
+	{
+		// The new manifest would record assets that are not on disk, and the stale pass would delete
+		// the previous version of any asset that failed; keep the previous manifest so the next run redoes the work
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Asset generation %s after saving %d of %d assets; the generation manifest was not updated and no assets were removed"),
+			bSaveCancelled ? TEXT("cancelled") : TEXT("failed"), NumSaved, OutCreatedAssets.Num());
+		return false;
+	}
+
+	// Phase 4: remove assets from earlier runs that the configuration no longer produces
+	const double CleanupStart = FPlatformTime::Seconds();
+	const TSet<FString> CurrentPaths(NewManifest.GetAllAssetPaths());
+	TArray<FString> StalePaths;
+	for (const FString& AssetPath : PreviousManifest.GetAllAssetPaths())
+	{
+		if (!CurrentPaths.Contains(AssetPath))
+		{
+			StalePaths.Add(AssetPath);
+		}
+	}
+	const int32 NumDeleted = DeleteAssets(StalePaths, nullptr);
+	const double CleanupSeconds = FPlatformTime::Seconds() - CleanupStart;
+
+	NewManifest.SaveToDisk();
+
+	if (!NewManifest.RuntimeManifest.AssetPath.IsEmpty())
+	{
+		RegisterRuntimeManifest(NewManifest.RuntimeManifest.AssetPath);
+	}
+
+	// Phase 5: the C++ action table, listing the mapping contexts this run produced
+	const double CodeGenStart = FPlatformTime::Seconds();
+	if (Config.CodeGenType != ECodeGenerationType::Blueprint)
+	{
+		TArray<FString> MappingContextPaths;
+		for (const auto& Pair : NewManifest.MappingContexts)
+		{
+			MappingContextPaths.Add(Pair.Value.AssetPath);
+		}
+		MappingContextPaths.Sort();
+
+		if (!FInputCodeGenerator::WriteActionTableHeader(Config, MappingContextPaths))
+		{
+			bHadErrors = true;
+		}
+	}
+	const double CodeGenSeconds = FPlatformTime::Seconds() - CodeGenStart;
+
+	FInputStreamlinerMetrics::Record(TEXT("Generator.CreateMs"), CreateSeconds * 1000.0);
+	FInputStreamlinerMetrics::Record(TEXT("Generator.RegisterMs"), RegisterSeconds * 1000.0);
+	FInputStreamlinerMetrics::Record(TEXT("Generator.SaveMs"), SaveSeconds * 1000.0);
+	FInputStreamlinerMetrics::Record(TEXT("Generator.CleanupMs"), CleanupSeconds * 1000.0);
+	FInputStreamlinerMetrics::Record(TEXT("Generator.CodeGenMs"), CodeGenSeconds * 1000.0);
+	FInputStreamlinerMetrics::Record(TEXT("Generator.AssetsRegenerated"), OutCreatedAssets.Num());
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Asset generation complete. Created %d assets."), OutCreatedAssets.Num());
-	return OutCreatedAssets.Num() > 0;
+	UE_LOG(LogInputStreamliner, Log, TEXT("Asset generation complete. Regenerated %d assets (%d new), %d unchanged, saved %d, deleted %d. Create %.1f ms, register %.1f ms, save %.1f ms, cleanup %.1f ms, code %.1f ms"),
+		OutCreatedAssets.Num(), NewAssets.Num(), LastUnchangedCount, NumSaved, NumDeleted,
+		CreateSeconds * 1000.0, RegisterSeconds * 1000.0, SaveSeconds * 1000.0, CleanupSeconds * 1000.0, CodeGenSeconds * 1000.0);
+
+	return !bHadErrors && (OutCreatedAssets.Num() > 0 || LastUnchangedCount > 0);
 }
 
 UInputAction* UInputAssetGenerator::GenerateInputAction(const FInputActionDefinition& Definition, const FString& Path)
+{
+	bool bIsNew = false;
+	UInputAction* InputAction = CreateInputActionObject(Definition, Path, bIsNew);
+	if (!InputAction)
+	{
+		return nullptr;
+	}
+
+	if (bIsNew)
+	{
+		FAssetRegistryModule::AssetCreated(InputAction);
+	}
+
+	SaveAssets({ InputAction }, nullptr);
+	return InputAction;
+}
+
+UInputMappingContext* UInputAssetGenerator::GenerateMappingContext(
+	ETargetPlatform Platform,
+	const TArray<FInputActionDefinition>& Actions,
+	const FString& Path,
+	const FInputStreamlinerConfiguration& Config)
+{
+	TArray<const FInputActionDefinition*> ActionPtrs;
+	ActionPtrs.Reserve(Actions.Num());
+	for (const FInputActionDefinition& ActionDef : Actions)
+	{
+		ActionPtrs.Add(&ActionDef);
+	}
+
+	bool bIsNew = false;
+	UInputMappingContext* Context = CreateMappingContextObject(Platform, ActionPtrs, Path, Config, bIsNew);
+	if (!Context)
+	{
+		return nullptr;
+	}
+
+	if (bIsNew)
+	{
+		FAssetRegistryModule::AssetCreated(Context);
+	}
+
+	SaveAssets({ Context }, nullptr);
+	return Context;
+}
+
+UInputAction* UInputAssetGenerator::CreateInputActionObject(const FInputActionDefinition& Definition, const FString& Path, bool& bOutIsNew)
 {
 	FString AssetName = FString::Printf(TEXT("IA_%s"), *Definition.ActionName.ToString());
 	FString PackagePath = Path / AssetName;
@@ -85,8 +397,19 @@ UInputAction* UInputAssetGenerator::GenerateInputAction(const FInputActionDefini
 
 	Package->FullyLoad();
 
-	// Create Input Action
-	UInputAction* InputAction = NewObject<UInputAction>(Package, *AssetName, RF_Public | RF_Standalone);
+	// Update an existing Input Action in place so the change can be undone
+	UInputAction* InputAction = FindObject<UInputAction>(Package, *AssetName);
+	bOutIsNew = InputAction == nullptr;
+
+	if (InputAction)
+	{
+		InputAction->Modify();
+	}
+	else
+	{
+		InputAction = NewObject<UInputAction>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+	}
+
 	if (!InputAction)
 	{
 		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to create Input Action object"));
@@ -113,30 +436,18 @@ UInputAction* UInputAssetGenerator::GenerateInputAction(const FInputActionDefini
 	// Configure triggers
 	ConfigureActionTriggers(InputAction, Definition);
 
-	// Mark package dirty and register with asset registry
 	Package->MarkPackageDirty();
-	FAssetRegistryModule::AssetCreated(InputAction);
-
-	// Save package
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension());
-
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-
-	if (!UPackage::SavePackage(Package, InputAction, *PackageFileName, SaveArgs))
-	{
-		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to save package: %s"), *PackageFileName);
-	}
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Generated Input Action: %s"), *AssetName);
+	UE_LOG(LogInputStreamliner, Verbose, TEXT("Prepared Input Action: %s"), *AssetName);
 	return InputAction;
 }
 
-UInputMappingContext* UInputAssetGenerator::GenerateMappingContext(
+UInputMappingContext* UInputAssetGenerator::CreateMappingContextObject(
 	ETargetPlatform Platform,
-	const TArray<FInputActionDefinition>& Actions,
+	const TArray<const FInputActionDefinition*>& Actions,
 	const FString& Path,
-	const FInputStreamlinerConfiguration& Config)
+	const FInputStreamlinerConfiguration& Config,
+	bool& bOutIsNew)
 {
 	FString PlatformName = GetPlatformName(Platform);
 	FString AssetName = FString::Printf(TEXT("IMC_%s"), *PlatformName);
@@ -151,18 +462,31 @@ UInputMappingContext* UInputAssetGenerator::GenerateMappingContext(
 
 	Package->FullyLoad();
 
-	// Create Mapping Context
-	UInputMappingContext* Context = NewObject<UInputMappingContext>(Package, *AssetName, RF_Public | RF_Standalone);
+	// Rebuild an existing Mapping Context in place so the change can be undone
+	UInputMappingContext* Context = FindObject<UInputMappingContext>(Package, *AssetName);
+	bOutIsNew = Context == nullptr;
+
+	if (Context)
+	{
+		Context->Modify();
+		Context->UnmapAll();
+	}
+	else
+	{
+		Context = NewObject<UInputMappingContext>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+	}
+
 	if (!Context)
 	{
 		return nullptr;
 	}
 
 	// Add mappings for each action
-	for (const FInputActionDefinition& ActionDef : Actions)
+	for (const FInputActionDefinition* ActionDefPtr : Actions)
 	{
-		UInputAction** FoundAction = GeneratedActions.Find(ActionDef.ActionName);
-		if (!FoundAction || !*FoundAction)
+		const FInputActionDefinition& ActionDef = *ActionDefPtr;
+		UInputAction* Action = ResolveInputAction(ActionDef.ActionName, Config);
+		if (!Action)
 		{
 			UE_LOG(LogInputStreamliner, Warning, TEXT("Could not find generated action: %s"), *ActionDef.ActionName.ToString());
 			continue;
@@ -178,29 +502,422 @@ UInputMappingContext* UInputAssetGenerator::GenerateMappingContext(
 		// Add each key binding
 		for (const FKeyBindingDefinition& Binding : PlatformBinding->Bindings)
 		{
-			AddMappingToContext(Context, *FoundAction, Binding, ActionDef);
+			AddMappingToContext(Context, Action, Binding, ActionDef);
 		}
 	}
 
-	// Save
 	Package->MarkPackageDirty();
-	FAssetRegistryModule::AssetCreated(Context);
 
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension());
+	UE_LOG(LogInputStreamliner, Verbose, TEXT("Prepared Mapping Context: %s"), *AssetName);
+	return Context;
+}
+
+UInputAssetManifest* UInputAssetGenerator::CreateRuntimeManifestObject(
+	const FInputStreamlinerConfiguration& Config,
+	const FInputGenerationManifest& Manifest,
+	bool& bOutIsNew)
+{
+	const FString AssetName = InputAssetGeneration::RuntimeManifestName;
+	const FString PackagePath = Config.MappingContextsPath / AssetName;
+
+	UPackage* Package = CreatePackage(*PackagePath);
+	if (!Package)
+	{
+		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to create package: %s"), *PackagePath);
+		return nullptr;
+	}
+
+	Package->FullyLoad();
+
+	// Rebuild an existing manifest in place so the change can be undone
+	UInputAssetManifest* RuntimeManifest = FindObject<UInputAssetManifest>(Package, *AssetName);
+	bOutIsNew = RuntimeManifest == nullptr;
+
+	if (RuntimeManifest)
+	{
+		RuntimeManifest->Modify();
+	}
+	else
+	{
+		RuntimeManifest = NewObject<UInputAssetManifest>(Package, *AssetName, RF_Public | RF_Standalone | RF_Transactional);
+	}
+
+	if (!RuntimeManifest)
+	{
+		return nullptr;
+	}
+
+	const TArray<ETargetPlatform> Platforms = {
+		ETargetPlatform::PC_Keyboard,
+		ETargetPlatform::PC_Gamepad,
+		ETargetPlatform::Mac,
+		ETargetPlatform::iOS,
+		ETargetPlatform::Android
+	};
+
+	// Only actions that made it into the generation manifest, ones that failed are left out
+	RuntimeManifest->Actions.Reset(Config.Actions.Num());
+	for (const FInputActionDefinition& ActionDef : Config.Actions)
+	{
+		const FGeneratedAssetRecord* Record = Manifest.Actions.Find(ActionDef.ActionName);
+		if (!Record)
+		{
+			continue;
+		}
 
+		FGeneratedInputActionEntry& Entry = RuntimeManifest->Actions.AddDefaulted_GetRef();
+		Entry.Action = TSoftObjectPtr<UInputAction>(FSoftObjectPath(Record->AssetPath));
+		Entry.DefaultKeys = GetDefaultKeys(ActionDef);
+		Entry.bAllowRebinding = ActionDef.bAllowRebinding;
+		for (ETargetPlatform Platform : Platforms)
+		{
+			if (ActionDef.TargetsPlatform(Platform))
+			{
+				Entry.Platforms.Add(FName(*GetPlatformName(Platform)));
+			}
+		}
+	}
+
+	RuntimeManifest->MappingContexts.Reset(Manifest.MappingContexts.Num());
+	for (ETargetPlatform Platform : Platforms)
+	{
+		const FString PlatformName = GetPlatformName(Platform);
+		if (const FGeneratedAssetRecord* Record = Manifest.MappingContexts.Find(PlatformName))
+		{
+			FGeneratedMappingContextEntry& Entry = RuntimeManifest->MappingContexts.AddDefaulted_GetRef();
+			Entry.Context = TSoftObjectPtr<UInputMappingContext>(FSoftObjectPath(Record->AssetPath));
+			Entry.Platform = FName(*PlatformName);
+		}
+	}
+
+	Package->MarkPackageDirty();
+
+	UE_LOG(LogInputStreamliner, Verbose, TEXT("Prepared runtime manifest with %d actions and %d mapping contexts"),
+		RuntimeManifest->Actions.Num(), RuntimeManifest->MappingContexts.Num());
+	return RuntimeManifest;
+}
+
+void UInputAssetGenerator::RegisterRuntimeManifest(const FString& ObjectPath)
+{
+	UInputStreamlinerRuntimeSettings* Settings = GetMutableDefault<UInputStreamlinerRuntimeSettings>();
+	const FSoftObjectPath ManifestPath(ObjectPath);
+	if (Settings->GeneratedAssetManifest.ToSoftObjectPath() == ManifestPath)
+	{
+		return;
+	}
+
+	Settings->GeneratedAssetManifest = TSoftObjectPtr<UInputAssetManifest>(ManifestPath);
+	if (!Settings->TryUpdateDefaultConfigFile())
+	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to write the generated asset manifest to DefaultGame.ini; set it in Project Settings > Plugins > Input Streamliner"));
+	}
+}
+
+UInputAction* UInputAssetGenerator::ResolveInputAction(FName ActionName, const FInputStreamlinerConfiguration& Config)
+{
+	if (UInputAction** Found = GeneratedActions.Find(ActionName))
+	{
+		return *Found;
+	}
+
+	// Fall back to an asset generated by an earlier run
+	const FString ObjectPath = GetInputActionObjectPath(ActionName, Config.InputActionsPath);
+
+	UInputAction* Action = LoadObject<UInputAction>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+	if (Action)
+	{
+		GeneratedActions.Add(ActionName, Action);
+	}
+	return Action;
+}
+
+int32 UInputAssetGenerator::SaveAssets(const TArray<UObject*>& Assets, FScopedSlowTask* SlowTask, bool* bOutCancelled)
+{
+	int32 NumSaved = 0;
+	if (bOutCancelled)
+	{
+		*bOutCancelled = false;
+	}
+
+	// Serialize on the game thread and let the engine write the files in the background
 	FSavePackageArgs SaveArgs;
 	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	UPackage::SavePackage(Package, Context, *PackageFileName, SaveArgs);
+	SaveArgs.SaveFlags = SAVE_Async;
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Generated Mapping Context: %s"), *AssetName);
-	return Context;
+	for (UObject* Asset : Assets)
+	{
+		if (SlowTask)
+		{
+			if (SlowTask->ShouldCancel())
+			{
+				UE_LOG(LogInputStreamliner, Warning, TEXT("Saving cancelled after %d of %d packages"), NumSaved, Assets.Num());
+				if (bOutCancelled)
+				{
+					*bOutCancelled = true;
+				}
+				break;
+			}
+			SlowTask->EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("Saving %s"), *Asset->GetName())));
+		}
+
+		UPackage* Package = Asset->GetPackage();
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+		if (UPackage::SavePackage(Package, Asset, *PackageFileName, SaveArgs))
+		{
+			NumSaved++;
+		}
+		else
+		{
+			UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to save package: %s"), *PackageFileName);
+		}
+	}
+
+	UPackage::WaitForAsyncFileWrites();
+	return NumSaved;
 }
 
-int32 UInputAssetGenerator::CleanupGeneratedAssets(const FInputStreamlinerConfiguration& Config)
+int32 UInputAssetGenerator::CleanupGeneratedAssets()
 {
-	// TODO: Implement asset cleanup
-	UE_LOG(LogInputStreamliner, Log, TEXT("Asset cleanup not yet implemented"));
-	return 0;
+	FInputGenerationManifest Manifest;
+	Manifest.LoadFromDisk();
+
+	// Only what earlier runs recorded; paths the configuration could produce but never did are left alone
+	const TArray<FString> AssetPaths = Manifest.GetAllAssetPaths();
+	if (AssetPaths.Num() == 0)
+	{
+		UE_LOG(LogInputStreamliner, Log, TEXT("No generated assets recorded in the manifest; nothing to clean up"));
+		return 0;
+	}
+
+	// Release our references so they do not block the delete
+	GeneratedActions.Empty();
+
+	const float TotalWork = static_cast<float>(FMath::DivideAndRoundUp(AssetPaths.Num(), InputAssetCleanup::DeleteBatchSize));
+	FScopedSlowTask SlowTask(TotalWork, NSLOCTEXT("InputStreamliner", "DeletingAssets", "Deleting generated input assets..."));
+	SlowTask.MakeDialog(true);
+
+	TSet<FString> DeletedPaths;
+	const int32 NumDeleted = DeleteAssets(AssetPaths, &SlowTask, &DeletedPaths);
+
+	// Keep records of anything that was not deleted (cancelled, or still in use) for the next cleanup
+	for (auto It = Manifest.Actions.CreateIterator(); It; ++It)
+	{
+		if (DeletedPaths.Contains(It.Value().AssetPath))
+		{
+			It.RemoveCurrent();
+		}
+	}
+	for (auto It = Manifest.MappingContexts.CreateIterator(); It; ++It)
+	{
+		if (DeletedPaths.Contains(It.Value().AssetPath))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (DeletedPaths.Contains(Manifest.RuntimeManifest.AssetPath))
+	{
+		Manifest.RuntimeManifest = FGeneratedAssetRecord();
+	}
+
+	if (Manifest.Actions.Num() == 0 && Manifest.MappingContexts.Num() == 0 && Manifest.RuntimeManifest.AssetPath.IsEmpty())
+	{
+		FInputGenerationManifest::DeleteFromDisk();
+	}
+	else
+	{
+		Manifest.SaveToDisk();
+	}
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Cleaned up %d of %d generated assets"), NumDeleted, AssetPaths.Num());
+	return NumDeleted;
+}
+
+int32 UInputAssetGenerator::DeleteAssets(const TArray<FString>& ObjectPaths, FScopedSlowTask* SlowTask, TSet<FString>* OutDeletedPaths)
+{
+	if (ObjectPaths.Num() == 0)
+	{
+		return 0;
+	}
+
+	// One registry query for every package, answered from the registry without loading anything
+	FARFilter Filter;
+	TMap<FName, FSoftObjectPath> ObjectPathByPackage;
+	for (const FString& ObjectPath : ObjectPaths)
+	{
+		const FSoftObjectPath SoftPath(ObjectPath);
+		const FName PackageName = SoftPath.GetLongPackageFName();
+		Filter.PackageNames.Add(PackageName);
+		ObjectPathByPackage.Add(PackageName, SoftPath);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> FoundAssets;
+	AssetRegistry.GetAssets(Filter, FoundAssets);
+
+	// Only assets that are still the recorded one
+	TArray<FAssetData> RecordedAssets;
+	for (const FAssetData& AssetData : FoundAssets)
+	{
+		const FSoftObjectPath* ObjectPath = ObjectPathByPackage.Find(AssetData.PackageName);
+		if (ObjectPath && AssetData.GetSoftObjectPath() == *ObjectPath)
+		{
+			RecordedAssets.Add(AssetData);
+		}
+	}
+
+	// References between the assets being deleted don't keep them alive
+	TSet<FName> DeletingPackages;
+	for (const FAssetData& AssetData : RecordedAssets)
+	{
+		DeletingPackages.Add(AssetData.PackageName);
+	}
+
+	int32 NumDeleted = 0;
+	for (int32 BatchStart = 0; BatchStart < RecordedAssets.Num(); BatchStart += InputAssetCleanup::DeleteBatchSize)
+	{
+		if (SlowTask)
+		{
+			if (SlowTask->ShouldCancel())
+			{
+				UE_LOG(LogInputStreamliner, Warning, TEXT("Deletion cancelled after %d of %d assets"), NumDeleted, RecordedAssets.Num());
+				break;
+			}
+			SlowTask->EnterProgressFrame(1.0f, FText::FromString(FString::Printf(TEXT("Deleting %d of %d"), BatchStart + 1, RecordedAssets.Num())));
+		}
+
+		const int32 BatchEnd = FMath::Min(BatchStart + InputAssetCleanup::DeleteBatchSize, RecordedAssets.Num());
+
+		// Assets already in memory go through the editor's delete path; nothing is loaded just to delete it
+		TArray<UObject*> ObjectsToDelete;
+		TArray<FName> UnloadedPackages;
+		for (int32 i = BatchStart; i < BatchEnd; i++)
+		{
+			if (UObject* Asset = RecordedAssets[i].FastGetAsset(false))
+			{
+				ObjectsToDelete.Add(Asset);
+			}
+			else
+			{
+				UnloadedPackages.Add(RecordedAssets[i].PackageName);
+			}
+		}
+
+		if (ObjectsToDelete.Num() > 0)
+		{
+			// Goes through reference checks, source control and the asset registry like a Content Browser delete
+			ObjectTools::DeleteObjects(ObjectsToDelete, false);
+		}
+
+		if (UnloadedPackages.Num() > 0)
+		{
+			DeleteUnloadedPackages(UnloadedPackages, DeletingPackages);
+		}
+
+		for (int32 i = BatchStart; i < BatchEnd; i++)
+		{
+			const FSoftObjectPath ObjectPath = RecordedAssets[i].GetSoftObjectPath();
+			if (AssetRegistry.GetAssetByObjectPath(ObjectPath).IsValid())
+			{
+				UE_LOG(LogInputStreamliner, Warning, TEXT("%s was not deleted; it may still be referenced"), *ObjectPath.ToString());
+				continue;
+			}
+
+			NumDeleted++;
+			if (OutDeletedPaths)
+			{
+				OutDeletedPaths->Add(ObjectPath.ToString());
+			}
+		}
+	}
+
+	return NumDeleted;
+}
+
+void UInputAssetGenerator::DeleteUnloadedPackages(const TArray<FName>& PackageNames, const TSet<FName>& DeletingPackages)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const bool bUseSourceControl = ISourceControlModule::Get().IsEnabled();
+
+	TArray<FString> DeletedFilenames;
+	for (const FName PackageName : PackageNames)
+	{
+		// ObjectTools checks references on loaded objects; do the same from the registry for packages on disk
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(PackageName, Referencers);
+		const FName* ExternalReferencer = Referencers.FindByPredicate([&DeletingPackages](FName Referencer) { return !DeletingPackages.Contains(Referencer); });
+		if (ExternalReferencer)
+		{
+			UE_LOG(LogInputStreamliner, Warning, TEXT("%s was not deleted; it is referenced by %s"), *PackageName.ToString(), *ExternalReferencer->ToString());
+			continue;
+		}
+
+		FString Filename;
+		if (!FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), Filename, FPackageName::GetAssetPackageExtension()))
+		{
+			continue;
+		}
+		Filename = FPaths::ConvertRelativePathToFull(Filename);
+
+		// Marked for delete when source control is on, so the deletion is submitted with the change
+		const bool bDeleted = bUseSourceControl
+			? USourceControlHelpers::MarkFileForDelete(Filename, true)
+			: IFileManager::Get().Delete(*Filename, false, true, true);
+
+		if (bDeleted)
+		{
+			DeletedFilenames.Add(Filename);
+		}
+		else
+		{
+			UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to delete %s"), *Filename);
+		}
+	}
+
+	// Rescanning files that no longer exist removes their assets from the registry
+	if (DeletedFilenames.Num() > 0)
+	{
+		AssetRegistry.ScanModifiedAssetFiles(DeletedFilenames);
+	}
+}
+
+FString UInputAssetGenerator::GetInputActionObjectPath(FName ActionName, const FString& Path)
+{
+	const FString AssetName = FString::Printf(TEXT("IA_%s"), *ActionName.ToString());
+	return FString::Printf(TEXT("%s/%s.%s"), *Path, *AssetName, *AssetName);
+}
+
+FString UInputAssetGenerator::GetMappingContextObjectPath(ETargetPlatform Platform, const FString& Path)
+{
+	const FString AssetName = FString::Printf(TEXT("IMC_%s"), *GetPlatformName(Platform));
+	return FString::Printf(TEXT("%s/%s.%s"), *Path, *AssetName, *AssetName);
+}
+
+FString UInputAssetGenerator::GetRuntimeManifestObjectPath(const FString& Path)
+{
+	return FString::Printf(TEXT("%s/%s.%s"), *Path, InputAssetGeneration::RuntimeManifestName, InputAssetGeneration::RuntimeManifestName);
+}
+
+TArray<FKey> UInputAssetGenerator::GetDefaultKeys(const FInputActionDefinition& Definition)
+{
+	TArray<FKey> Keys;
+	for (ETargetPlatform Platform : InputAssetGeneration::DefaultKeyPlatforms)
+	{
+		if (const FPlatformBindingConfig* PlatformConfig = Definition.PlatformBindings.Find(Platform))
+		{
+			for (const FKeyBindingDefinition& Binding : PlatformConfig->Bindings)
+			{
+				// Resolve aliases the same way AddMappingToContext does, so the defaults match the mapped keys
+				const FKey Key = FInputKeyTraitsTable::ResolveKey(Binding.Key);
+				if (Key.IsValid())
+				{
+					Keys.AddUnique(Key);
+				}
+			}
+		}
+	}
+	return Keys;
 }
 
 bool UInputAssetGenerator::DoesAssetExist(const FString& AssetPath) const
@@ -236,12 +953,16 @@ void UInputAssetGenerator::AddMappingToContext(
 	const FKeyBindingDefinition& Binding,
 	const FInputActionDefinition& ActionDef)
 {
-	if (!Binding.Key.IsValid())
+	const FKey Key = FInputKeyTraitsTable::ResolveKey(Binding.Key);
+	if (!Key.IsValid())
 	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Skipping unknown key '%s' for action %s"), *Binding.Key.GetFName().ToString(), *ActionDef.ActionName.ToString());
 		return;
 	}
 
-	FEnhancedActionKeyMapping& Mapping = Context->MapKey(Action, Binding.Key);
+	const FInputKeyTraits& Traits = FInputKeyTraitsTable::Get(Key);
+
+	FEnhancedActionKeyMapping& Mapping = Context->MapKey(Action, Key);
 
 	// Add trigger based on binding type
 	switch (Binding.TriggerType)
@@ -284,27 +1005,13 @@ void UInputAssetGenerator::AddMappingToContext(
 		break;
 	}
 
-	// Check if this is a gamepad stick - add DeadZone
-	FString KeyName = Binding.Key.GetFName().ToString();
-	bool bIsGamepadStick = KeyName.Contains(TEXT("Gamepad_Left")) || KeyName.Contains(TEXT("Gamepad_Right"));
-	bool bIsStickAxis = KeyName.Contains(TEXT("Stick")) || KeyName.Contains(TEXT("_X")) || KeyName.Contains(TEXT("_Y"));
-
-	if (bIsGamepadStick || (bIsGamepadStick && bIsStickAxis))
-	{
-		UInputModifierDeadZone* DeadZone = NewObject<UInputModifierDeadZone>(Context);
-		DeadZone->LowerThreshold = 0.2f;
-		DeadZone->UpperThreshold = 1.0f;
-		DeadZone->Type = EDeadZoneType::Radial;
-		Mapping.Modifiers.Add(DeadZone);
-	}
-
-	// Check if this is a gamepad trigger - add DeadZone with different settings
-	if (KeyName.Contains(TEXT("Trigger")))
+	// Analog sticks and triggers get a dead zone suited to the key
+	if (Traits.bNeedsDeadZone)
 	{
 		UInputModifierDeadZone* DeadZone = NewObject<UInputModifierDeadZone>(Context);
-		DeadZone->LowerThreshold = 0.1f;
+		DeadZone->LowerThreshold = Traits.DeadZoneLowerThreshold;
 		DeadZone->UpperThreshold = 1.0f;
-		DeadZone->Type = EDeadZoneType::Axial;
+		DeadZone->Type = Traits.DeadZoneType;
 		Mapping.Modifiers.Add(DeadZone);
 	}
 
@@ -320,39 +1027,39 @@ void UInputAssetGenerator::AddMappingToContext(
 		}
 	}
 
-	// Add axis modifiers if this is an axis mapping
-	if (!Binding.AxisMapping.IsEmpty() && ActionDef.ActionType == EInputActionType::Axis2D)
+	// Digital keys driving one component of an axis action
+	const EInputAxisDirection Direction = Binding.GetAxisDirection();
+	if (Direction == EInputAxisDirection::None || Traits.IsAnalog())
+	{
+		return;
+	}
+
+	const bool bNegative = Direction == EInputAxisDirection::NegativeX
+		|| Direction == EInputAxisDirection::NegativeY
+		|| Direction == EInputAxisDirection::NegativeZ;
+
+	if (ActionDef.ActionType == EInputActionType::Axis2D || ActionDef.ActionType == EInputActionType::Axis3D)
 	{
-		if (Binding.AxisMapping.Contains(TEXT("X")))
+		// Keys report on X; move the value to the requested component
+		if (Direction == EInputAxisDirection::PositiveY || Direction == EInputAxisDirection::NegativeY)
 		{
-			if (Binding.AxisMapping.Contains(TEXT("-")))
-			{
-				UInputModifierNegate* Negate = NewObject<UInputModifierNegate>(Context);
-				Mapping.Modifiers.Add(Negate);
-			}
+			UInputModifierSwizzleAxis* Swizzle = NewObject<UInputModifierSwizzleAxis>(Context);
+			Swizzle->Order = EInputAxisSwizzle::YXZ;
+			Mapping.Modifiers.Add(Swizzle);
 		}
-		else if (Binding.AxisMapping.Contains(TEXT("Y")))
+		else if (Direction == EInputAxisDirection::PositiveZ || Direction == EInputAxisDirection::NegativeZ)
 		{
 			UInputModifierSwizzleAxis* Swizzle = NewObject<UInputModifierSwizzleAxis>(Context);
-			Swizzle->Order = EInputAxisSwizzle::YXZ;
+			Swizzle->Order = EInputAxisSwizzle::ZYX;
 			Mapping.Modifiers.Add(Swizzle);
-
-			if (Binding.AxisMapping.Contains(TEXT("-")))
-			{
-				UInputModifierNegate* Negate = NewObject<UInputModifierNegate>(Context);
-				Mapping.Modifiers.Add(Negate);
-			}
 		}
 	}
 
-	// For Axis1D actions with keyboard keys, add scalar to convert bool to axis
-	if (ActionDef.ActionType == EInputActionType::Axis1D && !bIsGamepadStick)
+	// For Axis1D actions with keyboard keys the direction is just the sign
+	if (bNegative && ActionDef.ActionType != EInputActionType::Bool)
 	{
-		if (Binding.AxisMapping.Contains(TEXT("-")))
-		{
-			UInputModifierNegate* Negate = NewObject<UInputModifierNegate>(Context);
-			Mapping.Modifiers.Add(Negate);
-		}
+		UInputModifierNegate* Negate = NewObject<UInputModifierNegate>(Context);
+		Mapping.Modifiers.Add(Negate);
 	}
 }
 
@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputCodeGenerator.h"
+#include "InputStreamlinerConfiguration.h"
+#include "InputAssetGenerator.h"
+#include "InputStreamlinerModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace InputCodeGenerator
+{
+	FString Quote(const FString& Value)
+	{
+		return FString::Printf(TEXT("TEXT(\"%s\")"), *Value.ReplaceCharWithEscapedChar());
+	}
+
+	/**
+	 * C++ keywords, alternative operator tokens and macros every engine translation unit defines.
+	 * Stored lowercase and compared case-insensitively: FName keeps the casing it was first created with,
+	 * so an action named Delete can come back as delete.
+	 */
+	const TSet<FString>& GetReservedWords()
+	{
+		static const TSet<FString> ReservedWords = {
+			TEXT("alignas"), TEXT("alignof"), TEXT("and"), TEXT("and_eq"), TEXT("asm"), TEXT("auto"), TEXT("bitand"), TEXT("bitor"),
+			TEXT("bool"), TEXT("break"), TEXT("case"), TEXT("catch"), TEXT("char"), TEXT("char8_t"), TEXT("char16_t"), TEXT("char32_t"),
+			TEXT("class"), TEXT("compl"), TEXT("concept"), TEXT("const"), TEXT("consteval"), TEXT("constexpr"), TEXT("constinit"),
+			TEXT("const_cast"), TEXT("continue"), TEXT("co_await"), TEXT("co_return"), TEXT("co_yield"), TEXT("decltype"), TEXT("default"),
+			TEXT("delete"), TEXT("do"), TEXT("double"), TEXT("dynamic_cast"), TEXT("else"), TEXT("enum"), TEXT("explicit"), TEXT("export"),
+			TEXT("extern"), TEXT("false"), TEXT("float"), TEXT("for"), TEXT("friend"), TEXT("goto"), TEXT("if"), TEXT("inline"), TEXT("int"),
+			TEXT("long"), TEXT("mutable"), TEXT("namespace"), TEXT("new"), TEXT("noexcept"), TEXT("not"), TEXT("not_eq"), TEXT("nullptr"),
+			TEXT("operator"), TEXT("or"), TEXT("or_eq"), TEXT("private"), TEXT("protected"), TEXT("public"), TEXT("register"),
+			TEXT("reinterpret_cast"), TEXT("requires"), TEXT("return"), TEXT("short"), TEXT("signed"), TEXT("sizeof"), TEXT("static"),
+			TEXT("static_assert"), TEXT("static_cast"), TEXT("struct"), TEXT("switch"), TEXT("template"), TEXT("this"), TEXT("thread_local"),
+			TEXT("throw"), TEXT("true"), TEXT("try"), TEXT("typedef"), TEXT("typeid"), TEXT("typename"), TEXT("union"), TEXT("unsigned"),
+			TEXT("using"), TEXT("virtual"), TEXT("void"), TEXT("volatile"), TEXT("wchar_t"), TEXT("while"), TEXT("xor"), TEXT("xor_eq"),
+			TEXT("null"), TEXT("check"), TEXT("verify"), TEXT("ensure"), TEXT("text"), TEXT("pi"),
+		};
+		return ReservedWords;
+	}
+}
+
+FString FInputCodeGenerator::GetActionTableHeaderPath(const FInputStreamlinerConfiguration& Config)
+{
+	const FString FileName = FString::Printf(TEXT("%sInputActions.h"), *MakeIdentifier(Config.ProjectPrefix));
+	return FPaths::ConvertRelativePathToFull(FPaths::GameSourceDir() / Config.GeneratedCodePath / FileName);
+}
+
+FString FInputCodeGenerator::BuildActionTableHeader(const FInputStreamlinerConfiguration& Config, const TArray<FString>& MappingContextPaths)
+{
+	using namespace InputCodeGenerator;
+
+	const FString Namespace = MakeIdentifier(Config.ProjectPrefix + TEXT("Input"));
+
+	// Identifiers in configuration order; the enum value is the index into every array.
+	// Names that collide once sanitized (or with Count) get a numeric suffix.
+	TArray<FString> Identifiers;
+	Identifiers.Reserve(Config.Actions.Num());
+	TSet<FString> UsedIdentifiers = { TEXT("Count") };
+	for (const FInputActionDefinition& Action : Config.Actions)
+	{
+		const FString BaseIdentifier = MakeIdentifier(Action.ActionName.ToString());
+		FString Identifier = BaseIdentifier;
+		for (int32 Suffix = 2; UsedIdentifiers.Contains(Identifier); Suffix++)
+		{
+			// Don't form a double underscore with a base that already ends in one
+			Identifier = FString::Printf(BaseIdentifier.EndsWith(TEXT("_")) ? TEXT("%s%d") : TEXT("%s_%d"), *BaseIdentifier, Suffix);
+		}
+		UsedIdentifiers.Add(Identifier);
+		Identifiers.Add(MoveTemp(Identifier));
+	}
+
+	TStringBuilder<8192> Out;
+	Out << TEXT("// Generated by Input Streamliner. Do not edit; regenerate from the Input Streamliner panel.\n\n");
+	Out << TEXT("#pragma once\n\n");
+	Out << TEXT("#include \"CoreMinimal.h\"\n");
+	Out << TEXT("#include \"InputActionTable.h\"\n\n");
+	Out << TEXT("namespace ") << Namespace << TEXT("\n{\n");
+
+	Out << TEXT("\t/** Generated input actions, in configuration order */\n");
+	Out << TEXT("\tenum class EAction : int32\n\t{\n");
+	for (int32 i = 0; i < Identifiers.Num(); i++)
+	{
+		Out << TEXT("\t\t") << Identifiers[i] << TEXT(" = ") << i << TEXT(",\n");
+	}
+	Out << TEXT("\t\tCount = ") << Identifiers.Num() << TEXT("\n\t};\n\n");
+
+	Out << TEXT("\tnamespace Private\n\t{\n");
+
+	// Default keys, one array per action that has any
+	TArray<bool> HasDefaultKeys;
+	HasDefaultKeys.Init(false, Config.Actions.Num());
+	for (int32 i = 0; i < Config.Actions.Num(); i++)
+	{
+		const TArray<FKey> Keys = UInputAssetGenerator::GetDefaultKeys(Config.Actions[i]);
+		if (Keys.Num() == 0)
+		{
+			continue;
+		}
+
+		HasDefaultKeys[i] = true;
+		Out << TEXT("\t\tinline constexpr const TCHAR* ") << Identifiers[i] << TEXT("Keys[] = { ");
+		for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); KeyIndex++)
+		{
+			Out << (KeyIndex > 0 ? TEXT(", ") : TEXT("")) << Quote(Keys[KeyIndex].GetFName().ToString());
+		}
+		Out << TEXT(" };\n");
+	}
+	Out << TEXT("\n");
+
+	if (Config.Actions.Num() > 0)
+	{
+		Out << TEXT("\t\tinline constexpr FInputActionTableEntry Actions[] =\n\t\t{\n");
+		for (int32 i = 0; i < Config.Actions.Num(); i++)
+		{
+			const FInputActionDefinition& Action = Config.Actions[i];
+			const FString ObjectPath = UInputAssetGenerator::GetInputActionObjectPath(Action.ActionName, Config.InputActionsPath);
+			Out << TEXT("\t\t\t{ ") << Quote(Action.ActionName.ToString()) << TEXT(", ") << Quote(ObjectPath) << TEXT(", ");
+			if (HasDefaultKeys[i])
+			{
+				Out << Identifiers[i] << TEXT("Keys, UE_ARRAY_COUNT(") << Identifiers[i] << TEXT("Keys)");
+			}
+			else
+			{
+				Out << TEXT("nullptr, 0");
+			}
+			Out << TEXT(" },\n");
+		}
+		Out << TEXT("\t\t};\n\n");
+	}
+
+	if (MappingContextPaths.Num() > 0)
+	{
+		Out << TEXT("\t\tinline constexpr const TCHAR* MappingContexts[] =\n\t\t{\n");
+		for (const FString& Path : MappingContextPaths)
+		{
+			Out << TEXT("\t\t\t") << Quote(Path) << TEXT(",\n");
+		}
+		Out << TEXT("\t\t};\n");
+	}
+	Out << TEXT("\t}\n\n");
+
+	Out << TEXT("\t/** The generated actions and mapping contexts */\n");
+	Out << TEXT("\tinline const FInputActionTable& GetActionTable()\n\t{\n");
+	Out << TEXT("\t\tstatic const FInputActionTable Table(");
+	Out << (Config.Actions.Num() > 0 ? TEXT("Private::Actions") : TEXT("TConstArrayView<FInputActionTableEntry>()"));
+	Out << TEXT(", ");
+	Out << (MappingContextPaths.Num() > 0 ? TEXT("Private::MappingContexts") : TEXT("TConstArrayView<const TCHAR*>()"));
+	Out << TEXT(");\n\t\treturn Table;\n\t}\n");
+	Out << TEXT("}\n");
+
+	return FString(Out.ToView());
+}
+
+bool FInputCodeGenerator::WriteActionTableHeader(const FInputStreamlinerConfiguration& Config, const TArray<FString>& MappingContextPaths)
+{
+	const FString HeaderPath = GetActionTableHeaderPath(Config);
+	const FString Source = BuildActionTableHeader(Config, MappingContextPaths);
+
+	FString Existing;
+	if (FFileHelper::LoadFileToString(Existing, *HeaderPath) && Existing.Equals(Source, ESearchCase::CaseSensitive))
+	{
+		UE_LOG(LogInputStreamliner, Log, TEXT("Action table unchanged: %s"), *HeaderPath);
+		return true;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Source, *HeaderPath))
+	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to write action table: %s"), *HeaderPath);
+		return false;
+	}
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Wrote action table with %d actions: %s"), Config.Actions.Num(), *HeaderPath);
+	return true;
+}
+
+FString FInputCodeGenerator::MakeIdentifier(const FString& Name)
+{
+	using namespace InputCodeGenerator;
+
+	FString Result;
+	Result.Reserve(Name.Len() + 1);
+	for (TCHAR Char : Name)
+	{
+		const bool bValid = Char < 128 && (FChar::IsAlnum(Char) || Char == TEXT('_'));
+		const TCHAR OutChar = bValid ? Char : TEXT('_');
+
+		// Names containing a double underscore are reserved
+		if (OutChar == TEXT('_') && Result.EndsWith(TEXT("_")))
+		{
+			continue;
+		}
+		Result.AppendChar(OutChar);
+	}
+
+	// So are names starting with an underscore and an uppercase letter
+	if (Result.Len() > 1 && Result[0] == TEXT('_') && FChar::IsUpper(Result[1]))
+	{
+		Result.RemoveAt(0);
+	}
+
+	if (Result.IsEmpty() || FChar::IsDigit(Result[0]))
+	{
+		Result.InsertAt(0, TEXT('_'));
+	}
+	else if (GetReservedWords().Contains(Result.ToLower()))
+	{
+		Result.AppendChar(TEXT('_'));
+	}
+	return Result;
+}
@@ -0,0 +1,521 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputConfigurationDecoder.h"
+#include "InputStreamlinerConfiguration.h"
+#include "InputConfigurationPatch.h"
+#include "InputKeyTraits.h"
+#include "InputStreamlinerModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+static TAutoConsoleVariable<bool> CVarFastConfigDecode(
+	TEXT("InputStreamliner.FastConfigDecode"),
+	true,
+	TEXT("Decode configuration files with the table-driven parallel decoder instead of FJsonObjectConverter."));
+
+static TAutoConsoleVariable<bool> CVarParallelConfigDecode(
+	TEXT("InputStreamliner.ParallelConfigDecode"),
+	true,
+	TEXT("Decode configuration actions on worker threads."));
+
+namespace InputConfigurationDecoderTables
+{
+	/** Actions per ParallelFor batch; small configurations stay on the calling thread */
+	constexpr int32 MinActionsPerBatch = 32;
+
+	/** Name to value table for a UENUM, built once from its reflection data */
+	template <typename TEnum>
+	class TEnumNameTable
+	{
+	public:
+		TEnumNameTable()
+		{
+			const UEnum* Enum = StaticEnum<TEnum>();
+			const int32 NumNames = Enum->ContainsExistingMax() ? Enum->NumEnums() - 1 : Enum->NumEnums();
+
+			ValuesByName.Reserve(NumNames);
+			for (int32 Index = 0; Index < NumNames; ++Index)
+			{
+				// FString keys hash and compare case-insensitively
+				ValuesByName.Add(Enum->GetNameStringByIndex(Index), static_cast<TEnum>(Enum->GetValueByIndex(Index)));
+			}
+		}
+
+		bool Find(const FString& Name, TEnum& OutValue) const
+		{
+			int32 SeparatorIndex = INDEX_NONE;
+			const TEnum* Found = Name.FindLastChar(TEXT(':'), SeparatorIndex)
+				? ValuesByName.Find(Name.RightChop(SeparatorIndex + 1))
+				: ValuesByName.Find(Name);
+
+			if (!Found)
+			{
+				return false;
+			}
+
+			OutValue = *Found;
+			return true;
+		}
+
+	private:
+		TMap<FString, TEnum> ValuesByName;
+	};
+
+	template <typename TEnum>
+	const TEnumNameTable<TEnum>& Get()
+	{
+		static const TEnumNameTable<TEnum> Table;
+		return Table;
+	}
+
+	/** Build every table before decoding fans out to worker threads */
+	void WarmUp()
+	{
+		Get<EInputActionType>();
+		Get<ETargetPlatform>();
+		Get<EInputTriggerType>();
+		Get<EInputAxisDirection>();
+	}
+
+	/** Read a key exported either as text ("W") or as a struct ({"keyName": "W"}) */
+	FKey ReadKey(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			return EKeys::Invalid;
+		}
+
+		FString KeyName;
+		const TSharedPtr<FJsonObject>* KeyObj;
+		if (Value->TryGetString(KeyName) || (Value->TryGetObject(KeyObj) && (*KeyObj)->TryGetStringField(TEXT("keyName"), KeyName)))
+		{
+			return FInputKeyTraitsTable::ResolveKeyName(KeyName);
+		}
+
+		return EKeys::Invalid;
+	}
+}
+
+bool FInputConfigurationDecoder::FindActionType(const FString& Name, EInputActionType& OutType)
+{
+	return InputConfigurationDecoderTables::Get<EInputActionType>().Find(Name, OutType);
+}
+
+bool FInputConfigurationDecoder::FindPlatform(const FString& Name, ETargetPlatform& OutPlatform)
+{
+	ETargetPlatform Platform;
+	if (!InputConfigurationDecoderTables::Get<ETargetPlatform>().Find(Name, Platform)
+		|| Platform == ETargetPlatform::None || Platform == ETargetPlatform::All)
+	{
+		// Bindings are always keyed by a single platform
+		return false;
+	}
+
+	OutPlatform = Platform;
+	return true;
+}
+
+bool FInputConfigurationDecoder::FindTriggerType(const FString& Name, EInputTriggerType& OutTrigger)
+{
+	return InputConfigurationDecoderTables::Get<EInputTriggerType>().Find(Name, OutTrigger);
+}
+
+bool FInputConfigurationDecoder::FindAxisDirection(const FString& Name, EInputAxisDirection& OutDirection)
+{
+	return InputConfigurationDecoderTables::Get<EInputAxisDirection>().Find(Name, OutDirection);
+}
+
+bool FInputConfigurationDecoder::DecodeConfiguration(const FString& JsonString, FInputStreamlinerConfiguration& OutConfig, FString& OutError)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (!CVarFastConfigDecode.GetValueOnGameThread())
+	{
+		if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &OutConfig))
+		{
+			OutError = TEXT("Failed to parse configuration JSON");
+			return false;
+		}
+
+		UE_LOG(LogInputStreamliner, Log, TEXT("Decoded %d actions via reflection in %.2f ms"),
+			OutConfig.Actions.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		OutError = TEXT("Failed to parse configuration JSON");
+		return false;
+	}
+
+	const double ParsedTime = FPlatformTime::Seconds();
+
+	// Detach the actions so reflection only handles the small remaining fields
+	const TSharedPtr<FJsonValue> ActionsValue = JsonObject->TryGetField(TEXT("actions"));
+	JsonObject->RemoveField(TEXT("actions"));
+
+	if (!FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), &OutConfig))
+	{
+		OutError = TEXT("Failed to decode configuration settings");
+		return false;
+	}
+
+	const double SettingsTime = FPlatformTime::Seconds();
+
+	const TArray<TSharedPtr<FJsonValue>>* ActionValues;
+	if (ActionsValue.IsValid() && ActionsValue->TryGetArray(ActionValues))
+	{
+		DecodeActions(*ActionValues, true, OutConfig.Actions);
+	}
+
+	const double EndTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Decoded %d actions in %.2f ms (parse %.2f ms, settings %.2f ms, actions %.2f ms)"),
+		OutConfig.Actions.Num(),
+		(EndTime - StartTime) * 1000.0,
+		(ParsedTime - StartTime) * 1000.0,
+		(SettingsTime - ParsedTime) * 1000.0,
+		(EndTime - SettingsTime) * 1000.0);
+
+	return true;
+}
+
+void FInputConfigurationDecoder::DecodeLLMConfiguration(const TSharedPtr<FJsonObject>& JsonObject, FInputStreamlinerConfiguration& OutConfig)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Clear previous config
+	OutConfig = FInputStreamlinerConfiguration();
+
+	const TArray<TSharedPtr<FJsonValue>>* ActionsArray;
+	if (JsonObject->TryGetArrayField(TEXT("actions"), ActionsArray))
+	{
+		DecodeActions(*ActionsArray, false, OutConfig.Actions);
+	}
+
+	// Parse gyro config if present
+	const TSharedPtr<FJsonObject>* GyroObj;
+	if (JsonObject->TryGetObjectField(TEXT("gyro"), GyroObj))
+	{
+		FString LinkedAction;
+		FString ActivationAction;
+		(*GyroObj)->TryGetBoolField(TEXT("enabled"), OutConfig.GyroConfig.bEnabled);
+		(*GyroObj)->TryGetStringField(TEXT("linkedAction"), LinkedAction);
+		(*GyroObj)->TryGetStringField(TEXT("activationAction"), ActivationAction);
+		OutConfig.GyroConfig.LinkedActionName = FName(*LinkedAction);
+		OutConfig.GyroConfig.ActivationAction = FName(*ActivationAction);
+	}
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Decoded %d LLM actions in %.2f ms"),
+		OutConfig.Actions.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FInputConfigurationDecoder::DecodeLLMPatch(const TSharedPtr<FJsonObject>& JsonObject, const FInputStreamlinerConfiguration& BaseConfig, FInputConfigurationPatch& OutPatch)
+{
+	OutPatch = FInputConfigurationPatch();
+
+	const TArray<TSharedPtr<FJsonValue>>* OperationValues;
+	if (!JsonObject.IsValid() || !JsonObject->TryGetArrayField(TEXT("operations"), OperationValues))
+	{
+		return;
+	}
+
+	for (const TSharedPtr<FJsonValue>& OperationValue : *OperationValues)
+	{
+		const TSharedPtr<FJsonObject>* OperationObj;
+		if (!OperationValue.IsValid() || !OperationValue->TryGetObject(OperationObj))
+		{
+			continue;
+		}
+
+		FString OpName, ActionName;
+		(*OperationObj)->TryGetStringField(TEXT("op"), OpName);
+		(*OperationObj)->TryGetStringField(TEXT("name"), ActionName);
+
+		const TSharedPtr<FJsonObject>* ActionObj = nullptr;
+		(*OperationObj)->TryGetObjectField(TEXT("action"), ActionObj);
+
+		// The action may leave out its name when the operation already gives it
+		if (ActionObj && ActionName.IsEmpty())
+		{
+			(*ActionObj)->TryGetStringField(TEXT("name"), ActionName);
+		}
+		if (ActionName.IsEmpty())
+		{
+			continue;
+		}
+		if (ActionObj && !(*ActionObj)->HasField(TEXT("name")))
+		{
+			(*ActionObj)->SetStringField(TEXT("name"), ActionName);
+		}
+
+		FInputPatchOperation Operation;
+		Operation.ActionName = FName(*ActionName);
+
+		if (OpName.Equals(TEXT("remove"), ESearchCase::IgnoreCase))
+		{
+			Operation.Operation = EInputPatchOperationType::Remove;
+		}
+		else if (OpName.Equals(TEXT("update"), ESearchCase::IgnoreCase))
+		{
+			if (!BaseConfig.HasAction(Operation.ActionName) || !ActionObj)
+			{
+				UE_LOG(LogInputStreamliner, Warning, TEXT("Skipping patch update of unknown action '%s'"), *ActionName);
+				continue;
+			}
+
+			// Only the fields the model sent; they are written onto the action as it is when the patch is applied
+			Operation.Operation = EInputPatchOperationType::Update;
+			if (!DecodeLLMAction(*ActionObj, Operation.Action))
+			{
+				continue;
+			}
+
+			const TPair<const TCHAR*, EInputPatchField> FieldNames[] = {
+				{ TEXT("displayName"), EInputPatchField::DisplayName },
+				{ TEXT("category"), EInputPatchField::Category },
+				{ TEXT("type"), EInputPatchField::ActionType },
+				{ TEXT("allowRebinding"), EInputPatchField::AllowRebinding },
+				{ TEXT("bindings"), EInputPatchField::PlatformBindings }
+			};
+			for (const TPair<const TCHAR*, EInputPatchField>& FieldName : FieldNames)
+			{
+				if ((*ActionObj)->HasField(FieldName.Key))
+				{
+					Operation.UpdatedFields |= static_cast<int32>(FieldName.Value);
+				}
+			}
+			if (Operation.Action.ActionName != Operation.ActionName)
+			{
+				Operation.UpdatedFields |= static_cast<int32>(EInputPatchField::ActionName);
+			}
+		}
+		else if (OpName.Equals(TEXT("add"), ESearchCase::IgnoreCase))
+		{
+			Operation.Operation = EInputPatchOperationType::Add;
+			if (!ActionObj || !DecodeLLMAction(*ActionObj, Operation.Action))
+			{
+				continue;
+			}
+		}
+		else
+		{
+			UE_LOG(LogInputStreamliner, Warning, TEXT("Skipping unknown patch operation '%s'"), *OpName);
+			continue;
+		}
+
+		OutPatch.Operations.Add(MoveTemp(Operation));
+	}
+}
+
+void FInputConfigurationDecoder::DecodeActions(const TArray<TSharedPtr<FJsonValue>>& ActionValues, bool bSavedLayout, TArray<FInputActionDefinition>& OutActions)
+{
+	InputConfigurationDecoderTables::WarmUp();
+
+	const int32 NumActions = ActionValues.Num();
+
+	TArray<FInputActionDefinition> Decoded;
+	Decoded.SetNum(NumActions);
+
+	TArray<bool> Valid;
+	Valid.SetNumZeroed(NumActions);
+
+	const EParallelForFlags Flags = CVarParallelConfigDecode.GetValueOnAnyThread()
+		? EParallelForFlags::None
+		: EParallelForFlags::ForceSingleThread;
+
+	ParallelFor(TEXT("InputStreamliner.DecodeActions"), NumActions, InputConfigurationDecoderTables::MinActionsPerBatch,
+		[&ActionValues, &Decoded, &Valid, bSavedLayout](int32 Index)
+		{
+			const TSharedPtr<FJsonObject>* ActionObj;
+			if (ActionValues[Index].IsValid() && ActionValues[Index]->TryGetObject(ActionObj))
+			{
+				Valid[Index] = bSavedLayout
+					? DecodeSavedAction(*ActionObj, Decoded[Index])
+					: DecodeLLMAction(*ActionObj, Decoded[Index]);
+			}
+		},
+		Flags);
+
+	OutActions.Reset(NumActions);
+	for (int32 Index = 0; Index < NumActions; ++Index)
+	{
+		if (Valid[Index])
+		{
+			OutActions.Add(MoveTemp(Decoded[Index]));
+		}
+	}
+}
+
+bool FInputConfigurationDecoder::DecodeSavedAction(const TSharedPtr<FJsonObject>& ActionObj, FInputActionDefinition& OutAction)
+{
+	using namespace InputConfigurationDecoderTables;
+
+	// Strings are copied straight into the definition; FJsonObject has no way to release them
+	FString ActionName;
+	if (!ActionObj->TryGetStringField(TEXT("actionName"), ActionName) || ActionName.IsEmpty())
+	{
+		return false;
+	}
+
+	OutAction.ActionName = FName(*ActionName);
+	ActionObj->TryGetStringField(TEXT("displayName"), OutAction.DisplayName);
+	ActionObj->TryGetStringField(TEXT("description"), OutAction.Description);
+	ActionObj->TryGetStringField(TEXT("category"), OutAction.Category);
+	ActionObj->TryGetNumberField(TEXT("targetPlatforms"), OutAction.TargetPlatforms);
+	ActionObj->TryGetBoolField(TEXT("bAllowRebinding"), OutAction.bAllowRebinding);
+
+	FString TypeName;
+	if (ActionObj->TryGetStringField(TEXT("actionType"), TypeName))
+	{
+		FindActionType(TypeName, OutAction.ActionType);
+	}
+
+	const TSharedPtr<FJsonObject>* BindingsObj;
+	if (!ActionObj->TryGetObjectField(TEXT("platformBindings"), BindingsObj))
+	{
+		return true;
+	}
+
+	OutAction.PlatformBindings.Reserve((*BindingsObj)->Values.Num());
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*BindingsObj)->Values)
+	{
+		ETargetPlatform Platform;
+		const TSharedPtr<FJsonObject>* PlatformObj;
+		if (!FindPlatform(Pair.Key, Platform) || !Pair.Value.IsValid() || !Pair.Value->TryGetObject(PlatformObj))
+		{
+			continue;
+		}
+
+		FPlatformBindingConfig& PlatformConfig = OutAction.PlatformBindings.Add(Platform);
+		(*PlatformObj)->TryGetStringField(TEXT("touchControlType"), PlatformConfig.TouchControlType);
+
+		const TArray<TSharedPtr<FJsonValue>>* BindingValues;
+		if (!(*PlatformObj)->TryGetArrayField(TEXT("bindings"), BindingValues))
+		{
+			continue;
+		}
+
+		PlatformConfig.Bindings.Reserve(BindingValues->Num());
+		for (const TSharedPtr<FJsonValue>& BindingValue : *BindingValues)
+		{
+			const TSharedPtr<FJsonObject>* BindingObj;
+			if (!BindingValue.IsValid() || !BindingValue->TryGetObject(BindingObj))
+			{
+				continue;
+			}
+
+			FKeyBindingDefinition& Binding = PlatformConfig.Bindings.AddDefaulted_GetRef();
+			Binding.Key = ReadKey((*BindingObj)->TryGetField(TEXT("key")));
+
+			const TArray<TSharedPtr<FJsonValue>>* ModifierValues;
+			if ((*BindingObj)->TryGetArrayField(TEXT("modifiers"), ModifierValues))
+			{
+				Binding.Modifiers.Reserve(ModifierValues->Num());
+				for (const TSharedPtr<FJsonValue>& ModifierValue : *ModifierValues)
+				{
+					Binding.Modifiers.Add(ReadKey(ModifierValue));
+				}
+			}
+
+			FString EnumName;
+			if ((*BindingObj)->TryGetStringField(TEXT("triggerType"), EnumName))
+			{
+				FindTriggerType(EnumName, Binding.TriggerType);
+			}
+			if ((*BindingObj)->TryGetStringField(TEXT("axisDirection"), EnumName))
+			{
+				FindAxisDirection(EnumName, Binding.AxisDirection);
+			}
+			(*BindingObj)->TryGetStringField(TEXT("axisMapping"), Binding.AxisMapping);
+		}
+	}
+
+	return true;
+}
+
+bool FInputConfigurationDecoder::DecodeLLMAction(const TSharedPtr<FJsonObject>& ActionObj, FInputActionDefinition& OutAction)
+{
+	if (!ActionObj.IsValid())
+	{
+		return false;
+	}
+
+	FString ActionName;
+	if (!ActionObj->TryGetStringField(TEXT("name"), ActionName) || ActionName.IsEmpty())
+	{
+		return false;
+	}
+
+	OutAction.ActionName = FName(*ActionName);
+	ActionObj->TryGetStringField(TEXT("displayName"), OutAction.DisplayName);
+	ActionObj->TryGetStringField(TEXT("category"), OutAction.Category);
+	ActionObj->TryGetBoolField(TEXT("allowRebinding"), OutAction.bAllowRebinding);
+
+	FString TypeName;
+	if (ActionObj->TryGetStringField(TEXT("type"), TypeName))
+	{
+		FindActionType(TypeName, OutAction.ActionType);
+	}
+
+	const TSharedPtr<FJsonObject>* BindingsObj;
+	if (!ActionObj->TryGetObjectField(TEXT("bindings"), BindingsObj))
+	{
+		return true;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*BindingsObj)->Values)
+	{
+		ETargetPlatform Platform;
+		if (!FindPlatform(Pair.Key, Platform) || !Pair.Value.IsValid())
+		{
+			continue;
+		}
+
+		FPlatformBindingConfig PlatformConfig;
+
+		// Either an array of key bindings or an object with touchControl
+		const TArray<TSharedPtr<FJsonValue>>* KeysArray;
+		const TSharedPtr<FJsonObject>* PlatformObj;
+
+		if (Pair.Value->TryGetArray(KeysArray))
+		{
+			PlatformConfig.Bindings.Reserve(KeysArray->Num());
+			for (const TSharedPtr<FJsonValue>& KeyValue : *KeysArray)
+			{
+				const TSharedPtr<FJsonObject>* KeyObj;
+				if (!KeyValue.IsValid() || !KeyValue->TryGetObject(KeyObj))
+				{
+					continue;
+				}
+
+				FKeyBindingDefinition& Binding = PlatformConfig.Bindings.AddDefaulted_GetRef();
+				Binding.Key = InputConfigurationDecoderTables::ReadKey((*KeyObj)->TryGetField(TEXT("key")));
+
+				if ((*KeyObj)->TryGetStringField(TEXT("axis"), Binding.AxisMapping))
+				{
+					Binding.AxisDirection = FKeyBindingDefinition::ParseAxisDirection(Binding.AxisMapping);
+				}
+
+				FString TriggerName;
+				if ((*KeyObj)->TryGetStringField(TEXT("trigger"), TriggerName))
+				{
+					FindTriggerType(TriggerName, Binding.TriggerType);
+				}
+			}
+		}
+		else if (Pair.Value->TryGetObject(PlatformObj))
+		{
+			(*PlatformObj)->TryGetStringField(TEXT("touchControl"), PlatformConfig.TouchControlType);
+		}
+
+		OutAction.PlatformBindings.Add(Platform, MoveTemp(PlatformConfig));
+	}
+
+	return true;
+}
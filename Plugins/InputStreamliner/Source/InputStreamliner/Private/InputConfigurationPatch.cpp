@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputConfigurationPatch.h"
+
+void FInputPatchOperation::ApplyUpdate(FInputActionDefinition& Target) const
+{
+	if (UpdatesField(EInputPatchField::ActionName))
+	{
+		Target.ActionName = Action.ActionName;
+	}
+	if (UpdatesField(EInputPatchField::DisplayName))
+	{
+		Target.DisplayName = Action.DisplayName;
+	}
+	if (UpdatesField(EInputPatchField::Category))
+	{
+		Target.Category = Action.Category;
+	}
+	if (UpdatesField(EInputPatchField::ActionType))
+	{
+		Target.ActionType = Action.ActionType;
+	}
+	if (UpdatesField(EInputPatchField::AllowRebinding))
+	{
+		Target.bAllowRebinding = Action.bAllowRebinding;
+	}
+	if (UpdatesField(EInputPatchField::PlatformBindings))
+	{
+		// Platforms the update does not mention keep their bindings
+		for (const TPair<ETargetPlatform, FPlatformBindingConfig>& Pair : Action.PlatformBindings)
+		{
+			Target.PlatformBindings.Add(Pair.Key, Pair.Value);
+		}
+	}
+}
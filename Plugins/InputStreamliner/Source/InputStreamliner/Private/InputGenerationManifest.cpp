@@ -0,0 +1,164 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputGenerationManifest.h"
+#include "InputStreamlinerModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+
+FString FInputGenerationManifest::GetManifestPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("InputStreamliner") / TEXT("GenerationManifest.json");
+}
+
+bool FInputGenerationManifest::LoadFromDisk()
+{
+	*this = FInputGenerationManifest();
+
+	const FString ManifestPath = GetManifestPath();
+	if (!FPaths::FileExists(ManifestPath))
+	{
+		return false;
+	}
+
+	FString JsonString;
+	FInputGenerationManifest Loaded;
+	if (!FFileHelper::LoadFileToString(JsonString, *ManifestPath) ||
+		!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &Loaded))
+	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to read generation manifest, regenerating all assets"));
+		return false;
+	}
+
+	if (Loaded.Version != CurrentVersion)
+	{
+		UE_LOG(LogInputStreamliner, Log, TEXT("Generation manifest version %d is outdated, regenerating all assets"), Loaded.Version);
+
+		// Keep the asset paths so stale assets can still be cleaned up, but force every hash to mismatch
+		for (auto& Pair : Loaded.Actions)
+		{
+			Pair.Value.ContentHash.Empty();
+		}
+		for (auto& Pair : Loaded.MappingContexts)
+		{
+			Pair.Value.ContentHash.Empty();
+		}
+		Loaded.RuntimeManifest.ContentHash.Empty();
+		Loaded.Version = CurrentVersion;
+	}
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FInputGenerationManifest::SaveToDisk() const
+{
+	FString JsonString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(*this, JsonString))
+	{
+		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to serialize generation manifest"));
+		return false;
+	}
+
+	const FString ManifestPath = GetManifestPath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(ManifestPath), true);
+
+	if (!FFileHelper::SaveStringToFile(JsonString, *ManifestPath))
+	{
+		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to save generation manifest to: %s"), *ManifestPath);
+		return false;
+	}
+
+	return true;
+}
+
+void FInputGenerationManifest::DeleteFromDisk()
+{
+	IFileManager::Get().Delete(*GetManifestPath(), false, false, true);
+}
+
+TArray<FString> FInputGenerationManifest::GetAllAssetPaths() const
+{
+	TArray<FString> Paths;
+	Paths.Reserve(Actions.Num() + MappingContexts.Num() + 1);
+
+	for (const auto& Pair : Actions)
+	{
+		Paths.Add(Pair.Value.AssetPath);
+	}
+	for (const auto& Pair : MappingContexts)
+	{
+		Paths.Add(Pair.Value.AssetPath);
+	}
+	if (!RuntimeManifest.AssetPath.IsEmpty())
+	{
+		Paths.Add(RuntimeManifest.AssetPath);
+	}
+
+	return Paths;
+}
+
+static FString HashText(const FString& Text)
+{
+	FTCHARToUTF8 Utf8(*Text);
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+	return Hash.ToString();
+}
+
+FString FInputGenerationManifest::HashActionDefinition(const FInputActionDefinition& Definition)
+{
+	// Bindings only affect mapping contexts, so leave them out of the action's own hash
+	FInputActionDefinition AssetFields = Definition;
+	AssetFields.PlatformBindings.Empty();
+
+	FString JsonString;
+	FJsonObjectConverter::UStructToJsonObjectString(AssetFields, JsonString, 0, 0, 0, nullptr, false);
+	return HashText(JsonString);
+}
+
+FString FInputGenerationManifest::HashMappingContext(ETargetPlatform Platform, const TArray<const FInputActionDefinition*>& Actions, const FString& InputActionsPath)
+{
+	FString Combined = FString::Printf(TEXT("%d|%s"), static_cast<int32>(Platform), *InputActionsPath);
+
+	for (const FInputActionDefinition* Action : Actions)
+	{
+		Combined += FString::Printf(TEXT("|%s:%d:"), *Action->ActionName.ToString(), static_cast<int32>(Action->ActionType));
+
+		if (const FPlatformBindingConfig* Binding = Action->PlatformBindings.Find(Platform))
+		{
+			FString BindingJson;
+			FJsonObjectConverter::UStructToJsonObjectString(*Binding, BindingJson, 0, 0, 0, nullptr, false);
+			Combined += BindingJson;
+		}
+	}
+
+	return HashText(Combined);
+}
+
+FString FInputGenerationManifest::HashRuntimeManifest(const TArray<FInputActionDefinition>& Actions, const FString& InputActionsPath, const TArray<FString>& MappingContextPaths)
+{
+	FString Combined = InputActionsPath;
+
+	for (const FInputActionDefinition& Action : Actions)
+	{
+		Combined += FString::Printf(TEXT("|%s:%d:%d:"), *Action.ActionName.ToString(), Action.TargetPlatforms, Action.bAllowRebinding ? 1 : 0);
+
+		// Default keys come from these bindings
+		for (const auto& Pair : Action.PlatformBindings)
+		{
+			FString BindingJson;
+			FJsonObjectConverter::UStructToJsonObjectString(Pair.Value, BindingJson, 0, 0, 0, nullptr, false);
+			Combined += FString::Printf(TEXT("%d=%s"), static_cast<int32>(Pair.Key), *BindingJson);
+		}
+	}
+
+	for (const FString& Path : MappingContextPaths)
+	{
+		Combined += TEXT("|") + Path;
+	}
+
+	return HashText(Combined);
+}
@@ -0,0 +1,272 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputIntentMatcher.h"
+#include "InputConfigurationDecoder.h"
+#include "InputStreamlinerModule.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace InputIntentPresets
+{
+	struct FPreset
+	{
+		const TCHAR* Name;
+		const TCHAR* Description;
+		const TCHAR* JSON;
+	};
+
+	/** Curated genre presets in the LLM output format; descriptions list the words people use for each genre */
+	static const FPreset Presets[] =
+	{
+		{
+			TEXT("FPS"),
+			TEXT("first person shooter fps shooting gun weapon wasd movement mouse look jump sprint run shoot fire aim ads reload interact use"),
+			TEXT(R"({"actions":[)"
+			R"({"name":"Move","displayName":"Move","type":"Axis2D","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"W","axis":"+Y"},{"key":"S","axis":"-Y"},{"key":"A","axis":"-X"},{"key":"D","axis":"+X"}],"PC_Gamepad":[{"key":"Gamepad_LeftStick"}],"iOS":{"touchControl":"VirtualJoystick_Fixed"},"Android":{"touchControl":"VirtualJoystick_Fixed"}}},)"
+			R"({"name":"Look","displayName":"Look","type":"Axis2D","category":"Camera","allowRebinding":false,"bindings":{"PC_Keyboard":[{"key":"MouseXY"}],"PC_Gamepad":[{"key":"Gamepad_RightStick"}],"iOS":{"touchControl":"TouchRegion"},"Android":{"touchControl":"TouchRegion"}}},)"
+			R"({"name":"Jump","displayName":"Jump","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"SpaceBar"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Bottom"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Sprint","displayName":"Sprint","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"LeftShift","trigger":"Hold"}],"PC_Gamepad":[{"key":"Gamepad_LeftThumbstick"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Fire","displayName":"Fire","type":"Bool","category":"Combat","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"LeftMouseButton"}],"PC_Gamepad":[{"key":"Gamepad_RightTrigger"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Aim","displayName":"Aim","type":"Bool","category":"Combat","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"RightMouseButton"}],"PC_Gamepad":[{"key":"Gamepad_LeftTrigger"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Reload","displayName":"Reload","type":"Bool","category":"Combat","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"R"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Left"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Interact","displayName":"Interact","type":"Bool","category":"UI","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"E"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Top"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}})"
+			R"(],"gyro":{"enabled":true,"linkedAction":"Look","activationAction":"Aim"}})")
+		},
+		{
+			TEXT("Racing"),
+			TEXT("racing race driving drive car kart vehicle throttle accelerate gas brake reverse steer steering nitro boost handbrake drift look behind"),
+			TEXT(R"({"actions":[)"
+			R"({"name":"Throttle","displayName":"Throttle","type":"Axis1D","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"W"}],"PC_Gamepad":[{"key":"Gamepad_RightTriggerAxis"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Brake","displayName":"Brake","type":"Axis1D","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"S"}],"PC_Gamepad":[{"key":"Gamepad_LeftTriggerAxis"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Steer","displayName":"Steer","type":"Axis1D","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"A","axis":"-X"},{"key":"D","axis":"+X"}],"PC_Gamepad":[{"key":"Gamepad_LeftX"}],"iOS":{"touchControl":"VirtualJoystick_Fixed"},"Android":{"touchControl":"VirtualJoystick_Fixed"}}},)"
+			R"({"name":"Nitro","displayName":"Nitro Boost","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"LeftShift"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Bottom"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Handbrake","displayName":"Handbrake","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"SpaceBar"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Right"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"LookBehind","displayName":"Look Behind","type":"Bool","category":"Camera","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"C","trigger":"Hold"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Top","trigger":"Hold"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}}]})")
+		},
+		{
+			TEXT("TwinStick"),
+			TEXT("top down twin stick shooter arena shoot shooting fire aim dash pause wasd movement"),
+			TEXT(R"({"actions":[)"
+			R"({"name":"Move","displayName":"Move","type":"Axis2D","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"W","axis":"+Y"},{"key":"S","axis":"-Y"},{"key":"A","axis":"-X"},{"key":"D","axis":"+X"}],"PC_Gamepad":[{"key":"Gamepad_LeftStick"}],"iOS":{"touchControl":"VirtualJoystick_Floating"},"Android":{"touchControl":"VirtualJoystick_Floating"}}},)"
+			R"({"name":"Aim","displayName":"Aim","type":"Axis2D","category":"Combat","allowRebinding":false,"bindings":{"PC_Keyboard":[{"key":"MouseXY"}],"PC_Gamepad":[{"key":"Gamepad_RightStick"}],"iOS":{"touchControl":"VirtualJoystick_Floating"},"Android":{"touchControl":"VirtualJoystick_Floating"}}},)"
+			R"({"name":"Fire","displayName":"Fire","type":"Bool","category":"Combat","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"LeftMouseButton"}],"PC_Gamepad":[{"key":"Gamepad_RightTrigger"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Dash","displayName":"Dash","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"SpaceBar"}],"PC_Gamepad":[{"key":"Gamepad_LeftShoulder"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Pause","displayName":"Pause","type":"Bool","category":"UI","allowRebinding":false,"bindings":{"PC_Keyboard":[{"key":"Escape"}],"PC_Gamepad":[{"key":"Gamepad_Special_Right"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}}]})")
+		},
+		{
+			TEXT("MobileThirdPerson"),
+			TEXT("mobile phone touch third person virtual joystick swipe camera look tap attack double tap dodge hold block swipe up jump"),
+			TEXT(R"({"actions":[)"
+			R"({"name":"Move","displayName":"Move","type":"Axis2D","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"W","axis":"+Y"},{"key":"S","axis":"-Y"},{"key":"A","axis":"-X"},{"key":"D","axis":"+X"}],"PC_Gamepad":[{"key":"Gamepad_LeftStick"}],"iOS":{"touchControl":"VirtualJoystick_Floating"},"Android":{"touchControl":"VirtualJoystick_Floating"}}},)"
+			R"({"name":"Look","displayName":"Look","type":"Axis2D","category":"Camera","allowRebinding":false,"bindings":{"PC_Keyboard":[{"key":"MouseXY"}],"PC_Gamepad":[{"key":"Gamepad_RightStick"}],"iOS":{"touchControl":"TouchRegion"},"Android":{"touchControl":"TouchRegion"}}},)"
+			R"({"name":"Attack","displayName":"Attack","type":"Bool","category":"Combat","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"LeftMouseButton"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Left"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Dodge","displayName":"Dodge","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"LeftAlt"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Right"}],"iOS":{"touchControl":"GestureZone"},"Android":{"touchControl":"GestureZone"}}},)"
+			R"({"name":"Block","displayName":"Block","type":"Bool","category":"Combat","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"RightMouseButton","trigger":"Hold"}],"PC_Gamepad":[{"key":"Gamepad_LeftTrigger","trigger":"Hold"}],"iOS":{"touchControl":"VirtualButton"},"Android":{"touchControl":"VirtualButton"}}},)"
+			R"({"name":"Jump","displayName":"Jump","type":"Bool","category":"Movement","allowRebinding":true,"bindings":{"PC_Keyboard":[{"key":"SpaceBar"}],"PC_Gamepad":[{"key":"Gamepad_FaceButton_Bottom"}],"iOS":{"touchControl":"GestureZone"},"Android":{"touchControl":"GestureZone"}}}]})")
+		}
+	};
+
+	/** Words that say nothing about which controls are wanted */
+	static const TCHAR* FillerWords[] =
+	{
+		TEXT("a"), TEXT("an"), TEXT("and"), TEXT("the"), TEXT("to"), TEXT("for"), TEXT("with"), TEXT("of"), TEXT("on"),
+		TEXT("in"), TEXT("or"), TEXT("my"), TEXT("i"), TEXT("we"), TEXT("need"), TEXT("want"), TEXT("like"), TEXT("some"),
+		TEXT("game"), TEXT("control"), TEXT("input"), TEXT("button"), TEXT("key"), TEXT("please"), TEXT("style")
+	};
+}
+
+TArray<FString> UInputIntentMatcher::Tokenize(const FString& Text)
+{
+	static const TSet<FString> Filler = []()
+	{
+		TSet<FString> Words;
+		for (const TCHAR* Word : InputIntentPresets::FillerWords)
+		{
+			Words.Add(Word);
+		}
+		return Words;
+	}();
+
+	TArray<FString> Terms;
+	FString Current;
+
+	auto Flush = [&Terms, &Current]()
+	{
+		// Fold plurals so "controls" and "triggers" match their singular forms
+		if (Current.Len() > 3 && Current.EndsWith(TEXT("s")) && !Current.EndsWith(TEXT("ss")))
+		{
+			Current.LeftChopInline(1);
+		}
+
+		if (!Current.IsEmpty() && !Filler.Contains(Current))
+		{
+			Terms.Add(Current);
+		}
+		Current.Reset();
+	};
+
+	for (int32 i = 0; i < Text.Len(); i++)
+	{
+		const TCHAR c = Text[i];
+		if (!FChar::IsAlnum(c))
+		{
+			Flush();
+			continue;
+		}
+
+		// Split CamelCase action names ("LockOn" -> "lock", "on")
+		if (FChar::IsUpper(c) && i > 0 && FChar::IsLower(Text[i - 1]))
+		{
+			Flush();
+		}
+		Current.AppendChar(FChar::ToLower(c));
+	}
+	Flush();
+
+	return Terms;
+}
+
+void UInputIntentMatcher::AddTemplate(const FString& Name, const FString& Description, const FInputStreamlinerConfiguration& Configuration)
+{
+	FInputIntentTemplate& Template = Templates.AddDefaulted_GetRef();
+	Template.Name = Name;
+	Template.Description = Description;
+	Template.Configuration = Configuration;
+
+	Template.Terms.Append(Tokenize(Description));
+	for (const FInputActionDefinition& Action : Configuration.Actions)
+	{
+		Template.Terms.Append(Tokenize(Action.ActionName.ToString()));
+		Template.Terms.Append(Tokenize(Action.DisplayName));
+
+		// Descriptions often name the keys ("spacebar to jump")
+		for (const TPair<ETargetPlatform, FPlatformBindingConfig>& Platform : Action.PlatformBindings)
+		{
+			for (const FKeyBindingDefinition& Binding : Platform.Value.Bindings)
+			{
+				Template.Terms.Append(Tokenize(Binding.Key.GetFName().ToString()));
+			}
+		}
+	}
+
+	RebuildWeights();
+}
+
+bool UInputIntentMatcher::AddTemplateFromJSON(const FString& Name, const FString& Description, const FString& ConfigurationJSON)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ConfigurationJSON);
+
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Intent template %s is not valid JSON"), *Name);
+		return false;
+	}
+
+	FInputStreamlinerConfiguration Configuration;
+	FInputConfigurationDecoder::DecodeLLMConfiguration(JsonObject, Configuration);
+	if (Configuration.Actions.Num() == 0)
+	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Intent template %s has no actions"), *Name);
+		return false;
+	}
+
+	AddTemplate(Name, Description, Configuration);
+	return true;
+}
+
+void UInputIntentMatcher::AddBuiltInPresets()
+{
+	for (const InputIntentPresets::FPreset& Preset : InputIntentPresets::Presets)
+	{
+		AddTemplateFromJSON(Preset.Name, Preset.Description, Preset.JSON);
+	}
+}
+
+void UInputIntentMatcher::ClearTemplates()
+{
+	Templates.Reset();
+	RebuildWeights();
+}
+
+void UInputIntentMatcher::RebuildWeights()
+{
+	TMap<FString, int32> TemplateCounts;
+	for (const FInputIntentTemplate& Template : Templates)
+	{
+		for (const FString& Term : Template.Terms)
+		{
+			TemplateCounts.FindOrAdd(Term)++;
+		}
+	}
+
+	// Terms shared by many templates ("move", "jump") say little about which one is meant
+	const float NumTemplates = FMath::Max(Templates.Num(), 1);
+	TermWeights.Reset();
+	for (const TPair<FString, int32>& Pair : TemplateCounts)
+	{
+		TermWeights.Add(Pair.Key, FMath::Loge(1.0f + NumTemplates / Pair.Value));
+	}
+	UnknownTermWeight = FMath::Loge(1.0f + 2.0f * NumTemplates);
+}
+
+float UInputIntentMatcher::GetTermWeight(const FString& Term) const
+{
+	const float* Weight = TermWeights.Find(Term);
+	return Weight ? *Weight : UnknownTermWeight;
+}
+
+float UInputIntentMatcher::Match(const FString& Description, FInputStreamlinerConfiguration& OutConfig, FString& OutTemplateName) const
+{
+	const TSet<FString> QueryTerms(Tokenize(Description));
+
+	float TotalWeight = 0.0f;
+	for (const FString& Term : QueryTerms)
+	{
+		TotalWeight += GetTermWeight(Term);
+	}
+
+	if (TotalWeight <= 0.0f || Templates.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	int32 BestIndex = INDEX_NONE;
+	float BestScore = 0.0f;
+	float SecondScore = 0.0f;
+
+	for (int32 i = 0; i < Templates.Num(); i++)
+	{
+		float Covered = 0.0f;
+		for (const FString& Term : QueryTerms)
+		{
+			if (Templates[i].Terms.Contains(Term))
+			{
+				Covered += GetTermWeight(Term);
+			}
+		}
+
+		const float Score = Covered / TotalWeight;
+		if (Score > BestScore)
+		{
+			SecondScore = BestScore;
+			BestScore = Score;
+			BestIndex = i;
+		}
+		else if (Score > SecondScore)
+		{
+			SecondScore = Score;
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return 0.0f;
+	}
+
+	OutConfig = Templates[BestIndex].Configuration;
+	OutTemplateName = Templates[BestIndex].Name;
+
+	// Nothing distinguishes the best template from another one
+	return FMath::IsNearlyEqual(BestScore, SecondScore) ? BestScore * 0.5f : BestScore;
+}
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputKeyTraits.h"
+
+namespace InputKeyTraitsDefaults
+{
+	constexpr float StickDeadZone = 0.2f;
+	constexpr float TriggerDeadZone = 0.1f;
+}
+
+FInputKeyTraitsTable::FInputKeyTraitsTable()
+{
+	TArray<FKey> AllKeys;
+	EKeys::GetAllKeys(AllKeys);
+
+	TraitsByKey.Reserve(AllKeys.Num());
+	for (const FKey& Key : AllKeys)
+	{
+		TraitsByKey.Add(Key.GetFName(), Classify(Key));
+	}
+
+	Aliases.Add(TEXT("Gamepad_LeftStick"), EKeys::Gamepad_Left2D);
+	Aliases.Add(TEXT("Gamepad_RightStick"), EKeys::Gamepad_Right2D);
+	Aliases.Add(TEXT("MouseXY"), EKeys::Mouse2D);
+	Aliases.Add(TEXT("Mouse"), EKeys::Mouse2D);
+}
+
+const FInputKeyTraitsTable& FInputKeyTraitsTable::GetTable()
+{
+	static const FInputKeyTraitsTable Table;
+	return Table;
+}
+
+FInputKeyTraits FInputKeyTraitsTable::Classify(const FKey& Key)
+{
+	FInputKeyTraits Traits;
+
+	if (!Key.IsAnalog() && !Key.IsAxis1D() && !Key.IsAxis2D() && !Key.IsAxis3D())
+	{
+		// Digital keys, including Gamepad_LeftTrigger, shoulders and stick directions
+		return Traits;
+	}
+
+	if (Key == EKeys::Gamepad_LeftTriggerAxis || Key == EKeys::Gamepad_RightTriggerAxis)
+	{
+		Traits.Kind = EInputKeyKind::Trigger;
+		Traits.bNeedsDeadZone = true;
+		Traits.DeadZoneType = EDeadZoneType::Axial;
+		Traits.DeadZoneLowerThreshold = InputKeyTraitsDefaults::TriggerDeadZone;
+	}
+	else if (Key.IsGamepadKey() && Key.IsAxis2D())
+	{
+		Traits.Kind = EInputKeyKind::Stick2D;
+		Traits.bNeedsDeadZone = true;
+		Traits.DeadZoneType = EDeadZoneType::Radial;
+		Traits.DeadZoneLowerThreshold = InputKeyTraitsDefaults::StickDeadZone;
+	}
+	else if (Key.IsGamepadKey() && Key.IsAxis1D())
+	{
+		Traits.Kind = EInputKeyKind::StickAxis;
+		Traits.bNeedsDeadZone = true;
+		Traits.DeadZoneType = EDeadZoneType::Axial;
+		Traits.DeadZoneLowerThreshold = InputKeyTraitsDefaults::StickDeadZone;
+	}
+	else if (Key.IsMouseButton() || Key == EKeys::MouseX || Key == EKeys::MouseY || Key == EKeys::Mouse2D
+		|| Key == EKeys::MouseWheelAxis)
+	{
+		Traits.Kind = EInputKeyKind::RelativeAxis;
+	}
+	else
+	{
+		Traits.Kind = EInputKeyKind::OtherAnalog;
+	}
+
+	return Traits;
+}
+
+const FInputKeyTraits& FInputKeyTraitsTable::Get(const FKey& Key)
+{
+	static const FInputKeyTraits ButtonTraits;
+
+	const FInputKeyTraits* Traits = GetTable().TraitsByKey.Find(Key.GetFName());
+	return Traits ? *Traits : ButtonTraits;
+}
+
+FKey FInputKeyTraitsTable::ResolveKey(const FKey& Key)
+{
+	if (Key.IsValid())
+	{
+		return Key;
+	}
+
+	const FKey* Alias = GetTable().Aliases.Find(Key.GetFName());
+	return Alias ? *Alias : Key;
+}
+
+FKey FInputKeyTraitsTable::ResolveKeyName(const FString& KeyName)
+{
+	return ResolveKey(FKey(*KeyName));
+}
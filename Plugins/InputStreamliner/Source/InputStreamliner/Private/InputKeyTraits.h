@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+#include "InputModifiers.h"
+
+/**
+ * Physical kind of an input key, as far as mapping generation cares
+ */
+enum class EInputKeyKind : uint8
+{
+	/** Digital key or button (including stick directions and digital triggers) */
+	Button,
+	/** Two-axis analog stick */
+	Stick2D,
+	/** Single axis of an analog stick */
+	StickAxis,
+	/** Analog trigger */
+	Trigger,
+	/** Mouse or other relative axis; never needs a dead zone */
+	RelativeAxis,
+	/** Other analog input (motion, touch) */
+	OtherAnalog
+};
+
+/**
+ * Precomputed classification of a key
+ */
+struct FInputKeyTraits
+{
+	EInputKeyKind Kind = EInputKeyKind::Button;
+
+	/** Whether a dead zone modifier should be added */
+	bool bNeedsDeadZone = false;
+
+	EDeadZoneType DeadZoneType = EDeadZoneType::Radial;
+
+	float DeadZoneLowerThreshold = 0.0f;
+
+	/** Whether the key reports an analog value (digital keys need axis modifiers instead) */
+	bool IsAnalog() const { return Kind != EInputKeyKind::Button; }
+};
+
+/**
+ * Key classification table, built once from every key registered with EKeys
+ */
+class FInputKeyTraitsTable
+{
+public:
+	/** Get the traits of a key; unknown keys are treated as buttons */
+	static const FInputKeyTraits& Get(const FKey& Key);
+
+	/** Resolve shorthand names produced by the LLM (e.g. Gamepad_LeftStick) to real keys */
+	static FKey ResolveKey(const FKey& Key);
+
+	/** Resolve a key name, applying shorthand aliases */
+	static FKey ResolveKeyName(const FString& KeyName);
+
+private:
+	FInputKeyTraitsTable();
+
+	static const FInputKeyTraitsTable& GetTable();
+
+	static FInputKeyTraits Classify(const FKey& Key);
+
+	TMap<FName, FInputKeyTraits> TraitsByKey;
+
+	TMap<FName, FKey> Aliases;
+};
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputStreamlinerConfiguration.h"
+
+void FInputConfigurationIndex::Build(const FInputStreamlinerConfiguration& Config)
+{
+	Reset();
+
+	ActionIndexByName.Reserve(Config.Actions.Num());
+	for (int32 ActionIndex = 0; ActionIndex < Config.Actions.Num(); ActionIndex++)
+	{
+		const FInputActionDefinition& Action = Config.Actions[ActionIndex];
+		ActionIndexByName.Add(Action.ActionName, ActionIndex);
+
+		for (int32 Slot = 0; Slot < NumPlatformSlots; Slot++)
+		{
+			if (Action.TargetPlatforms & (1 << Slot))
+			{
+				ActionsByPlatform[Slot].Add(ActionIndex);
+			}
+		}
+	}
+
+	TouchControlIndexByName.Reserve(Config.TouchControls.Num());
+	for (int32 ControlIndex = 0; ControlIndex < Config.TouchControls.Num(); ControlIndex++)
+	{
+		const FTouchControlDefinition& Control = Config.TouchControls[ControlIndex];
+		TouchControlIndexByName.Add(Control.ControlName, ControlIndex);
+
+		if (!Control.LinkedActionName.IsNone())
+		{
+			TouchControlsByAction.FindOrAdd(Control.LinkedActionName).Add(ControlIndex);
+		}
+	}
+
+	NumIndexedActions = Config.Actions.Num();
+	NumIndexedTouchControls = Config.TouchControls.Num();
+	IndexedModificationCount = Config.GetModificationCount();
+}
+
+void FInputConfigurationIndex::Reset()
+{
+	ActionIndexByName.Reset();
+	for (TArray<int32>& PlatformActions : ActionsByPlatform)
+	{
+		PlatformActions.Reset();
+	}
+	TouchControlIndexByName.Reset();
+	TouchControlsByAction.Reset();
+	NumIndexedActions = INDEX_NONE;
+	NumIndexedTouchControls = INDEX_NONE;
+}
+
+const TArray<int32>& FInputConfigurationIndex::GetActionsForPlatform(ETargetPlatform Platform) const
+{
+	static const TArray<int32> Empty;
+
+	const int32 Slot = GetPlatformSlot(Platform);
+	return Slot != INDEX_NONE ? ActionsByPlatform[Slot] : Empty;
+}
+
+int32 FInputConfigurationIndex::GetPlatformSlot(ETargetPlatform Platform)
+{
+	const uint32 Bits = static_cast<uint32>(Platform);
+	if (Bits == 0 || !FMath::IsPowerOfTwo(Bits))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Slot = static_cast<int32>(FMath::FloorLog2(Bits));
+	return Slot < NumPlatformSlots ? Slot : INDEX_NONE;
+}
@@ -2,15 +2,28 @@
 
 #include "InputStreamlinerManager.h"
 #include "InputStreamlinerModule.h"
+#include "InputConfigurationDecoder.h"
+#include "InputStreamlinerFileUtils.h"
+#include "InputStreamlinerMetrics.h"
 #include "InputMappingContext.h"
 #include "Misc/FileHelper.h"
 #include "JsonObjectConverter.h"
-#include "HAL/PlatformFileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "ScopedTransaction.h"
+#include "Async/Async.h"
+
+static TAutoConsoleVariable<float> CVarConfigAutosaveDelay(
+	TEXT("InputStreamliner.ConfigAutosaveDelay"),
+	1.0f,
+	TEXT("Seconds after the last configuration change before it is saved. Negative disables autosave."));
 
 void UInputStreamlinerManager::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	// Patches are applied as undoable transactions
+	SetFlags(RF_Transactional);
+
 	UE_LOG(LogInputStreamliner, Log, TEXT("InputStreamlinerManager initialized"));
 
 	// Try to load existing configuration
@@ -20,7 +33,8 @@ void UInputStreamlinerManager::Initialize(FSubsystemCollectionBase& Collection)
 void UInputStreamlinerManager::Deinitialize()
 {
 	// Auto-save configuration on shutdown
-	SaveConfiguration();
+	CancelAutosave();
+	SaveConfiguration(true);
 
 	Super::Deinitialize();
 }
@@ -44,6 +58,7 @@ bool UInputStreamlinerManager::AddInputAction(const FInputActionDefinition& NewA
 
 	// Add to configuration
 	CurrentConfig.Actions.Add(NewAction);
+	CurrentConfig.MarkModified();
 
 	// Broadcast events
 	OnActionAdded.Broadcast(NewAction.ActionName);
@@ -55,11 +70,7 @@ bool UInputStreamlinerManager::AddInputAction(const FInputActionDefinition& NewA
 
 bool UInputStreamlinerManager::RemoveInputAction(FName ActionName)
 {
-	int32 IndexToRemove = CurrentConfig.Actions.IndexOfByPredicate(
-		[ActionName](const FInputActionDefinition& Action)
-		{
-			return Action.ActionName == ActionName;
-		});
+	int32 IndexToRemove = CurrentConfig.FindActionIndex(ActionName);
 
 	if (IndexToRemove == INDEX_NONE)
 	{
@@ -76,6 +87,7 @@ bool UInputStreamlinerManager::RemoveInputAction(FName ActionName)
 
 	// Remove the action
 	CurrentConfig.Actions.RemoveAt(IndexToRemove);
+	CurrentConfig.MarkModified();
 
 	// Broadcast events
 	OnActionRemoved.Broadcast(ActionName);
@@ -106,17 +118,37 @@ bool UInputStreamlinerManager::UpdateInputAction(FName ActionName, const FInputA
 		}
 
 		// Update touch controls if name changed
-		for (FTouchControlDefinition& Control : CurrentConfig.TouchControls)
+		if (CurrentConfig.IsIndexValid())
+		{
+			if (const TArray<int32>* LinkedControls = CurrentConfig.GetIndex().TouchControlsByAction.Find(ActionName))
+			{
+				for (int32 ControlIndex : *LinkedControls)
+				{
+					CurrentConfig.TouchControls[ControlIndex].LinkedActionName = UpdatedAction.ActionName;
+				}
+			}
+		}
+		else
 		{
-			if (Control.LinkedActionName == ActionName)
+			for (FTouchControlDefinition& Control : CurrentConfig.TouchControls)
 			{
-				Control.LinkedActionName = UpdatedAction.ActionName;
+				if (Control.LinkedActionName == ActionName)
+				{
+					Control.LinkedActionName = UpdatedAction.ActionName;
+				}
 			}
 		}
 	}
 
 	// Apply update
 	*ExistingAction = UpdatedAction;
+	CurrentConfig.MarkModified();
+
+	// A rename leaves the index pointing at the old name; rebuild before listeners look it up
+	if (UpdatedAction.ActionName != ActionName)
+	{
+		CurrentConfig.RebuildIndex();
+	}
 
 	// Broadcast events
 	OnActionUpdated.Broadcast(UpdatedAction.ActionName);
@@ -154,11 +186,7 @@ bool UInputStreamlinerManager::DuplicateInputAction(FName SourceActionName, FNam
 
 void UInputStreamlinerManager::ReorderAction(FName ActionName, int32 NewIndex)
 {
-	int32 CurrentIndex = CurrentConfig.Actions.IndexOfByPredicate(
-		[ActionName](const FInputActionDefinition& Action)
-		{
-			return Action.ActionName == ActionName;
-		});
+	int32 CurrentIndex = CurrentConfig.FindActionIndex(ActionName);
 
 	if (CurrentIndex == INDEX_NONE)
 	{
@@ -175,9 +203,10 @@ void UInputStreamlinerManager::ReorderAction(FName ActionName, int32 NewIndex)
 	}
 
 	// Remove and reinsert at new position
-	FInputActionDefinition Action = CurrentConfig.Actions[CurrentIndex];
+	FInputActionDefinition Action = MoveTemp(CurrentConfig.Actions[CurrentIndex]);
 	CurrentConfig.Actions.RemoveAt(CurrentIndex);
-	CurrentConfig.Actions.Insert(Action, NewIndex);
+	CurrentConfig.Actions.Insert(MoveTemp(Action), NewIndex);
+	CurrentConfig.MarkModified();
 
 	NotifyConfigurationChanged();
 }
@@ -186,12 +215,72 @@ void UInputStreamlinerManager::RemoveAllActions()
 {
 	CurrentConfig.Actions.Empty();
 	CurrentConfig.TouchControls.Empty();
+	CurrentConfig.MarkModified();
 
 	NotifyConfigurationChanged();
 
 	UE_LOG(LogInputStreamliner, Log, TEXT("Removed all input actions"));
 }
 
+int32 UInputStreamlinerManager::ApplyConfigurationPatch(const FInputConfigurationPatch& Patch)
+{
+	if (Patch.IsEmpty())
+	{
+		return 0;
+	}
+
+	FScopedTransaction Transaction(NSLOCTEXT("InputStreamliner", "ApplyConfigurationPatch", "Apply Input Configuration Patch"));
+	Modify();
+
+	bBatchingChanges = true;
+	bChangedDuringBatch = false;
+
+	int32 NumApplied = 0;
+	for (const FInputPatchOperation& Operation : Patch.Operations)
+	{
+		bool bApplied = false;
+		switch (Operation.Operation)
+		{
+		case EInputPatchOperationType::Add:
+			bApplied = AddInputAction(Operation.Action);
+			break;
+		case EInputPatchOperationType::Update:
+			if (const FInputActionDefinition* CurrentAction = CurrentConfig.FindAction(Operation.ActionName))
+			{
+				FInputActionDefinition UpdatedAction = *CurrentAction;
+				Operation.ApplyUpdate(UpdatedAction);
+				bApplied = UpdateInputAction(Operation.ActionName, UpdatedAction);
+			}
+			else
+			{
+				UE_LOG(LogInputStreamliner, Warning, TEXT("Skipping patch update of '%s': the action no longer exists"), *Operation.ActionName.ToString());
+			}
+			break;
+		case EInputPatchOperationType::Remove:
+			bApplied = RemoveInputAction(Operation.ActionName);
+			break;
+		}
+
+		if (bApplied)
+		{
+			NumApplied++;
+		}
+	}
+
+	bBatchingChanges = false;
+	if (bChangedDuringBatch)
+	{
+		NotifyConfigurationChanged();
+	}
+	else
+	{
+		Transaction.Cancel();
+	}
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Applied %d of %d patch operations"), NumApplied, Patch.Operations.Num());
+	return NumApplied;
+}
+
 void UInputStreamlinerManager::ImportActionsFromContext(UInputMappingContext* ExistingContext)
 {
 	if (!ExistingContext)
@@ -209,13 +298,7 @@ void UInputStreamlinerManager::ImportActionsFromContext(UInputMappingContext* Ex
 bool UInputStreamlinerManager::AddTouchControl(const FTouchControlDefinition& NewControl)
 {
 	// Check for duplicate names
-	bool bExists = CurrentConfig.TouchControls.ContainsByPredicate(
-		[&NewControl](const FTouchControlDefinition& Control)
-		{
-			return Control.ControlName == NewControl.ControlName;
-		});
-
-	if (bExists)
+	if (CurrentConfig.FindTouchControlIndex(NewControl.ControlName) != INDEX_NONE)
 	{
 		UE_LOG(LogInputStreamliner, Warning, TEXT("Touch control '%s' already exists"),
 			*NewControl.ControlName.ToString());
@@ -223,6 +306,7 @@ bool UInputStreamlinerManager::AddTouchControl(const FTouchControlDefinition& Ne
 	}
 
 	CurrentConfig.TouchControls.Add(NewControl);
+	CurrentConfig.MarkModified();
 	NotifyConfigurationChanged();
 
 	return true;
@@ -230,40 +314,40 @@ bool UInputStreamlinerManager::AddTouchControl(const FTouchControlDefinition& Ne
 
 bool UInputStreamlinerManager::RemoveTouchControl(FName ControlName)
 {
-	int32 Removed = CurrentConfig.TouchControls.RemoveAll(
-		[ControlName](const FTouchControlDefinition& Control)
-		{
-			return Control.ControlName == ControlName;
-		});
-
-	if (Removed > 0)
+	const int32 ControlIndex = CurrentConfig.FindTouchControlIndex(ControlName);
+	if (ControlIndex == INDEX_NONE)
 	{
-		NotifyConfigurationChanged();
-		return true;
+		return false;
 	}
 
-	return false;
+	CurrentConfig.TouchControls.RemoveAt(ControlIndex);
+	CurrentConfig.MarkModified();
+	NotifyConfigurationChanged();
+	return true;
 }
 
 bool UInputStreamlinerManager::UpdateTouchControl(FName ControlName, const FTouchControlDefinition& UpdatedControl)
 {
-	FTouchControlDefinition* ExistingControl = CurrentConfig.TouchControls.FindByPredicate(
-		[ControlName](const FTouchControlDefinition& Control)
-		{
-			return Control.ControlName == ControlName;
-		});
-
-	if (!ExistingControl)
+	const int32 ControlIndex = CurrentConfig.FindTouchControlIndex(ControlName);
+	if (ControlIndex == INDEX_NONE)
 	{
 		return false;
 	}
 
-	*ExistingControl = UpdatedControl;
+	CurrentConfig.TouchControls[ControlIndex] = UpdatedControl;
+	CurrentConfig.MarkModified();
 	NotifyConfigurationChanged();
 
 	return true;
 }
 
+void UInputStreamlinerManager::SetGyroConfiguration(const FGyroConfiguration& GyroConfig)
+{
+	CurrentConfig.GyroConfig = GyroConfig;
+	CurrentConfig.MarkModified();
+	NotifyConfigurationChanged();
+}
+
 bool UInputStreamlinerManager::GetActionByName(FName ActionName, FInputActionDefinition& OutAction) const
 {
 	const FInputActionDefinition* Found = CurrentConfig.FindAction(ActionName);
@@ -308,39 +392,134 @@ bool UInputStreamlinerManager::ValidateAction(const FInputActionDefinition& Acti
 	return true;
 }
 
-bool UInputStreamlinerManager::SaveConfiguration()
+bool UInputStreamlinerManager::SaveConfiguration(bool bWaitForWrite)
 {
-	FString ConfigPath = GetConfigurationFilePath();
+	INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_SaveConfiguration);
+
+	// An explicit save covers any pending autosave
+	CancelAutosave();
+
+	const uint64 Generation = ConfigGeneration;
+	if (bHasQueuedGeneration && QueuedGeneration == Generation && !bLastSaveFailed)
+	{
+		UE_LOG(LogInputStreamliner, Verbose, TEXT("Configuration unchanged, skipping save"));
+		if (bWaitForWrite)
+		{
+			WaitForPendingSave();
+			return !bLastSaveFailed;
+		}
+		return true;
+	}
+
+	QueuedGeneration = Generation;
+	bHasQueuedGeneration = true;
+	bLastSaveFailed = false;
+
+	// Only the copy happens on the game thread; serialization and file I/O run on the task
+	const FString ConfigPath = GetConfigurationFilePath();
+	auto WriteFile = [this, Snapshot = CurrentConfig, Generation, ConfigPath]()
+	{
+		// A newer snapshot is queued behind this one
+		if (Generation != QueuedGeneration)
+		{
+			return;
+		}
+
+		INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_WriteConfiguration);
+		FInputStreamlinerMetrics::FScopedTimer WriteTimer(TEXT("Config.WriteMs"));
+
+		bool bSuccess = false;
+		FString JsonString;
+		if (!FJsonObjectConverter::UStructToJsonObjectString(Snapshot, JsonString))
+		{
+			UE_LOG(LogInputStreamliner, Error, TEXT("Failed to serialize configuration to JSON"));
+			bLastSaveFailed = true;
+		}
+		else if (!FInputStreamlinerFileUtils::SaveStringAtomically(JsonString, ConfigPath))
+		{
+			UE_LOG(LogInputStreamliner, Error, TEXT("Failed to save configuration to: %s"), *ConfigPath);
+			bLastSaveFailed = true;
+		}
+		else
+		{
+			UE_LOG(LogInputStreamliner, Log, TEXT("Configuration saved to: %s"), *ConfigPath);
+			bSuccess = true;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UInputStreamlinerManager>(this), bSuccess]()
+		{
+			if (UInputStreamlinerManager* Manager = WeakThis.Get())
+			{
+				Manager->OnConfigurationSaved.Broadcast(bSuccess);
+			}
+		});
+	};
+
+	// Writes are chained so an older snapshot can never land after a newer one
+	PendingSaveTask = PendingSaveTask.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteFile), UE::Tasks::Prerequisites(PendingSaveTask))
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteFile));
 
-	// Ensure directory exists
-	FString Directory = FPaths::GetPath(ConfigPath);
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*Directory))
+	if (bWaitForWrite)
 	{
-		PlatformFile.CreateDirectoryTree(*Directory);
+		WaitForPendingSave();
+		return !bLastSaveFailed;
 	}
+	return true;
+}
 
-	// Convert to JSON
-	FString JsonString;
-	if (!FJsonObjectConverter::UStructToJsonObjectString(CurrentConfig, JsonString))
+void UInputStreamlinerManager::FlushAutosave()
+{
+	if (AutosaveHandle.IsValid())
 	{
-		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to serialize configuration to JSON"));
-		return false;
+		SaveConfiguration();
 	}
+}
 
-	// Write to file
-	if (!FFileHelper::SaveStringToFile(JsonString, *ConfigPath))
+void UInputStreamlinerManager::WaitForPendingSave()
+{
+	if (PendingSaveTask.IsValid())
 	{
-		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to save configuration to: %s"), *ConfigPath);
-		return false;
+		PendingSaveTask.Wait();
+		PendingSaveTask = UE::Tasks::FTask();
 	}
+}
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Configuration saved to: %s"), *ConfigPath);
-	return true;
+void UInputStreamlinerManager::ScheduleAutosave()
+{
+	const float Delay = CVarConfigAutosaveDelay.GetValueOnGameThread();
+	if (Delay < 0.0f)
+	{
+		return;
+	}
+
+	// Restart the delay so a burst of edits (dragging a touch control) is written once
+	CancelAutosave();
+	AutosaveHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UInputStreamlinerManager::HandleAutosave), Delay);
+}
+
+void UInputStreamlinerManager::CancelAutosave()
+{
+	if (AutosaveHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AutosaveHandle);
+		AutosaveHandle.Reset();
+	}
+}
+
+bool UInputStreamlinerManager::HandleAutosave(float DeltaTime)
+{
+	AutosaveHandle.Reset();
+	SaveConfiguration();
+	return false;
 }
 
 bool UInputStreamlinerManager::LoadConfiguration()
 {
+	// Don't read a file that is still being written
+	WaitForPendingSave();
+
 	FString ConfigPath = GetConfigurationFilePath();
 
 	if (!FPaths::FileExists(ConfigPath))
@@ -358,12 +537,20 @@ bool UInputStreamlinerManager::LoadConfiguration()
 	}
 
 	// Parse JSON
-	if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &CurrentConfig))
+	FString DecodeError;
+	if (!FInputConfigurationDecoder::DecodeConfiguration(JsonString, CurrentConfig, DecodeError))
 	{
-		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to parse configuration JSON"));
+		UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *DecodeError);
 		return false;
 	}
 
+	CurrentConfig.RebuildIndex();
+
+	// The file now matches memory
+	CancelAutosave();
+	QueuedGeneration = ConfigGeneration;
+	bHasQueuedGeneration = true;
+
 	UE_LOG(LogInputStreamliner, Log, TEXT("Configuration loaded from: %s"), *ConfigPath);
 	return true;
 }
@@ -373,8 +560,29 @@ FString UInputStreamlinerManager::GetConfigurationFilePath() const
 	return FPaths::ProjectSavedDir() / TEXT("InputStreamliner") / TEXT("Configuration.json");
 }
 
+void UInputStreamlinerManager::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// Undo replaced the arrays without going through the mutators
+	CurrentConfig.MarkModified();
+	NotifyConfigurationChanged();
+}
+
 void UInputStreamlinerManager::NotifyConfigurationChanged()
 {
+	if (bBatchingChanges)
+	{
+		bChangedDuringBatch = true;
+		return;
+	}
+
+	// Rebuild once per change so lookups during the broadcast and until the next change are O(1)
+	CurrentConfig.RebuildIndex();
+
+	ConfigGeneration++;
+	ScheduleAutosave();
+
 	OnConfigurationChanged.Broadcast();
 }
 
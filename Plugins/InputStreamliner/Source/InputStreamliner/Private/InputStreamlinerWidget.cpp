@@ -3,7 +3,11 @@
 #include "InputStreamlinerWidget.h"
 #include "InputStreamlinerModule.h"
 #include "LLMIntentParser.h"
+#include "LLMResponseCache.h"
 #include "InputAssetGenerator.h"
+#include "InputCodeGenerator.h"
+#include "InputConfigurationDecoder.h"
+#include "InputStreamlinerFileUtils.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "Misc/FileHelper.h"
 #include "JsonObjectConverter.h"
@@ -21,14 +25,27 @@
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
 #include "Blueprint/WidgetTree.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "ObjectTools.h"
+#include "Misc/MessageDialog.h"
 #include "Components/ComboBoxString.h"
-#include "HttpModule.h"
-#include "Interfaces/IHttpResponse.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
+namespace InputStreamlinerWidget
+{
+	/** Short type tag shown next to each action */
+	FText GetActionTypeLabel(EInputActionType Type)
+	{
+		switch (Type)
+		{
+		case EInputActionType::Bool: return FText::FromString(TEXT("[B]"));
+		case EInputActionType::Axis1D: return FText::FromString(TEXT("[1D]"));
+		case EInputActionType::Axis2D: return FText::FromString(TEXT("[2D]"));
+		case EInputActionType::Axis3D: return FText::FromString(TEXT("[3D]"));
+		}
+		return FText::GetEmpty();
+	}
+}
+
 UInputStreamlinerWidget::UInputStreamlinerWidget()
 {
 }
@@ -55,12 +72,17 @@ void UInputStreamlinerWidget::NativeConstruct()
 		CurrentConfiguration.LLMEndpointPort
 	);
 	LLMParser->SetModel(CurrentConfiguration.LLMModelName);
+	LLMParser->SetKeepAlive(CurrentConfiguration.LLMKeepAlive);
+	LLMParser->SetMaxResponseActions(CurrentConfiguration.LLMMaxActions);
+	LLMParser->OnActionParsed.AddDynamic(this, &UInputStreamlinerWidget::HandleLLMActionParsed);
+	LLMParser->OnParseRequestCompleted.AddDynamic(this, &UInputStreamlinerWidget::HandleLLMParseRequestComplete);
 
 	// Build the UI (uses ContentContainer from Blueprint)
 	BuildUI();
 
-	// Fetch available models from Ollama
+	// Fetch available models from Ollama and load the default one so the first parse is fast
 	RefreshModelList();
+	LLMParser->WarmUpModel();
 
 	UE_LOG(LogInputStreamliner, Log, TEXT("InputStreamlinerWidget constructed"));
 }
@@ -90,9 +112,9 @@ void UInputStreamlinerWidget::ParseDescription(const FString& Description)
 
 	UE_LOG(LogInputStreamliner, Log, TEXT("Parsing description: %s"), *Description.Left(100));
 
-	FOnParseComplete Callback;
-	Callback.BindDynamic(this, &UInputStreamlinerWidget::HandleLLMParseComplete);
-	LLMParser->ParseInputDescriptionAsync(Description, Callback);
+	// Completion arrives through OnParseRequestCompleted with the handle, so concurrent requests stay apart
+	const int32 RequestId = LLMParser->SubmitParseRequest(Description, FOnParseComplete());
+	StreamedRowsByRequest.Add(RequestId);
 }
 
 bool UInputStreamlinerWidget::IsParsingInProgress() const
@@ -109,7 +131,7 @@ void UInputStreamlinerWidget::TestLLMConnection()
 	}
 
 	FOnParseComplete Callback;
-	Callback.BindDynamic(this, &UInputStreamlinerWidget::HandleLLMParseComplete);
+	Callback.BindDynamic(this, &UInputStreamlinerWidget::HandleConnectionTestComplete);
 	LLMParser->CheckConnection(Callback);
 }
 
@@ -128,13 +150,23 @@ void UInputStreamlinerWidget::SetLLMEndpoint(const FString& URL, int32 Port, con
 	BroadcastConfigurationUpdate();
 }
 
-void UInputStreamlinerWidget::HandleLLMParseComplete(bool bSuccess, const FString& ErrorMessage)
+void UInputStreamlinerWidget::HandleLLMParseRequestComplete(int32 RequestId, bool bSuccess, const FString& ErrorMessage)
 {
-	if (bSuccess && LLMParser)
+	if (!StreamedRowsByRequest.Contains(RequestId) || !LLMParser)
 	{
-		// Get the parsed configuration and merge/replace
-		const FInputStreamlinerConfiguration& ParsedConfig = LLMParser->GetLastParsedConfiguration();
+		return;
+	}
+
+	RefreshCacheStats();
 
+	FInputStreamlinerConfiguration ParsedConfig;
+	FString ResultError;
+	bSuccess = bSuccess && LLMParser->GetParseResult(RequestId, ParsedConfig, ResultError);
+	const bool bReachedActionLimit = LLMParser->DidReachActionLimit(RequestId);
+	LLMParser->ReleaseParseRequest(RequestId);
+
+	if (bSuccess)
+	{
 		// Add parsed actions to current configuration
 		for (const FInputActionDefinition& Action : ParsedConfig.Actions)
 		{
@@ -142,6 +174,7 @@ void UInputStreamlinerWidget::HandleLLMParseComplete(bool bSuccess, const FStrin
 			if (!CurrentConfiguration.HasAction(Action.ActionName))
 			{
 				CurrentConfiguration.Actions.Add(Action);
+				CurrentConfiguration.MarkModified();
 			}
 		}
 
@@ -149,17 +182,62 @@ void UInputStreamlinerWidget::HandleLLMParseComplete(bool bSuccess, const FStrin
 		for (const FTouchControlDefinition& Control : ParsedConfig.TouchControls)
 		{
 			CurrentConfiguration.TouchControls.Add(Control);
+			CurrentConfiguration.MarkModified();
 		}
 
+		// Streamed actions were only a preview; rows of actions that made it into the result are kept
+		DiscardStreamedRows(RequestId);
 		BroadcastConfigurationUpdate();
 		FString SuccessMsg = FString::Printf(TEXT("Parsed %d actions"), ParsedConfig.Actions.Num());
-		SetStatusText(SuccessMsg, FLinearColor::Green);
+		if (bReachedActionLimit)
+		{
+			SuccessMsg += FString::Printf(TEXT(" (limit of %d reached, some may be missing; raise LLMMaxActions or split the description)"), LLMParser->GetMaxResponseActions());
+		}
+		SetStatusText(SuccessMsg, bReachedActionLimit ? FLinearColor::Yellow : FLinearColor::Green);
 		OnLLMParseComplete.Broadcast(true, SuccessMsg);
 	}
 	else
 	{
-		SetStatusText(FString::Printf(TEXT("Parse failed: %s"), *ErrorMessage), FLinearColor::Red);
-		OnLLMParseComplete.Broadcast(false, ErrorMessage);
+		DiscardStreamedRows(RequestId);
+
+		const FString& Error = ErrorMessage.IsEmpty() ? ResultError : ErrorMessage;
+		SetStatusText(FString::Printf(TEXT("Parse failed: %s"), *Error), FLinearColor::Red);
+		OnLLMParseComplete.Broadcast(false, Error);
+	}
+}
+
+void UInputStreamlinerWidget::HandleLLMActionParsed(int32 RequestId, const FInputActionDefinition& Action)
+{
+	TArray<FName>* StreamedRows = StreamedRowsByRequest.Find(RequestId);
+	if (!StreamedRows)
+	{
+		return;
+	}
+
+	// Show streamed actions immediately, without touching the configuration until the request succeeds
+	if (!CurrentConfiguration.HasAction(Action.ActionName) && !ActionRows.Contains(Action.ActionName))
+	{
+		AddActionRow(Action);
+		StreamedRows->Add(Action.ActionName);
+	}
+
+	SetStatusText(FString::Printf(TEXT("Parsing with AI... (%s)"), *Action.ActionName.ToString()), FLinearColor::White);
+}
+
+void UInputStreamlinerWidget::DiscardStreamedRows(int32 RequestId)
+{
+	TArray<FName> StreamedRows;
+	if (!StreamedRowsByRequest.RemoveAndCopyValue(RequestId, StreamedRows))
+	{
+		return;
+	}
+
+	for (const FName& ActionName : StreamedRows)
+	{
+		if (!CurrentConfiguration.HasAction(ActionName))
+		{
+			RemoveActionRow(ActionName);
+		}
 	}
 }
 
@@ -174,6 +252,7 @@ void UInputStreamlinerWidget::SetConfiguration(const FInputStreamlinerConfigurat
 	{
 		LLMParser->SetEndpoint(CurrentConfiguration.LLMEndpointURL, CurrentConfiguration.LLMEndpointPort);
 		LLMParser->SetModel(CurrentConfiguration.LLMModelName);
+		LLMParser->SetMaxResponseActions(CurrentConfiguration.LLMMaxActions);
 	}
 
 	BroadcastConfigurationUpdate();
@@ -226,7 +305,9 @@ bool UInputStreamlinerWidget::GetActionByName(FName ActionName, FInputActionDefi
 void UInputStreamlinerWidget::AddAction(const FInputActionDefinition& Action)
 {
 	CurrentConfiguration.Actions.Add(Action);
-	BroadcastConfigurationUpdate();
+	CurrentConfiguration.MarkModified();
+	AddActionRow(Action);
+	BroadcastConfigurationUpdate(false);
 	UE_LOG(LogInputStreamliner, Log, TEXT("Added action: %s"), *Action.ActionName.ToString());
 }
 
@@ -236,7 +317,9 @@ bool UInputStreamlinerWidget::UpdateAction(FName ActionName, const FInputActionD
 	if (Found)
 	{
 		*Found = UpdatedAction;
-		BroadcastConfigurationUpdate();
+		CurrentConfiguration.MarkModified();
+		UpdateActionRow(ActionName, UpdatedAction);
+		BroadcastConfigurationUpdate(false);
 		return true;
 	}
 	return false;
@@ -251,7 +334,9 @@ bool UInputStreamlinerWidget::RemoveAction(FName ActionName)
 
 	if (RemovedCount > 0)
 	{
-		BroadcastConfigurationUpdate();
+		CurrentConfiguration.MarkModified();
+		RemoveActionRow(ActionName);
+		BroadcastConfigurationUpdate(false);
 		UE_LOG(LogInputStreamliner, Log, TEXT("Removed action: %s"), *ActionName.ToString());
 		return true;
 	}
@@ -264,6 +349,7 @@ bool UInputStreamlinerWidget::RemoveActionAtIndex(int32 Index)
 	{
 		FName RemovedName = CurrentConfiguration.Actions[Index].ActionName;
 		CurrentConfiguration.Actions.RemoveAt(Index);
+		CurrentConfiguration.MarkModified();
 
 		// Adjust selection if needed
 		if (SelectedActionIndex >= CurrentConfiguration.Actions.Num())
@@ -281,6 +367,7 @@ bool UInputStreamlinerWidget::RemoveActionAtIndex(int32 Index)
 void UInputStreamlinerWidget::ClearAllActions()
 {
 	CurrentConfiguration.Actions.Empty();
+	CurrentConfiguration.MarkModified();
 	SelectedActionIndex = -1;
 	BroadcastConfigurationUpdate();
 	UE_LOG(LogInputStreamliner, Log, TEXT("Cleared all actions"));
@@ -302,7 +389,9 @@ bool UInputStreamlinerWidget::DuplicateAction(FName ActionName, FName NewName)
 	FInputActionDefinition Duplicate = *Source;
 	Duplicate.ActionName = NewName;
 	CurrentConfiguration.Actions.Add(Duplicate);
-	BroadcastConfigurationUpdate();
+	CurrentConfiguration.MarkModified();
+	AddActionRow(Duplicate);
+	BroadcastConfigurationUpdate(false);
 	return true;
 }
 
@@ -316,6 +405,7 @@ TArray<FInputActionDefinition> UInputStreamlinerWidget::GetActionsInCategory(con
 void UInputStreamlinerWidget::AddTouchControl(const FTouchControlDefinition& Control)
 {
 	CurrentConfiguration.TouchControls.Add(Control);
+	CurrentConfiguration.MarkModified();
 	BroadcastConfigurationUpdate();
 }
 
@@ -328,6 +418,7 @@ bool UInputStreamlinerWidget::RemoveTouchControl(FName ControlName)
 
 	if (RemovedCount > 0)
 	{
+		CurrentConfiguration.MarkModified();
 		BroadcastConfigurationUpdate();
 		return true;
 	}
@@ -336,21 +427,23 @@ bool UInputStreamlinerWidget::RemoveTouchControl(FName ControlName)
 
 bool UInputStreamlinerWidget::UpdateTouchControl(FName ControlName, const FTouchControlDefinition& UpdatedControl)
 {
-	for (FTouchControlDefinition& Control : CurrentConfiguration.TouchControls)
+	const int32 ControlIndex = CurrentConfiguration.FindTouchControlIndex(ControlName);
+	if (ControlIndex == INDEX_NONE)
 	{
-		if (Control.ControlName == ControlName)
-		{
-			Control = UpdatedControl;
-			BroadcastConfigurationUpdate();
-			return true;
-		}
+		return false;
 	}
-	return false;
+
+	// May rename the control, so the lookup index has to be rebuilt like any other edit
+	CurrentConfiguration.TouchControls[ControlIndex] = UpdatedControl;
+	CurrentConfiguration.MarkModified();
+	BroadcastConfigurationUpdate();
+	return true;
 }
 
 void UInputStreamlinerWidget::SetGyroConfiguration(const FGyroConfiguration& Config)
 {
 	CurrentConfiguration.GyroConfig = Config;
+	CurrentConfiguration.MarkModified();
 	BroadcastConfigurationUpdate();
 }
 
@@ -381,7 +474,8 @@ void UInputStreamlinerWidget::GenerateAssets()
 
 	if (bSuccess)
 	{
-		FString SuccessMsg = FString::Printf(TEXT("Generated %d assets successfully"), CreatedAssets.Num());
+		FString SuccessMsg = FString::Printf(TEXT("Generated %d assets successfully (%d unchanged)"),
+			CreatedAssets.Num(), AssetGenerator->GetLastUnchangedCount());
 		SetStatusText(SuccessMsg, FLinearColor::Green);
 		OnGenerationComplete.Broadcast(true, SuccessMsg);
 	}
@@ -473,6 +567,12 @@ TArray<FString> UInputStreamlinerWidget::PreviewGeneration() const
 		Paths.Add(FString::Printf(TEXT("%s/IMC_Mac"), *CurrentConfiguration.MappingContextsPath));
 	}
 
+	// C++ action table
+	if (CurrentConfiguration.CodeGenType != ECodeGenerationType::Blueprint)
+	{
+		Paths.Add(FInputCodeGenerator::GetActionTableHeaderPath(CurrentConfiguration));
+	}
+
 	return Paths;
 }
 
@@ -483,7 +583,7 @@ bool UInputStreamlinerWidget::SaveConfiguration(const FString& FilePath)
 	FString JsonString;
 	if (FJsonObjectConverter::UStructToJsonObjectString(CurrentConfiguration, JsonString))
 	{
-		if (FFileHelper::SaveStringToFile(JsonString, *FilePath))
+		if (FInputStreamlinerFileUtils::SaveStringAtomically(JsonString, FilePath))
 		{
 			UE_LOG(LogInputStreamliner, Log, TEXT("Configuration saved to: %s"), *FilePath);
 			return true;
@@ -500,7 +600,8 @@ bool UInputStreamlinerWidget::LoadConfiguration(const FString& FilePath)
 	if (FFileHelper::LoadFileToString(JsonString, *FilePath))
 	{
 		FInputStreamlinerConfiguration LoadedConfig;
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &LoadedConfig))
+		FString DecodeError;
+		if (FInputConfigurationDecoder::DecodeConfiguration(JsonString, LoadedConfig, DecodeError))
 		{
 			SetConfiguration(LoadedConfig);
 			UE_LOG(LogInputStreamliner, Log, TEXT("Configuration loaded from: %s"), *FilePath);
@@ -538,13 +639,15 @@ bool UInputStreamlinerWidget::ImportFromClipboard()
 	}
 
 	FInputStreamlinerConfiguration LoadedConfig;
-	if (FJsonObjectConverter::JsonObjectStringToUStruct(ClipboardContent, &LoadedConfig))
+	FString DecodeError;
+	if (FInputConfigurationDecoder::DecodeConfiguration(ClipboardContent, LoadedConfig, DecodeError))
 	{
 		SetConfiguration(LoadedConfig);
 		UE_LOG(LogInputStreamliner, Log, TEXT("Configuration imported from clipboard"));
 		return true;
 	}
 
+	UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to import configuration from clipboard: %s"), *DecodeError);
 	return false;
 }
 
@@ -598,15 +701,8 @@ bool UInputStreamlinerWidget::IsValidActionName(FName ActionName, FName ExcludeN
 		return false;
 	}
 
-	for (const FInputActionDefinition& Action : CurrentConfiguration.Actions)
-	{
-		if (Action.ActionName == ActionName && Action.ActionName != ExcludeName)
-		{
-			return false; // Name already exists
-		}
-	}
-
-	return true;
+	// Name already exists
+	return ActionName == ExcludeName || !CurrentConfiguration.HasAction(ActionName);
 }
 
 // ==================== UI State ====================
@@ -629,10 +725,15 @@ bool UInputStreamlinerWidget::GetSelectedAction(FInputActionDefinition& OutActio
 	return GetActionAtIndex(SelectedActionIndex, OutAction);
 }
 
-void UInputStreamlinerWidget::BroadcastConfigurationUpdate()
+void UInputStreamlinerWidget::BroadcastConfigurationUpdate(bool bRefreshActionsList)
 {
+	CurrentConfiguration.RebuildIndex();
+
 	OnConfigurationUpdated.Broadcast(CurrentConfiguration);
-	RefreshActionsList();
+	if (bRefreshActionsList)
+	{
+		RefreshActionsList();
+	}
 }
 
 // ==================== UI Building ====================
@@ -796,6 +897,19 @@ void UInputStreamlinerWidget::BuildUI()
 	ActionsListBox = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("ActionsListBox"));
 	ActionsScrollBox->AddChild(ActionsListBox);
 
+	// Rows are created per action and reuse this font rather than copying and resizing their own
+	ActionRowFont = ActionsFont;
+
+	EmptyActionsText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("EmptyActionsText"));
+	EmptyActionsText->SetText(FText::FromString(TEXT("No actions. Parse or add manually.")));
+	EmptyActionsText->SetFont(ActionRowFont);
+	EmptyActionsText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
+	ActionsScrollBox->AddChild(EmptyActionsText);
+
+	ActionRows.Reset();
+	ActionRowOrder.Reset();
+	RefreshActionsList();
+
 	// ===== Generate/Delete Buttons Row =====
 	UHorizontalBox* GenRow = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass(), TEXT("GenRow"));
 	UVerticalBoxSlot* GenRowSlot = RootBox->AddChildToVerticalBox(GenRow);
@@ -838,6 +952,16 @@ void UInputStreamlinerWidget::BuildUI()
 	UVerticalBoxSlot* StatusSlot = RootBox->AddChildToVerticalBox(StatusText);
 	StatusSlot->SetPadding(FMargin(Pad, Pad));
 
+	// ===== LLM Cache Stats =====
+	CacheStatsText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("CacheStatsText"));
+	FSlateFontInfo CacheFont = CacheStatsText->GetFont();
+	CacheFont.Size = FontSize;
+	CacheStatsText->SetFont(CacheFont);
+	CacheStatsText->SetColorAndOpacity(FSlateColor(FLinearColor(0.6f, 0.6f, 0.6f)));
+	UVerticalBoxSlot* CacheSlot = RootBox->AddChildToVerticalBox(CacheStatsText);
+	CacheSlot->SetPadding(FMargin(Pad, 0.f, Pad, Pad));
+	RefreshCacheStats();
+
 	UE_LOG(LogInputStreamliner, Log, TEXT("UI built successfully"));
 }
 
@@ -848,57 +972,187 @@ void UInputStreamlinerWidget::RefreshActionsList()
 		return;
 	}
 
-	const int32 FontSize = 8;
-	ActionsListBox->ClearChildren();
-
-	for (int32 i = 0; i < CurrentConfiguration.Actions.Num(); i++)
-	{
-		const FInputActionDefinition& Action = CurrentConfiguration.Actions[i];
-
-		UHorizontalBox* ActionRow = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass());
-		UVerticalBoxSlot* RowSlot = ActionsListBox->AddChildToVerticalBox(ActionRow);
-		RowSlot->SetPadding(FMargin(0.f, 1.f));
-
-		// Action name
-		UTextBlock* NameText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
-		NameText->SetText(FText::FromName(Action.ActionName));
-		FSlateFontInfo NameFont = NameText->GetFont();
-		NameFont.Size = FontSize;
-		NameText->SetFont(NameFont);
-		UHorizontalBoxSlot* NameSlot = ActionRow->AddChildToHorizontalBox(NameText);
-		NameSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
-		NameSlot->SetVerticalAlignment(VAlign_Center);
-
-		// Action type
-		UTextBlock* TypeText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
-		FString TypeString;
-		switch (Action.ActionType)
+	const TArray<FInputActionDefinition>& Actions = CurrentConfiguration.Actions;
+	if (Actions.Num() == 0)
+	{
+		ActionsListBox->ClearChildren();
+		ActionRows.Reset();
+		ActionRowOrder.Reset();
+		UpdateEmptyActionsText();
+		return;
+	}
+
+	TSet<FName> ActionNames;
+	ActionNames.Reserve(Actions.Num());
+	for (const FInputActionDefinition& Action : Actions)
+	{
+		ActionNames.Add(Action.ActionName);
+	}
+
+	// Drop rows of actions that are gone
+	for (int32 i = ActionRowOrder.Num() - 1; i >= 0; i--)
+	{
+		if (!ActionNames.Contains(ActionRowOrder[i]))
 		{
-		case EInputActionType::Bool: TypeString = TEXT("[B]"); break;
-		case EInputActionType::Axis1D: TypeString = TEXT("[1D]"); break;
-		case EInputActionType::Axis2D: TypeString = TEXT("[2D]"); break;
-		case EInputActionType::Axis3D: TypeString = TEXT("[3D]"); break;
+			RemoveActionRow(ActionRowOrder[i]);
 		}
-		TypeText->SetText(FText::FromString(TypeString));
-		FSlateFontInfo TypeFont = TypeText->GetFont();
-		TypeFont.Size = FontSize;
-		TypeText->SetFont(TypeFont);
-		TypeText->SetColorAndOpacity(FSlateColor(FLinearColor(0.7f, 0.7f, 0.7f)));
-		UHorizontalBoxSlot* TypeSlot = ActionRow->AddChildToHorizontalBox(TypeText);
-		TypeSlot->SetPadding(FMargin(4.f, 0.f));
-		TypeSlot->SetVerticalAlignment(VAlign_Center);
 	}
 
-	if (CurrentConfiguration.Actions.Num() == 0)
+	// Update the remaining rows and create the missing ones; new rows go to the end
+	bool bOrderChanged = false;
+	for (int32 i = 0; i < Actions.Num(); i++)
+	{
+		const FInputActionDefinition& Action = Actions[i];
+		if (ActionRows.Contains(Action.ActionName))
+		{
+			UpdateActionRow(Action.ActionName, Action);
+		}
+		else
+		{
+			AddActionRow(Action);
+		}
+
+		bOrderChanged |= !ActionRowOrder.IsValidIndex(i) || ActionRowOrder[i] != Action.ActionName;
+	}
+
+	if (bOrderChanged)
+	{
+		// Re-slot the existing rows in configuration order without constructing any widgets
+		ActionsListBox->ClearChildren();
+		ActionRowOrder.Reset();
+		for (const FInputActionDefinition& Action : Actions)
+		{
+			if (ActionRowOrder.Contains(Action.ActionName))
+			{
+				continue;
+			}
+
+			UVerticalBoxSlot* RowSlot = ActionsListBox->AddChildToVerticalBox(ActionRows.FindChecked(Action.ActionName).Row);
+			RowSlot->SetPadding(FMargin(0.f, 1.f));
+			ActionRowOrder.Add(Action.ActionName);
+		}
+	}
+
+	UpdateEmptyActionsText();
+}
+
+void UInputStreamlinerWidget::AddActionRow(const FInputActionDefinition& Action)
+{
+	if (!ActionsListBox || !WidgetTree || ActionRows.Contains(Action.ActionName))
 	{
-		UTextBlock* EmptyText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
-		EmptyText->SetText(FText::FromString(TEXT("No actions. Parse or add manually.")));
-		FSlateFontInfo EmptyFont = EmptyText->GetFont();
-		EmptyFont.Size = FontSize;
-		EmptyText->SetFont(EmptyFont);
-		EmptyText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
-		ActionsListBox->AddChildToVerticalBox(EmptyText);
+		return;
 	}
+
+	FInputStreamlinerActionRow& ActionRow = ActionRows.Add(Action.ActionName);
+	ActionRow.ActionName = Action.ActionName;
+	ActionRow.ActionType = Action.ActionType;
+
+	ActionRow.Row = WidgetTree->ConstructWidget<UHorizontalBox>(UHorizontalBox::StaticClass());
+	UVerticalBoxSlot* RowSlot = ActionsListBox->AddChildToVerticalBox(ActionRow.Row);
+	RowSlot->SetPadding(FMargin(0.f, 1.f));
+
+	// Action name
+	ActionRow.NameText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
+	ActionRow.NameText->SetText(FText::FromName(Action.ActionName));
+	ActionRow.NameText->SetFont(ActionRowFont);
+	UHorizontalBoxSlot* NameSlot = ActionRow.Row->AddChildToHorizontalBox(ActionRow.NameText);
+	NameSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
+	NameSlot->SetVerticalAlignment(VAlign_Center);
+
+	// Action type
+	ActionRow.TypeText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass());
+	ActionRow.TypeText->SetText(InputStreamlinerWidget::GetActionTypeLabel(Action.ActionType));
+	ActionRow.TypeText->SetFont(ActionRowFont);
+	ActionRow.TypeText->SetColorAndOpacity(FSlateColor(FLinearColor(0.7f, 0.7f, 0.7f)));
+	UHorizontalBoxSlot* TypeSlot = ActionRow.Row->AddChildToHorizontalBox(ActionRow.TypeText);
+	TypeSlot->SetPadding(FMargin(4.f, 0.f));
+	TypeSlot->SetVerticalAlignment(VAlign_Center);
+
+	ActionRowOrder.Add(Action.ActionName);
+	UpdateEmptyActionsText();
+}
+
+void UInputStreamlinerWidget::UpdateActionRow(FName ActionName, const FInputActionDefinition& Action)
+{
+	if (ActionName != Action.ActionName)
+	{
+		// Renamed: move the row to its new key, unless another row already owns that name
+		FInputStreamlinerActionRow RenamedRow;
+		if (ActionRows.Contains(Action.ActionName))
+		{
+			RemoveActionRow(ActionName);
+		}
+		else if (ActionRows.RemoveAndCopyValue(ActionName, RenamedRow))
+		{
+			ActionRows.Add(Action.ActionName, RenamedRow);
+			const int32 OrderIndex = ActionRowOrder.IndexOfByKey(ActionName);
+			if (OrderIndex != INDEX_NONE)
+			{
+				ActionRowOrder[OrderIndex] = Action.ActionName;
+			}
+		}
+	}
+
+	FInputStreamlinerActionRow* ActionRow = ActionRows.Find(Action.ActionName);
+	if (!ActionRow)
+	{
+		AddActionRow(Action);
+		return;
+	}
+
+	if (ActionRow->ActionName != Action.ActionName)
+	{
+		ActionRow->ActionName = Action.ActionName;
+		ActionRow->NameText->SetText(FText::FromName(Action.ActionName));
+	}
+
+	if (ActionRow->ActionType != Action.ActionType)
+	{
+		ActionRow->ActionType = Action.ActionType;
+		ActionRow->TypeText->SetText(InputStreamlinerWidget::GetActionTypeLabel(Action.ActionType));
+	}
+}
+
+void UInputStreamlinerWidget::RemoveActionRow(FName ActionName)
+{
+	FInputStreamlinerActionRow ActionRow;
+	if (!ActionRows.RemoveAndCopyValue(ActionName, ActionRow))
+	{
+		return;
+	}
+
+	if (ActionsListBox && ActionRow.Row)
+	{
+		ActionsListBox->RemoveChild(ActionRow.Row);
+	}
+	ActionRowOrder.Remove(ActionName);
+	UpdateEmptyActionsText();
+}
+
+void UInputStreamlinerWidget::UpdateEmptyActionsText()
+{
+	if (EmptyActionsText)
+	{
+		EmptyActionsText->SetVisibility(ActionRows.Num() == 0 ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
+
+void UInputStreamlinerWidget::RefreshCacheStats()
+{
+	if (!CacheStatsText)
+	{
+		return;
+	}
+
+	ULLMResponseCache* Cache = LLMParser ? LLMParser->GetResponseCache() : nullptr;
+	if (!Cache)
+	{
+		CacheStatsText->SetText(FText::GetEmpty());
+		return;
+	}
+
+	CacheStatsText->SetText(FText::FromString(FString::Printf(TEXT("LLM cache: %d hits / %d misses (%d entries)"),
+		Cache->GetHitCount(), Cache->GetMissCount(), Cache->GetNumEntries())));
 }
 
 void UInputStreamlinerWidget::SetStatusText(const FString& Text, FLinearColor Color)
@@ -940,7 +1194,13 @@ void UInputStreamlinerWidget::OnAddActionButtonClicked()
 {
 	// Create a default action
 	FInputActionDefinition NewAction;
-	NewAction.ActionName = FName(*FString::Printf(TEXT("NewAction_%d"), CurrentConfiguration.Actions.Num()));
+	// Rows are keyed by name, so never reuse one that is already taken
+	int32 Suffix = CurrentConfiguration.Actions.Num();
+	do
+	{
+		NewAction.ActionName = FName(*FString::Printf(TEXT("NewAction_%d"), Suffix++));
+	}
+	while (CurrentConfiguration.HasAction(NewAction.ActionName));
 	NewAction.ActionType = EInputActionType::Bool;
 	NewAction.Category = TEXT("General");
 	NewAction.DisplayName = TEXT("New Action");
@@ -996,56 +1256,19 @@ void UInputStreamlinerWidget::OnClearAllButtonClicked()
 
 void UInputStreamlinerWidget::OnDeleteGeneratedAssetsClicked()
 {
-	TArray<FString> AssetPaths = PreviewGeneration();
-
-	if (AssetPaths.Num() == 0)
+	if (!AssetGenerator)
 	{
-		SetStatusText(TEXT("No assets defined"), FLinearColor::Yellow);
+		SetStatusText(TEXT("Asset Generator not initialized"), FLinearColor::Red);
 		return;
 	}
 
-	int32 DeletedCount = 0;
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	TArray<UObject*> AssetsToDelete;
-
-	for (const FString& AssetPath : AssetPaths)
-	{
-		// Try to find asset by package path
-		FString PackagePath = AssetPath;
-
-		// Get asset name from path
-		FString AssetName = FPackageName::GetLongPackageAssetName(PackagePath);
-
-		// Search for the asset
-		FARFilter Filter;
-		Filter.PackagePaths.Add(FName(*FPackageName::GetLongPackagePath(PackagePath)));
-		Filter.bRecursivePaths = false;
-
-		TArray<FAssetData> FoundAssets;
-		AssetRegistry.GetAssets(Filter, FoundAssets);
-
-		for (const FAssetData& AssetData : FoundAssets)
-		{
-			if (AssetData.AssetName.ToString() == AssetName)
-			{
-				UObject* Asset = AssetData.GetAsset();
-				if (Asset)
-				{
-					AssetsToDelete.Add(Asset);
-					UE_LOG(LogInputStreamliner, Log, TEXT("Found asset to delete: %s"), *AssetData.GetObjectPathString());
-				}
-			}
-		}
-	}
-
-	if (AssetsToDelete.Num() > 0)
+	const FText Prompt = NSLOCTEXT("InputStreamliner", "ConfirmDeleteGenerated", "Delete every input asset recorded by the last generation?");
+	if (FMessageDialog::Open(EAppMsgType::YesNo, Prompt) != EAppReturnType::Yes)
 	{
-		// Delete all found assets at once
-		DeletedCount = ObjectTools::DeleteObjects(AssetsToDelete, true);
+		return;
 	}
 
+	const int32 DeletedCount = AssetGenerator->CleanupGeneratedAssets();
 	if (DeletedCount > 0)
 	{
 		SetStatusText(FString::Printf(TEXT("Deleted %d assets"), DeletedCount), FLinearColor::Green);
@@ -1068,6 +1291,7 @@ void UInputStreamlinerWidget::OnModelSelectionChanged(FString SelectedItem, ESel
 	if (LLMParser)
 	{
 		LLMParser->SetModel(SelectedItem);
+		LLMParser->WarmUpModel();
 	}
 
 	SetStatusText(FString::Printf(TEXT("Model: %s"), *SelectedItem), FLinearColor::White);
@@ -1076,44 +1300,26 @@ void UInputStreamlinerWidget::OnModelSelectionChanged(FString SelectedItem, ESel
 
 void UInputStreamlinerWidget::RefreshModelList()
 {
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
-
-	Request->SetURL(FString::Printf(TEXT("%s:%d/api/tags"),
-		*CurrentConfiguration.LLMEndpointURL,
-		CurrentConfiguration.LLMEndpointPort));
-	Request->SetVerb(TEXT("GET"));
-	Request->SetTimeout(5.0f);
-
-	Request->OnProcessRequestComplete().BindUObject(this, &UInputStreamlinerWidget::OnModelListReceived);
-	Request->ProcessRequest();
-}
-
-void UInputStreamlinerWidget::OnModelListReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
-{
-	if (!ModelDropdown)
-	{
-		return;
-	}
-
-	if (!bWasSuccessful || !Response.IsValid() || Response->GetResponseCode() != 200)
+	if (!LLMParser)
 	{
-		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to fetch model list from Ollama"));
 		return;
 	}
 
-	// Parse response JSON
-	TSharedPtr<FJsonObject> JsonResponse;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+	FOnModelListReceived Callback;
+	Callback.BindDynamic(this, &UInputStreamlinerWidget::HandleModelListReceived);
+	LLMParser->FetchAvailableModels(Callback);
+}
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonResponse))
+void UInputStreamlinerWidget::HandleModelListReceived(bool bSuccess, const TArray<FString>& Models, const FString& ErrorMessage)
+{
+	if (!ModelDropdown)
 	{
 		return;
 	}
 
-	// Get models array
-	const TArray<TSharedPtr<FJsonValue>>* ModelsArray;
-	if (!JsonResponse->TryGetArrayField(TEXT("models"), ModelsArray))
+	if (!bSuccess)
 	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to fetch model list from Ollama: %s"), *ErrorMessage);
 		return;
 	}
 
@@ -1123,17 +1329,9 @@ void UInputStreamlinerWidget::OnModelListReceived(FHttpRequestPtr Request, FHttp
 	// Clear and repopulate
 	ModelDropdown->ClearOptions();
 
-	for (const TSharedPtr<FJsonValue>& ModelValue : *ModelsArray)
+	for (const FString& ModelName : Models)
 	{
-		TSharedPtr<FJsonObject> ModelObj = ModelValue->AsObject();
-		if (ModelObj.IsValid())
-		{
-			FString ModelName = ModelObj->GetStringField(TEXT("name"));
-			if (!ModelName.IsEmpty())
-			{
-				ModelDropdown->AddOption(ModelName);
-			}
-		}
+		ModelDropdown->AddOption(ModelName);
 	}
 
 	// Restore selection or use config default
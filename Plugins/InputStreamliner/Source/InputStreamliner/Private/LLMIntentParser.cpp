@@ -1,148 +1,1405 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "LLMIntentParser.h"
+#include "LLMResponseCache.h"
+#include "InputIntentMatcher.h"
+#include "InputConfigurationDecoder.h"
 #include "InputStreamlinerModule.h"
+#include "InputStreamlinerMetrics.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Containers/Ticker.h"
+
+namespace LLMSchema
+{
+	/** Maximum number of operations a single refinement patch may contain */
+	constexpr int32 MaxPatchOperations = 8;
+}
+
+/**
+ * Incremental state for a streamed Ollama response.
+ * Splits the NDJSON body into chunks, accumulates the generated text and tracks
+ * brace depth so each element of the "actions" array can be decoded as soon as it closes.
+ */
+struct FLLMStreamState
+{
+	/** Byte offset of the first NDJSON byte not yet split into a line */
+	int32 LineStart = 0;
+
+	/** Generated text accumulated from the "response" field of each chunk */
+	FString ResponseText;
+
+	/** Index of the next character of ResponseText to scan */
+	int32 ScanIndex = 0;
+
+	/** Current nesting depth of objects and arrays */
+	int32 Depth = 0;
+
+	bool bInString = false;
+	bool bEscaped = false;
+
+	/** Start of the string currently being read */
+	int32 StringStart = INDEX_NONE;
+
+	/** Last string completed at the root object level (used to find the "actions" key) */
+	FString LastRootString;
+
+	/** Depth inside the actions array, or INDEX_NONE if not inside it */
+	int32 ActionsDepth = INDEX_NONE;
+
+	/** Whether the actions array has already been closed */
+	bool bActionsClosed = false;
+
+	/** Start index of the action object currently being read */
+	int32 ElementStart = INDEX_NONE;
+
+	/** Time the first generated token arrived, or 0 if none yet */
+	double FirstTokenTime = 0.0;
+
+	/** The final chunk ("done": true), which carries Ollama's timing metrics */
+	TSharedPtr<FJsonObject> FinalChunk;
+
+	/** Scan newly appended text and collect every action object that has been closed */
+	void ScanForCompletedActions(TArray<FString>& OutActionJSON)
+	{
+		for (; ScanIndex < ResponseText.Len(); ScanIndex++)
+		{
+			const TCHAR c = ResponseText[ScanIndex];
+
+			if (bInString)
+			{
+				if (bEscaped)
+				{
+					bEscaped = false;
+				}
+				else if (c == TEXT('\\'))
+				{
+					bEscaped = true;
+				}
+				else if (c == TEXT('"'))
+				{
+					bInString = false;
+					if (Depth == 1)
+					{
+						LastRootString = ResponseText.Mid(StringStart, ScanIndex - StringStart);
+					}
+				}
+				continue;
+			}
+
+			switch (c)
+			{
+			case TEXT('"'):
+				bInString = true;
+				StringStart = ScanIndex + 1;
+				break;
+			case TEXT('{'):
+				if (ActionsDepth != INDEX_NONE && Depth == ActionsDepth && ElementStart == INDEX_NONE)
+				{
+					ElementStart = ScanIndex;
+				}
+				Depth++;
+				break;
+			case TEXT('['):
+				Depth++;
+				if (!bActionsClosed && ActionsDepth == INDEX_NONE && Depth == 2 && LastRootString == TEXT("actions"))
+				{
+					ActionsDepth = Depth;
+				}
+				break;
+			case TEXT('}'):
+				Depth--;
+				if (ElementStart != INDEX_NONE && Depth == ActionsDepth)
+				{
+					OutActionJSON.Add(ResponseText.Mid(ElementStart, ScanIndex - ElementStart + 1));
+					ElementStart = INDEX_NONE;
+				}
+				break;
+			case TEXT(']'):
+				if (Depth == ActionsDepth)
+				{
+					ActionsDepth = INDEX_NONE;
+					bActionsClosed = true;
+				}
+				Depth--;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+};
+
+/**
+ * A single queued parse request and its result
+ */
+struct FLLMParseRequest
+{
+	int32 Id = 0;
+
+	int32 Priority = 0;
+
+	FString Description;
+
+	FString CacheKey;
+
+	/** Action limit the schema was built with */
+	int32 MaxActions = 0;
+
+	/** The result filled the action or patch operation limit */
+	bool bReachedActionLimit = false;
+
+	FOnParseComplete Callback;
+
+	ELLMParseRequestState State = ELLMParseRequestState::Queued;
+
+	/** Keep the request around after completion so GetParseResult can be called */
+	bool bRetainResult = true;
+
+	FInputStreamlinerConfiguration Result;
+
+	FString ErrorMessage;
+
+	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+
+	/** Time the request was sent */
+	double SendTime = 0.0;
+
+	/** Incremental state of the streamed response, if streaming */
+	TSharedPtr<FLLMStreamState> Stream;
+
+	/** Closest template, used if the LLM cannot be reached */
+	FInputStreamlinerConfiguration LocalMatch;
+
+	float LocalMatchConfidence = 0.0f;
+
+	/** The request asks for a patch against BaseConfig instead of a full configuration */
+	bool bRefinement = false;
+
+	FInputStreamlinerConfiguration BaseConfig;
+
+	FInputConfigurationPatch Patch;
+
+	/** Background refinement of this request's local match, if one is pending */
+	int32 RefinementRequestId = INDEX_NONE;
+
+	/** Locally matched request whose result this background refinement replaces */
+	int32 RefinedRequestId = INDEX_NONE;
+};
+
+/** Get the generated text of an Ollama response object (/api/generate or /api/chat) */
+static bool GetGeneratedText(const FJsonObject& ResponseObj, FString& OutText)
+{
+	if (ResponseObj.TryGetStringField(TEXT("response"), OutText))
+	{
+		return true;
+	}
+
+	const TSharedPtr<FJsonObject>* MessageObj;
+	return ResponseObj.TryGetObjectField(TEXT("message"), MessageObj) && (*MessageObj)->TryGetStringField(TEXT("content"), OutText);
+}
+
+/** Log and record round trip, time-to-first-token and Ollama's evaluation metrics for a completed request */
+static void LogResponseTimings(int32 RequestId, const TCHAR* Mode, double SendTime, double FirstTokenTime, const TSharedPtr<FJsonObject>& FinalObj)
+{
+	const double NsToMs = 1.0 / 1000000.0;
+
+	double LoadNs = 0.0, PromptEvalNs = 0.0, EvalNs = 0.0;
+	int32 PromptTokens = 0, EvalTokens = 0;
+	if (FinalObj.IsValid())
+	{
+		FinalObj->TryGetNumberField(TEXT("load_duration"), LoadNs);
+		FinalObj->TryGetNumberField(TEXT("prompt_eval_duration"), PromptEvalNs);
+		FinalObj->TryGetNumberField(TEXT("eval_duration"), EvalNs);
+		FinalObj->TryGetNumberField(TEXT("prompt_eval_count"), PromptTokens);
+		FinalObj->TryGetNumberField(TEXT("eval_count"), EvalTokens);
+	}
+
+	const double TTFTMs = FirstTokenTime > 0.0 ? (FirstTokenTime - SendTime) * 1000.0 : -1.0;
+	const double RoundTripMs = (FPlatformTime::Seconds() - SendTime) * 1000.0;
+	const double TokensPerSecond = EvalNs > 0.0 ? EvalTokens / (EvalNs / 1000000000.0) : 0.0;
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("LLM request %d (%s): round trip %.0f ms, TTFT %.0f ms, load %.0f ms, prompt eval %d tokens in %.0f ms, generated %d tokens in %.0f ms (%.1f tokens/s)"),
+		RequestId, Mode, RoundTripMs, TTFTMs, LoadNs * NsToMs, PromptTokens, PromptEvalNs * NsToMs, EvalTokens, EvalNs * NsToMs, TokensPerSecond);
+
+	FInputStreamlinerMetrics::Record(TEXT("LLM.RoundTripMs"), RoundTripMs);
+	if (TTFTMs >= 0.0)
+	{
+		FInputStreamlinerMetrics::Record(TEXT("LLM.TimeToFirstTokenMs"), TTFTMs);
+	}
+	if (TokensPerSecond > 0.0)
+	{
+		FInputStreamlinerMetrics::Record(TEXT("LLM.TokensPerSecond"), TokensPerSecond);
+		FInputStreamlinerMetrics::Record(TEXT("LLM.PromptTokens"), PromptTokens);
+		FInputStreamlinerMetrics::Record(TEXT("LLM.GeneratedTokens"), EvalTokens);
+	}
+}
 
 ULLMIntentParser::ULLMIntentParser()
 {
+	ResponseCache = CreateDefaultSubobject<ULLMResponseCache>(TEXT("ResponseCache"));
+	IntentMatcher = CreateDefaultSubobject<UInputIntentMatcher>(TEXT("IntentMatcher"));
+}
+
+UInputIntentMatcher* ULLMIntentParser::GetIntentMatcher()
+{
+	EnsureIntentTemplates();
+	return IntentMatcher;
+}
+
+void ULLMIntentParser::EnsureIntentTemplates()
+{
+	if (bIntentTemplatesBuilt || !IntentMatcher)
+	{
+		return;
+	}
+	bIntentTemplatesBuilt = true;
+
+	// The few-shot examples are known-good answers for their descriptions
+	TArray<FString> Examples;
+	GetFewShotExamples().ParseIntoArray(Examples, TEXT("\n\n"));
+	for (const FString& Example : Examples)
+	{
+		FString UserPart, AssistantPart;
+		if (Example.Split(TEXT("\nASSISTANT:"), &UserPart, &AssistantPart))
+		{
+			UserPart.RemoveFromStart(TEXT("USER:"));
+			UserPart.TrimStartAndEndInline();
+			IntentMatcher->AddTemplateFromJSON(UserPart, UserPart, AssistantPart.TrimStartAndEnd());
+		}
+	}
+
+	IntentMatcher->AddBuiltInPresets();
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Built %d intent templates"), IntentMatcher->GetNumTemplates());
+}
+
+void ULLMIntentParser::SetEndpoint(const FString& URL, int32 Port)
+{
+	EndpointURL = URL;
+	EndpointPort = Port;
+}
+
+void ULLMIntentParser::SetModel(const FString& InModelName)
+{
+	ModelName = InModelName;
+}
+
+void ULLMIntentParser::SetMaxConcurrentRequests(int32 InMaxConcurrentRequests)
+{
+	MaxConcurrentRequests = FMath::Max(1, InMaxConcurrentRequests);
+	PumpQueue();
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> ULLMIntentParser::CreateEndpointRequest(const FString& Path, const FString& Verb, float Timeout) const
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+
+	Request->SetURL(FString::Printf(TEXT("%s:%d%s"), *EndpointURL, EndpointPort, *Path));
+	Request->SetVerb(Verb);
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+	Request->SetTimeout(Timeout);
+
+	return Request;
+}
+
+void ULLMIntentParser::CheckConnection(FOnParseComplete OnComplete)
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateEndpointRequest(TEXT("/api/tags"), TEXT("GET"), 5.0f);
+
+	Request->OnProcessRequestComplete().BindLambda(
+		[OnComplete](FHttpRequestPtr Req, FHttpResponsePtr Resp, bool bSuccess)
+		{
+			if (bSuccess && Resp.IsValid() && Resp->GetResponseCode() == 200)
+			{
+				OnComplete.ExecuteIfBound(true, TEXT(""));
+			}
+			else
+			{
+				FString Error = TEXT("Could not connect to Ollama. Is it running?");
+				OnComplete.ExecuteIfBound(false, Error);
+			}
+		});
+
+	Request->ProcessRequest();
+}
+
+void ULLMIntentParser::FetchAvailableModels(FOnModelListReceived OnComplete)
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateEndpointRequest(TEXT("/api/tags"), TEXT("GET"), 5.0f);
+
+	Request->OnProcessRequestComplete().BindLambda(
+		[OnComplete](FHttpRequestPtr Req, FHttpResponsePtr Resp, bool bSuccess)
+		{
+			TArray<FString> Models;
+
+			if (!bSuccess || !Resp.IsValid() || Resp->GetResponseCode() != 200)
+			{
+				OnComplete.ExecuteIfBound(false, Models, TEXT("Could not connect to Ollama. Is it running?"));
+				return;
+			}
+
+			TSharedPtr<FJsonObject> JsonResponse;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Resp->GetContentAsString());
+
+			const TArray<TSharedPtr<FJsonValue>>* ModelsArray;
+			if (!FJsonSerializer::Deserialize(Reader, JsonResponse) || !JsonResponse->TryGetArrayField(TEXT("models"), ModelsArray))
+			{
+				OnComplete.ExecuteIfBound(false, Models, TEXT("Invalid model list response"));
+				return;
+			}
+
+			for (const TSharedPtr<FJsonValue>& ModelValue : *ModelsArray)
+			{
+				TSharedPtr<FJsonObject> ModelObj = ModelValue->AsObject();
+				FString Name;
+				if (ModelObj.IsValid() && ModelObj->TryGetStringField(TEXT("name"), Name) && !Name.IsEmpty())
+				{
+					Models.Add(Name);
+				}
+			}
+
+			OnComplete.ExecuteIfBound(true, Models, TEXT(""));
+		});
+
+	Request->ProcessRequest();
+}
+
+void ULLMIntentParser::WarmUpModel()
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateEndpointRequest(
+		bUseChatSession ? TEXT("/api/chat") : TEXT("/api/generate"), TEXT("POST"), 60.0f);
+
+	// Evaluate the static prefix and generate a single token so it is cached with the loaded model
+	TSharedPtr<FJsonObject> RequestBody = MakeShareable(new FJsonObject());
+	RequestBody->SetStringField(TEXT("model"), ModelName);
+	RequestBody->SetBoolField(TEXT("stream"), false);
+	RequestBody->SetStringField(TEXT("keep_alive"), KeepAlive);
+	if (bUseChatSession)
+	{
+		RequestBody->SetArrayField(TEXT("messages"), GetChatPrefixMessages());
+	}
+
+	TSharedPtr<FJsonObject> Options = MakeShareable(new FJsonObject());
+	Options->SetNumberField(TEXT("num_predict"), 1);
+	RequestBody->SetObjectField(TEXT("options"), Options);
+
+	FString RequestString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestString);
+	FJsonSerializer::Serialize(RequestBody.ToSharedRef(), Writer);
+	Request->SetContentAsString(RequestString);
+
+	const double SendTime = FPlatformTime::Seconds();
+	const FString WarmModel = ModelName;
+	Request->OnProcessRequestComplete().BindLambda(
+		[SendTime, WarmModel](FHttpRequestPtr Req, FHttpResponsePtr Resp, bool bSuccess)
+		{
+			if (bSuccess && Resp.IsValid() && Resp->GetResponseCode() == 200)
+			{
+				UE_LOG(LogInputStreamliner, Log, TEXT("Warmed up %s in %.0f ms"), *WarmModel, (FPlatformTime::Seconds() - SendTime) * 1000.0);
+			}
+			else
+			{
+				UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to warm up %s"), *WarmModel);
+			}
+		});
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Warming up model %s (keep_alive %s)"), *ModelName, *KeepAlive);
+	Request->ProcessRequest();
+}
+
+void ULLMIntentParser::ParseInputDescriptionAsync(const FString& Description, FOnParseComplete OnComplete)
+{
+	EnqueueRequest(Description, OnComplete, 0, false);
+}
+
+int32 ULLMIntentParser::SubmitParseRequest(const FString& Description, FOnParseComplete OnComplete, int32 Priority)
+{
+	return EnqueueRequest(Description, OnComplete, Priority, true);
+}
+
+int32 ULLMIntentParser::EnqueueRequest(const FString& Description, FOnParseComplete OnComplete, int32 Priority, bool bRetainResult, int32 RefinedRequestId)
+{
+	TSharedPtr<FLLMParseRequest> ParseRequest = MakeShared<FLLMParseRequest>();
+	ParseRequest->Id = NextRequestId++;
+	ParseRequest->Priority = Priority;
+	ParseRequest->Description = Description;
+	ParseRequest->Callback = OnComplete;
+	ParseRequest->bRetainResult = bRetainResult;
+	ParseRequest->MaxActions = MaxResponseActions;
+	ParseRequest->RefinedRequestId = RefinedRequestId;
+
+	const int32 RequestId = ParseRequest->Id;
+	Requests.Add(RequestId, ParseRequest);
+
+	// Serve identical requests from the cache without contacting the model
+	if (bCacheEnabled && ResponseCache)
+	{
+		ResponseCache->SetPromptHash(GetPromptHash());
+
+		// The action limit shapes the response, so results under different limits don't share entries
+		const FString SchemaHash = FString::Printf(TEXT("%s:%d"), *GetPromptHash(), MaxResponseActions);
+		ParseRequest->CacheKey = ULLMResponseCache::MakeKey(ModelName, SchemaHash, Description, Temperature, TopP);
+
+		if (ResponseCache->Find(ParseRequest->CacheKey, ParseRequest->Result))
+		{
+			UE_LOG(LogInputStreamliner, Log, TEXT("LLM cache hit (%d actions): %s"), ParseRequest->Result.Actions.Num(), *Description);
+			ParseRequest->bReachedActionLimit = ParseRequest->Result.Actions.Num() >= ParseRequest->MaxActions;
+			CompleteOnNextTick(RequestId);
+			return RequestId;
+		}
+	}
+
+	// Answer common descriptions from the templates; keep the closest one in case the LLM is unreachable
+	if (bLocalMatchingEnabled && RefinedRequestId == INDEX_NONE && IntentMatcher)
+	{
+		EnsureIntentTemplates();
+
+		FString TemplateName;
+		const double MatchStartTime = FPlatformTime::Seconds();
+		ParseRequest->LocalMatchConfidence = IntentMatcher->Match(Description, ParseRequest->LocalMatch, TemplateName);
+		FInputStreamlinerMetrics::Record(TEXT("LLM.LocalMatchMs"), (FPlatformTime::Seconds() - MatchStartTime) * 1000.0);
+
+		if (ParseRequest->LocalMatchConfidence >= LocalMatchThreshold)
+		{
+			UE_LOG(LogInputStreamliner, Log, TEXT("Local match %s (confidence %.2f, %d actions): %s"),
+				*TemplateName, ParseRequest->LocalMatchConfidence, ParseRequest->LocalMatch.Actions.Num(), *Description);
+			FInputStreamlinerMetrics::Increment(TEXT("LLM.LocalMatches"));
+
+			ParseRequest->Result = ParseRequest->LocalMatch;
+			CompleteOnNextTick(RequestId);
+
+			if (bRefineLocalMatches)
+			{
+				// The refinement is internal; its result replaces this request's and is reported under this id
+				ParseRequest->RefinementRequestId = EnqueueRequest(Description, FOnParseComplete(), Priority - 1, false, RequestId);
+			}
+			return RequestId;
+		}
+	}
+
+	QueueRequest(RequestId, Priority);
+	return RequestId;
+}
+
+int32 ULLMIntentParser::SubmitRefinementRequest(const FInputStreamlinerConfiguration& CurrentConfig, const FString& Instruction, FOnParseComplete OnComplete, int32 Priority)
+{
+	TSharedPtr<FLLMParseRequest> ParseRequest = MakeShared<FLLMParseRequest>();
+	ParseRequest->Id = NextRequestId++;
+	ParseRequest->Priority = Priority;
+	ParseRequest->Description = FString::Printf(TEXT("CURRENT ACTIONS:\n%s\nCHANGE: %s"), *BuildCompactConfiguration(CurrentConfig), *Instruction);
+	ParseRequest->Callback = OnComplete;
+	ParseRequest->bRefinement = true;
+	ParseRequest->BaseConfig = CurrentConfig;
+
+	const int32 RequestId = ParseRequest->Id;
+	Requests.Add(RequestId, ParseRequest);
+
+	QueueRequest(RequestId, Priority);
+	return RequestId;
+}
+
+void ULLMIntentParser::QueueRequest(int32 RequestId, int32 Priority)
+{
+	// Keep the queue sorted by priority, FIFO within equal priority
+	int32 InsertIndex = PendingQueue.Num();
+	for (int32 i = 0; i < PendingQueue.Num(); i++)
+	{
+		const TSharedPtr<FLLMParseRequest>* Queued = Requests.Find(PendingQueue[i]);
+		if (Queued && (*Queued)->Priority < Priority)
+		{
+			InsertIndex = i;
+			break;
+		}
+	}
+	PendingQueue.Insert(RequestId, InsertIndex);
+
+	PumpQueue();
+}
+
+void ULLMIntentParser::CompleteOnNextTick(int32 RequestId)
+{
+	TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	if (!ParseRequest)
+	{
+		return;
+	}
+
+	(*ParseRequest)->State = ELLMParseRequestState::InFlight;
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this, RequestId](float)
+	{
+		CompleteRequest(RequestId, ELLMParseRequestState::Succeeded, TEXT(""));
+		return false;
+	}));
+}
+
+void ULLMIntentParser::PumpQueue()
+{
+	while (NumInFlight < MaxConcurrentRequests && PendingQueue.Num() > 0)
+	{
+		const int32 RequestId = PendingQueue[0];
+		PendingQueue.RemoveAt(0);
+
+		TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+		if (ParseRequest && (*ParseRequest)->State == ELLMParseRequestState::Queued)
+		{
+			NumInFlight++;
+			StartRequest(**ParseRequest);
+		}
+	}
+}
+
+void ULLMIntentParser::StartRequest(FLLMParseRequest& ParseRequest)
+{
+	ParseRequest.State = ELLMParseRequestState::InFlight;
+	if (bStreamingEnabled)
+	{
+		ParseRequest.Stream = MakeShared<FLLMStreamState>();
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateEndpointRequest(
+		bUseChatSession ? TEXT("/api/chat") : TEXT("/api/generate"), TEXT("POST"), 60.0f); // LLM can take a while
+
+	// Build request body
+	TSharedPtr<FJsonObject> RequestBody = MakeShareable(new FJsonObject());
+	RequestBody->SetStringField(TEXT("model"), ModelName);
+	if (ParseRequest.bRefinement)
+	{
+		// Refinements share no prefix with parse requests; the few-shot examples would only add prompt tokens
+		if (bUseChatSession)
+		{
+			TArray<TSharedPtr<FJsonValue>> Messages;
+			auto AddMessage = [&Messages](const TCHAR* Role, const FString& Content)
+			{
+				TSharedPtr<FJsonObject> Message = MakeShareable(new FJsonObject());
+				Message->SetStringField(TEXT("role"), Role);
+				Message->SetStringField(TEXT("content"), Content);
+				Messages.Add(MakeShareable(new FJsonValueObject(Message)));
+			};
+
+			AddMessage(TEXT("system"), GetRefinementPrompt());
+			AddMessage(TEXT("user"), ParseRequest.Description);
+			RequestBody->SetArrayField(TEXT("messages"), Messages);
+		}
+		else
+		{
+			RequestBody->SetStringField(TEXT("prompt"), FString::Printf(TEXT("%s\n\n%s\nASSISTANT:"), *GetRefinementPrompt(), *ParseRequest.Description));
+		}
+	}
+	else if (bUseChatSession)
+	{
+		RequestBody->SetArrayField(TEXT("messages"), BuildChatMessages(ParseRequest.Description));
+	}
+	else
+	{
+		RequestBody->SetStringField(TEXT("prompt"), BuildPrompt(ParseRequest.Description));
+	}
+	RequestBody->SetBoolField(TEXT("stream"), bStreamingEnabled);
+	RequestBody->SetStringField(TEXT("keep_alive"), KeepAlive);
+
+	if (bUseSchemaFormat)
+	{
+		RequestBody->SetObjectField(TEXT("format"), ParseRequest.bRefinement ? GetPatchSchema() : GetResponseSchema(ParseRequest.MaxActions));
+	}
+
+	// Set generation parameters for more consistent output
+	TSharedPtr<FJsonObject> Options = MakeShareable(new FJsonObject());
+	Options->SetNumberField(TEXT("temperature"), Temperature); // Low temperature for consistent output
+	Options->SetNumberField(TEXT("top_p"), TopP);
+	if (bUseSchemaFormat)
+	{
+		Options->SetNumberField(TEXT("num_predict"), ParseRequest.bRefinement ? GetPatchTokenLimit() : GetSchemaTokenLimit(ParseRequest.MaxActions));
+	}
+	RequestBody->SetObjectField(TEXT("options"), Options);
+
+	FString RequestString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestString);
+	FJsonSerializer::Serialize(RequestBody.ToSharedRef(), Writer);
+
+	Request->SetContentAsString(RequestString);
+
+	Request->OnProcessRequestComplete().BindUObject(this, &ULLMIntentParser::OnHttpResponseReceived, ParseRequest.Id);
+
+	if (bStreamingEnabled)
+	{
+		Request->OnRequestProgress64().BindUObject(this, &ULLMIntentParser::OnHttpRequestProgress, ParseRequest.Id);
+	}
+
+	ParseRequest.HttpRequest = Request;
+	ParseRequest.SendTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Sending %s parse request %d to LLM (%d/%d in flight): %s"),
+		bStreamingEnabled ? TEXT("streaming") : TEXT("blocking"), ParseRequest.Id, NumInFlight, MaxConcurrentRequests, *ParseRequest.Description);
+	Request->ProcessRequest();
+}
+
+bool ULLMIntentParser::CancelParseRequest(int32 RequestId)
+{
+	TSharedPtr<FLLMParseRequest>* Found = Requests.Find(RequestId);
+	if (!Found)
+	{
+		return false;
+	}
+
+	TSharedPtr<FLLMParseRequest> ParseRequest = *Found;
+	if (ParseRequest->State != ELLMParseRequestState::Queued && ParseRequest->State != ELLMParseRequestState::InFlight)
+	{
+		return false;
+	}
+
+	PendingQueue.Remove(RequestId);
+
+	if (ParseRequest->HttpRequest.IsValid())
+	{
+		// Unbind first so the cancelled request does not report a failure
+		ParseRequest->HttpRequest->OnProcessRequestComplete().Unbind();
+		ParseRequest->HttpRequest->OnRequestProgress64().Unbind();
+		ParseRequest->HttpRequest->CancelRequest();
+	}
+
+	if (ParseRequest->RefinementRequestId != INDEX_NONE)
+	{
+		CancelParseRequest(ParseRequest->RefinementRequestId);
+	}
+
+	CompleteRequest(RequestId, ELLMParseRequestState::Cancelled, TEXT("Request cancelled"));
+	return true;
+}
+
+void ULLMIntentParser::CancelAllParseRequests()
+{
+	TArray<int32> RequestIds;
+	Requests.GetKeys(RequestIds);
+
+	for (int32 RequestId : RequestIds)
+	{
+		CancelParseRequest(RequestId);
+	}
+}
+
+ELLMParseRequestState ULLMIntentParser::GetParseRequestState(int32 RequestId) const
+{
+	const TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	return ParseRequest ? (*ParseRequest)->State : ELLMParseRequestState::None;
+}
+
+bool ULLMIntentParser::GetParseResult(int32 RequestId, FInputStreamlinerConfiguration& OutConfig, FString& OutError) const
+{
+	const TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	if (!ParseRequest)
+	{
+		OutError = TEXT("Unknown request");
+		return false;
+	}
+
+	OutError = (*ParseRequest)->ErrorMessage;
+	if ((*ParseRequest)->State != ELLMParseRequestState::Succeeded)
+	{
+		return false;
+	}
+
+	OutConfig = (*ParseRequest)->Result;
+	return true;
+}
+
+bool ULLMIntentParser::DidReachActionLimit(int32 RequestId) const
+{
+	const TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	return ParseRequest && (*ParseRequest)->bReachedActionLimit;
+}
+
+bool ULLMIntentParser::GetPatchResult(int32 RequestId, FInputConfigurationPatch& OutPatch, FString& OutError) const
+{
+	const TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	if (!ParseRequest || !(*ParseRequest)->bRefinement)
+	{
+		OutError = TEXT("Unknown refinement request");
+		return false;
+	}
+
+	OutError = (*ParseRequest)->ErrorMessage;
+	if ((*ParseRequest)->State != ELLMParseRequestState::Succeeded)
+	{
+		return false;
+	}
+
+	OutPatch = (*ParseRequest)->Patch;
+	return true;
+}
+
+void ULLMIntentParser::ReleaseParseRequest(int32 RequestId)
+{
+	const TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+
+	// Nobody can receive the refined result of a released request
+	if (ParseRequest && (*ParseRequest)->RefinementRequestId != INDEX_NONE)
+	{
+		CancelParseRequest((*ParseRequest)->RefinementRequestId);
+		ParseRequest = Requests.Find(RequestId);
+	}
+
+	if (ParseRequest && ((*ParseRequest)->State == ELLMParseRequestState::Queued || (*ParseRequest)->State == ELLMParseRequestState::InFlight))
+	{
+		CancelParseRequest(RequestId);
+	}
+
+	Requests.Remove(RequestId);
+}
+
+void ULLMIntentParser::CompleteRequest(int32 RequestId, ELLMParseRequestState FinalState, const FString& ErrorMessage)
+{
+	TSharedPtr<FLLMParseRequest>* Found = Requests.Find(RequestId);
+	if (!Found || ((*Found)->State != ELLMParseRequestState::Queued && (*Found)->State != ELLMParseRequestState::InFlight))
+	{
+		return;
+	}
+
+	// Hold a reference; callbacks may release the request
+	TSharedPtr<FLLMParseRequest> ParseRequest = *Found;
+
+	if (ParseRequest->HttpRequest.IsValid())
+	{
+		NumInFlight--;
+	}
+
+	const bool bSuccess = FinalState == ELLMParseRequestState::Succeeded;
+	ParseRequest->State = FinalState;
+	ParseRequest->ErrorMessage = ErrorMessage;
+	ParseRequest->HttpRequest.Reset();
+	ParseRequest->Stream.Reset();
+
+	if (bSuccess && ParseRequest->bRefinement)
+	{
+		LastParsedPatch = ParseRequest->Patch;
+	}
+	else if (bSuccess && ParseRequest->RefinedRequestId == INDEX_NONE)
+	{
+		LastParsedConfig = ParseRequest->Result;
+	}
+
+	if (!ParseRequest->bRetainResult)
+	{
+		Requests.Remove(RequestId);
+	}
+
+	if (ParseRequest->RefinedRequestId != INDEX_NONE)
+	{
+		CompleteRefinement(*ParseRequest, bSuccess, ErrorMessage);
+		PumpQueue();
+		return;
+	}
+
+	ParseRequest->Callback.ExecuteIfBound(bSuccess, ErrorMessage);
+	OnParseCompleted.Broadcast(bSuccess, ErrorMessage);
+	OnParseRequestCompleted.Broadcast(RequestId, bSuccess, ErrorMessage);
+
+	PumpQueue();
+}
+
+void ULLMIntentParser::CompleteRefinement(const FLLMParseRequest& Refinement, bool bSuccess, const FString& ErrorMessage)
+{
+	const int32 OriginalId = Refinement.RefinedRequestId;
+	if (TSharedPtr<FLLMParseRequest>* Original = Requests.Find(OriginalId))
+	{
+		(*Original)->RefinementRequestId = INDEX_NONE;
+		if (bSuccess)
+		{
+			(*Original)->Result = Refinement.Result;
+			(*Original)->bReachedActionLimit = Refinement.bReachedActionLimit;
+		}
+	}
+
+	// A cancelled refinement was released or superseded; there is nothing to report
+	if (Refinement.State == ELLMParseRequestState::Cancelled)
+	{
+		return;
+	}
+
+	if (bSuccess)
+	{
+		LastParsedConfig = Refinement.Result;
+	}
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Refinement of request %d %s%s"), OriginalId, bSuccess ? TEXT("succeeded") : TEXT("failed: "), *ErrorMessage);
+	OnParseRequestRefined.Broadcast(OriginalId, bSuccess, ErrorMessage);
+}
+
+void ULLMIntentParser::OnHttpRequestProgress(FHttpRequestPtr Request, uint64 BytesSent, uint64 BytesReceived, int32 RequestId)
+{
+	TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	if (!ParseRequest || !(*ParseRequest)->Stream.IsValid() || !Request.IsValid())
+	{
+		return;
+	}
+
+	FHttpResponsePtr Response = Request->GetResponse();
+	if (Response.IsValid())
+	{
+		ConsumeStreamedContent(RequestId, *(*ParseRequest)->Stream, Response->GetContent(), false);
+	}
+}
+
+void ULLMIntentParser::ConsumeStreamedContent(int32 RequestId, FLLMStreamState& State, const TArray<uint8>& Content, bool bFinal)
+{
+	TArray<FString> CompletedActions;
+
+	// Ollama streams one JSON object per line; only complete lines are decoded so
+	// multi-byte UTF-8 sequences are never split
+	int32 LineEnd = State.LineStart;
+	while (LineEnd < Content.Num() || (bFinal && State.LineStart < Content.Num()))
+	{
+		const bool bAtEnd = LineEnd >= Content.Num();
+		if (!bAtEnd && Content[LineEnd] != '\n')
+		{
+			LineEnd++;
+			continue;
+		}
+
+		const int32 LineLength = LineEnd - State.LineStart;
+		if (LineLength > 0)
+		{
+			FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData() + State.LineStart), LineLength);
+			FString Line(Converted.Length(), Converted.Get());
+
+			TSharedPtr<FJsonObject> Chunk;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+			if (FJsonSerializer::Deserialize(Reader, Chunk) && Chunk.IsValid())
+			{
+				FString Token;
+				if (GetGeneratedText(*Chunk, Token) && !Token.IsEmpty())
+				{
+					if (State.FirstTokenTime == 0.0)
+					{
+						State.FirstTokenTime = FPlatformTime::Seconds();
+					}
+					State.ResponseText += Token;
+				}
+
+				bool bDone = false;
+				if (Chunk->TryGetBoolField(TEXT("done"), bDone) && bDone)
+				{
+					State.FinalChunk = Chunk;
+				}
+			}
+		}
+
+		State.LineStart = LineEnd + 1;
+		LineEnd = State.LineStart;
+
+		if (bAtEnd)
+		{
+			break;
+		}
+	}
+
+	State.ScanForCompletedActions(CompletedActions);
+
+	// A background refinement's actions would be reported under an id the caller never received
+	const TSharedPtr<FLLMParseRequest>* ParseRequest = Requests.Find(RequestId);
+	const bool bBroadcastActions = ParseRequest && (*ParseRequest)->RefinedRequestId == INDEX_NONE;
+
+	for (const FString& ActionJSON : CompletedActions)
+	{
+		TSharedPtr<FJsonObject> ActionObj;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ActionJSON);
+		if (!FJsonSerializer::Deserialize(Reader, ActionObj))
+		{
+			UE_LOG(LogInputStreamliner, Warning, TEXT("Skipping malformed streamed action: %s"), *ActionJSON.Left(200));
+			continue;
+		}
+
+		FInputActionDefinition ActionDef;
+		if (FInputConfigurationDecoder::DecodeLLMAction(ActionObj, ActionDef))
+		{
+			UE_LOG(LogInputStreamliner, Verbose, TEXT("Streamed action: %s"), *ActionDef.ActionName.ToString());
+			if (bBroadcastActions)
+			{
+				OnActionParsed.Broadcast(RequestId, ActionDef);
+			}
+		}
+	}
 }
 
-void ULLMIntentParser::SetEndpoint(const FString& URL, int32 Port)
+void ULLMIntentParser::OnHttpResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int32 RequestId)
 {
-	EndpointURL = URL;
-	EndpointPort = Port;
+	TSharedPtr<FLLMParseRequest>* Found = Requests.Find(RequestId);
+	if (!Found || (*Found)->State != ELLMParseRequestState::InFlight)
+	{
+		return;
+	}
+
+	TSharedPtr<FLLMParseRequest> ParseRequest = *Found;
+
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		// The server is not running; a reasonably close template beats no answer
+		if (bLocalMatchingEnabled && ParseRequest->LocalMatchConfidence >= OfflineMatchThreshold)
+		{
+			UE_LOG(LogInputStreamliner, Warning, TEXT("LLM unreachable, using the closest template (confidence %.2f) for request %d"),
+				ParseRequest->LocalMatchConfidence, RequestId);
+			ParseRequest->Result = ParseRequest->LocalMatch;
+			CompleteRequest(RequestId, ELLMParseRequestState::Succeeded, TEXT(""));
+			return;
+		}
+
+		FString Error = TEXT("HTTP request failed");
+		UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *Error);
+		CompleteRequest(RequestId, ELLMParseRequestState::Failed, Error);
+		return;
+	}
+
+	if (Response->GetResponseCode() != 200)
+	{
+		FString Error = FString::Printf(TEXT("HTTP error: %d"), Response->GetResponseCode());
+		UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *Error);
+		CompleteRequest(RequestId, ELLMParseRequestState::Failed, Error);
+		return;
+	}
+
+	FString ResponseText;
+
+	if (ParseRequest->Stream.IsValid())
+	{
+		// Flush the trailing chunk, then use the text accumulated from every chunk
+		ConsumeStreamedContent(RequestId, *ParseRequest->Stream, Response->GetContent(), true);
+
+		ResponseText = ParseRequest->Stream->ResponseText;
+
+		LogResponseTimings(RequestId, bUseChatSession ? TEXT("chat") : TEXT("generate"),
+			ParseRequest->SendTime, ParseRequest->Stream->FirstTokenTime, ParseRequest->Stream->FinalChunk);
+	}
+	else
+	{
+		// Parse Ollama response
+		TSharedPtr<FJsonObject> JsonResponse;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+
+		if (!FJsonSerializer::Deserialize(Reader, JsonResponse))
+		{
+			FString Error = TEXT("Failed to parse Ollama response JSON");
+			UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *Error);
+			CompleteRequest(RequestId, ELLMParseRequestState::Failed, Error);
+			return;
+		}
+
+		// Extract the generated text from Ollama's format
+		GetGeneratedText(*JsonResponse, ResponseText);
+
+		// Without streaming the first token is only observed with the full response
+		LogResponseTimings(RequestId, bUseChatSession ? TEXT("chat") : TEXT("generate"),
+			ParseRequest->SendTime, 0.0, JsonResponse);
+	}
+
+	UE_LOG(LogInputStreamliner, Verbose, TEXT("LLM Response: %s"), *ResponseText);
+
+	if (ParseRequest->bRefinement)
+	{
+		TSharedPtr<FJsonObject> PatchObject;
+		FString PatchError;
+		if (!ExtractJSONObject(ResponseText, PatchObject, PatchError))
+		{
+			UE_LOG(LogInputStreamliner, Error, TEXT("Failed to parse LLM patch: %s"), *PatchError);
+			CompleteRequest(RequestId, ELLMParseRequestState::Failed, PatchError);
+			return;
+		}
+
+		FInputConfigurationDecoder::DecodeLLMPatch(PatchObject, ParseRequest->BaseConfig, ParseRequest->Patch);
+		UE_LOG(LogInputStreamliner, Log, TEXT("Parsed %d patch operations from LLM response %d"),
+			ParseRequest->Patch.Operations.Num(), RequestId);
+
+		const TArray<TSharedPtr<FJsonValue>>* Operations;
+		if (bUseSchemaFormat && PatchObject->TryGetArrayField(TEXT("operations"), Operations) && Operations->Num() >= LLMSchema::MaxPatchOperations)
+		{
+			ParseRequest->bReachedActionLimit = true;
+			UE_LOG(LogInputStreamliner, Warning, TEXT("Refinement %d filled the limit of %d operations; split the change into smaller requests"),
+				RequestId, LLMSchema::MaxPatchOperations);
+		}
+
+		CompleteRequest(RequestId, ELLMParseRequestState::Succeeded, TEXT(""));
+		return;
+	}
+
+	// Parse the JSON from the LLM response; schema output is bare JSON and needs no extraction,
+	// but fall back to scraping in case the server ignored the format field
+	FString ParseError;
+	bool bParsed = bUseSchemaFormat && DecodeJSONResponse(ResponseText, ParseRequest->Result, ParseError);
+	if (!bParsed)
+	{
+		bParsed = ParseJSONResponse(ResponseText, ParseRequest->Result, ParseError);
+	}
+
+	if (!bParsed)
+	{
+		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to parse LLM output: %s"), *ParseError);
+		CompleteRequest(RequestId, ELLMParseRequestState::Failed, ParseError);
+		return;
+	}
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Successfully parsed %d actions from LLM response %d"),
+		ParseRequest->Result.Actions.Num(), RequestId);
+
+	if (bUseSchemaFormat && ParseRequest->Result.Actions.Num() >= ParseRequest->MaxActions)
+	{
+		ParseRequest->bReachedActionLimit = true;
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Response %d filled the limit of %d actions and may be missing some; raise LLMMaxActions or split the description"),
+			RequestId, ParseRequest->MaxActions);
+	}
+
+	if (!ParseRequest->CacheKey.IsEmpty() && ResponseCache)
+	{
+		ResponseCache->Add(ParseRequest->CacheKey, ParseRequest->Result);
+	}
+
+	CompleteRequest(RequestId, ELLMParseRequestState::Succeeded, TEXT(""));
 }
 
-void ULLMIntentParser::SetModel(const FString& InModelName)
+TArray<TSharedPtr<FJsonValue>> ULLMIntentParser::BuildChatMessages(const FString& UserDescription)
 {
-	ModelName = InModelName;
+	TArray<TSharedPtr<FJsonValue>> Messages = GetChatPrefixMessages();
+
+	TSharedPtr<FJsonObject> UserMessage = MakeShareable(new FJsonObject());
+	UserMessage->SetStringField(TEXT("role"), TEXT("user"));
+	UserMessage->SetStringField(TEXT("content"), UserDescription);
+	Messages.Add(MakeShareable(new FJsonValueObject(UserMessage)));
+
+	return Messages;
 }
 
-void ULLMIntentParser::CheckConnection(FOnParseComplete OnComplete)
+const TArray<TSharedPtr<FJsonValue>>& ULLMIntentParser::GetChatPrefixMessages()
 {
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	static const TArray<TSharedPtr<FJsonValue>> PrefixMessages = []()
+	{
+		TArray<TSharedPtr<FJsonValue>> Messages;
 
-	Request->SetURL(FString::Printf(TEXT("%s:%d/api/tags"), *EndpointURL, EndpointPort));
-	Request->SetVerb(TEXT("GET"));
-	Request->SetTimeout(5.0f);
+		auto AddMessage = [&Messages](const TCHAR* Role, const FString& Content)
+		{
+			TSharedPtr<FJsonObject> Message = MakeShareable(new FJsonObject());
+			Message->SetStringField(TEXT("role"), Role);
+			Message->SetStringField(TEXT("content"), Content.TrimStartAndEnd());
+			Messages.Add(MakeShareable(new FJsonValueObject(Message)));
+		};
 
-	Request->OnProcessRequestComplete().BindLambda(
-		[OnComplete](FHttpRequestPtr Req, FHttpResponsePtr Resp, bool bSuccess)
+		AddMessage(TEXT("system"), GetSystemPrompt());
+
+		// Split the "USER: ...\nASSISTANT: ..." examples into alternating turns
+		TArray<FString> Examples;
+		GetFewShotExamples().ParseIntoArray(Examples, TEXT("\n\n"));
+		for (const FString& Example : Examples)
 		{
-			if (bSuccess && Resp.IsValid() && Resp->GetResponseCode() == 200)
-			{
-				OnComplete.ExecuteIfBound(true, TEXT(""));
-			}
-			else
+			FString UserPart, AssistantPart;
+			if (Example.Split(TEXT("\nASSISTANT:"), &UserPart, &AssistantPart))
 			{
-				FString Error = TEXT("Could not connect to Ollama. Is it running?");
-				OnComplete.ExecuteIfBound(false, Error);
+				UserPart.RemoveFromStart(TEXT("USER:"));
+				AddMessage(TEXT("user"), UserPart);
+				AddMessage(TEXT("assistant"), AssistantPart);
 			}
-		});
+		}
 
-	Request->ProcessRequest();
+		return Messages;
+	}();
+
+	return PrefixMessages;
 }
 
-void ULLMIntentParser::ParseInputDescriptionAsync(const FString& Description, FOnParseComplete OnComplete)
+namespace LLMSchema
 {
-	if (bParseInProgress)
+	/** Maximum number of key bindings per platform */
+	constexpr int32 MaxBindingsPerPlatform = 4;
+
+	/** Token budget assumed for a free-form string value */
+	constexpr int32 FreeStringTokens = 8;
+
+	TSharedPtr<FJsonObject> MakeType(const TCHAR* Type)
 	{
-		OnComplete.ExecuteIfBound(false, TEXT("Parse already in progress"));
-		return;
+		TSharedPtr<FJsonObject> Schema = MakeShareable(new FJsonObject());
+		Schema->SetStringField(TEXT("type"), Type);
+		return Schema;
 	}
 
-	bParseInProgress = true;
+	/** String schema restricted to the visible names of a UENUM */
+	TSharedPtr<FJsonObject> MakeEnum(const UEnum* Enum, TFunctionRef<bool(int64)> Filter)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		for (int32 i = 0; i < Enum->NumEnums() - 1; i++)
+		{
+			if (!Enum->HasMetaData(TEXT("Hidden"), i) && Filter(Enum->GetValueByIndex(i)))
+			{
+				Values.Add(MakeShareable(new FJsonValueString(Enum->GetNameStringByIndex(i))));
+			}
+		}
 
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+		TSharedPtr<FJsonObject> Schema = MakeType(TEXT("string"));
+		Schema->SetArrayField(TEXT("enum"), Values);
+		return Schema;
+	}
 
-	Request->SetURL(FString::Printf(TEXT("%s:%d/api/generate"), *EndpointURL, EndpointPort));
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Request->SetTimeout(60.0f); // LLM can take a while
+	TSharedPtr<FJsonObject> MakeEnum(const UEnum* Enum)
+	{
+		return MakeEnum(Enum, [](int64) { return true; });
+	}
 
-	// Build request body
-	TSharedPtr<FJsonObject> RequestBody = MakeShareable(new FJsonObject());
-	RequestBody->SetStringField(TEXT("model"), ModelName);
-	RequestBody->SetStringField(TEXT("prompt"), BuildPrompt(Description));
-	RequestBody->SetBoolField(TEXT("stream"), false);
+	TSharedPtr<FJsonObject> MakeObject(const TSharedPtr<FJsonObject>& Properties, const TArray<FString>& Required)
+	{
+		TSharedPtr<FJsonObject> Schema = MakeType(TEXT("object"));
+		Schema->SetObjectField(TEXT("properties"), Properties);
 
-	// Set generation parameters for more consistent output
-	TSharedPtr<FJsonObject> Options = MakeShareable(new FJsonObject());
-	Options->SetNumberField(TEXT("temperature"), 0.1); // Low temperature for consistent output
-	Options->SetNumberField(TEXT("top_p"), 0.9);
-	RequestBody->SetObjectField(TEXT("options"), Options);
+		TArray<TSharedPtr<FJsonValue>> RequiredValues;
+		for (const FString& Name : Required)
+		{
+			RequiredValues.Add(MakeShareable(new FJsonValueString(Name)));
+		}
+		Schema->SetArrayField(TEXT("required"), RequiredValues);
+		return Schema;
+	}
 
-	FString RequestString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestString);
-	FJsonSerializer::Serialize(RequestBody.ToSharedRef(), Writer);
+	TSharedPtr<FJsonObject> MakeArray(const TSharedPtr<FJsonObject>& Items, int32 MaxItems)
+	{
+		TSharedPtr<FJsonObject> Schema = MakeType(TEXT("array"));
+		Schema->SetObjectField(TEXT("items"), Items);
+		Schema->SetNumberField(TEXT("maxItems"), MaxItems);
+		return Schema;
+	}
 
-	Request->SetContentAsString(RequestString);
+	/** Rough token count of a string (about four characters per token), plus quotes */
+	int32 StringTokens(const FString& Value)
+	{
+		return FMath::DivideAndRoundUp(Value.Len(), 4) + 1;
+	}
 
-	Request->OnProcessRequestComplete().BindUObject(this, &ULLMIntentParser::OnHttpResponseReceived, OnComplete);
+	/** Estimate the largest number of tokens a value matching Schema can take */
+	int32 EstimateTokens(const FJsonObject& Schema)
+	{
+		const FString Type = Schema.GetStringField(TEXT("type"));
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Sending parse request to LLM: %s"), *Description);
-	Request->ProcessRequest();
-}
+		if (Type == TEXT("object"))
+		{
+			int32 Tokens = 2;
+			const TSharedPtr<FJsonObject>* Properties;
+			if (Schema.TryGetObjectField(TEXT("properties"), Properties))
+			{
+				for (const auto& Pair : (*Properties)->Values)
+				{
+					Tokens += StringTokens(Pair.Key) + 2 + EstimateTokens(*Pair.Value->AsObject());
+				}
+			}
+			return Tokens;
+		}
 
-void ULLMIntentParser::OnHttpResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FOnParseComplete Callback)
-{
-	bParseInProgress = false;
+		if (Type == TEXT("array"))
+		{
+			const int32 MaxItems = static_cast<int32>(Schema.GetNumberField(TEXT("maxItems")));
+			return 2 + MaxItems * (EstimateTokens(*Schema.GetObjectField(TEXT("items"))) + 1);
+		}
 
-	if (!bWasSuccessful || !Response.IsValid())
+		if (Type == TEXT("string"))
+		{
+			const TArray<TSharedPtr<FJsonValue>>* EnumValues;
+			if (Schema.TryGetArrayField(TEXT("enum"), EnumValues))
+			{
+				int32 Longest = 0;
+				for (const TSharedPtr<FJsonValue>& Value : *EnumValues)
+				{
+					Longest = FMath::Max(Longest, StringTokens(Value->AsString()));
+				}
+				return Longest;
+			}
+			return FreeStringTokens;
+		}
+
+		// boolean / number
+		return 2;
+	}
+
+	/** Schema of one action; refinement updates only carry the fields that change, so nothing is required there */
+	TSharedPtr<FJsonObject> BuildActionSchema(const TArray<FString>& Required)
 	{
-		FString Error = TEXT("HTTP request failed");
-		UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *Error);
-		Callback.ExecuteIfBound(false, Error);
-		OnParseCompleted.Broadcast(false, Error);
-		return;
+		// FKeyBindingDefinition
+		TArray<TSharedPtr<FJsonValue>> AxisValues;
+		for (const TCHAR* Axis : { TEXT("+X"), TEXT("-X"), TEXT("+Y"), TEXT("-Y"), TEXT("+Z"), TEXT("-Z") })
+		{
+			AxisValues.Add(MakeShareable(new FJsonValueString(Axis)));
+		}
+		TSharedPtr<FJsonObject> AxisSchema = MakeType(TEXT("string"));
+		AxisSchema->SetArrayField(TEXT("enum"), AxisValues);
+
+		TSharedPtr<FJsonObject> KeyProperties = MakeShareable(new FJsonObject());
+		KeyProperties->SetObjectField(TEXT("key"), MakeType(TEXT("string")));
+		KeyProperties->SetObjectField(TEXT("axis"), AxisSchema);
+		KeyProperties->SetObjectField(TEXT("trigger"), MakeEnum(StaticEnum<EInputTriggerType>()));
+		TSharedPtr<FJsonObject> KeySchema = MakeObject(KeyProperties, { TEXT("key") });
+
+		// FPlatformBindingConfig: key arrays on desktop platforms, a touch control on mobile
+		TSharedPtr<FJsonObject> TouchProperties = MakeShareable(new FJsonObject());
+		TouchProperties->SetObjectField(TEXT("touchControl"), MakeEnum(StaticEnum<ETouchControlType>(),
+			[](int64 Value) { return Value != static_cast<int64>(ETouchControlType::None); }));
+		TSharedPtr<FJsonObject> TouchSchema = MakeObject(TouchProperties, { TEXT("touchControl") });
+
+		TSharedPtr<FJsonObject> BindingProperties = MakeShareable(new FJsonObject());
+		const UEnum* PlatformEnum = StaticEnum<ETargetPlatform>();
+		for (int32 i = 0; i < PlatformEnum->NumEnums() - 1; i++)
+		{
+			const ETargetPlatform Platform = static_cast<ETargetPlatform>(PlatformEnum->GetValueByIndex(i));
+			if (Platform == ETargetPlatform::None || Platform == ETargetPlatform::All)
+			{
+				continue;
+			}
+
+			const bool bTouchPlatform = Platform == ETargetPlatform::iOS || Platform == ETargetPlatform::Android;
+			BindingProperties->SetObjectField(PlatformEnum->GetNameStringByIndex(i),
+				bTouchPlatform ? TouchSchema : MakeArray(KeySchema, MaxBindingsPerPlatform));
+		}
+
+		// FInputActionDefinition
+		TSharedPtr<FJsonObject> ActionProperties = MakeShareable(new FJsonObject());
+		ActionProperties->SetObjectField(TEXT("name"), MakeType(TEXT("string")));
+		ActionProperties->SetObjectField(TEXT("displayName"), MakeType(TEXT("string")));
+		ActionProperties->SetObjectField(TEXT("type"), MakeEnum(StaticEnum<EInputActionType>()));
+		ActionProperties->SetObjectField(TEXT("category"), MakeType(TEXT("string")));
+		ActionProperties->SetObjectField(TEXT("allowRebinding"), MakeType(TEXT("boolean")));
+		ActionProperties->SetObjectField(TEXT("bindings"), MakeObject(BindingProperties, {}));
+		return MakeObject(ActionProperties, Required);
 	}
 
-	if (Response->GetResponseCode() != 200)
+	TSharedPtr<FJsonObject> BuildSchema(int32 MaxActions)
 	{
-		FString Error = FString::Printf(TEXT("HTTP error: %d"), Response->GetResponseCode());
-		UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *Error);
-		Callback.ExecuteIfBound(false, Error);
-		OnParseCompleted.Broadcast(false, Error);
-		return;
+		TSharedPtr<FJsonObject> ActionSchema = BuildActionSchema(
+			{ TEXT("name"), TEXT("displayName"), TEXT("type"), TEXT("category"), TEXT("allowRebinding"), TEXT("bindings") });
+
+		// FGyroConfiguration
+		TSharedPtr<FJsonObject> GyroProperties = MakeShareable(new FJsonObject());
+		GyroProperties->SetObjectField(TEXT("enabled"), MakeType(TEXT("boolean")));
+		GyroProperties->SetObjectField(TEXT("linkedAction"), MakeType(TEXT("string")));
+		GyroProperties->SetObjectField(TEXT("activationAction"), MakeType(TEXT("string")));
+		TSharedPtr<FJsonObject> GyroSchema = MakeObject(GyroProperties, { TEXT("enabled") });
+
+		TSharedPtr<FJsonObject> RootProperties = MakeShareable(new FJsonObject());
+		RootProperties->SetObjectField(TEXT("actions"), MakeArray(ActionSchema, MaxActions));
+		RootProperties->SetObjectField(TEXT("gyro"), GyroSchema);
+		return MakeObject(RootProperties, { TEXT("actions") });
+	}
+
+	TSharedPtr<FJsonObject> BuildPatchSchema()
+	{
+		TArray<TSharedPtr<FJsonValue>> OpValues;
+		for (const TCHAR* Op : { TEXT("add"), TEXT("update"), TEXT("remove") })
+		{
+			OpValues.Add(MakeShareable(new FJsonValueString(Op)));
+		}
+		TSharedPtr<FJsonObject> OpSchema = MakeType(TEXT("string"));
+		OpSchema->SetArrayField(TEXT("enum"), OpValues);
+
+		TSharedPtr<FJsonObject> OperationProperties = MakeShareable(new FJsonObject());
+		OperationProperties->SetObjectField(TEXT("op"), OpSchema);
+		OperationProperties->SetObjectField(TEXT("name"), MakeType(TEXT("string")));
+		OperationProperties->SetObjectField(TEXT("action"), BuildActionSchema({}));
+		TSharedPtr<FJsonObject> OperationSchema = MakeObject(OperationProperties, { TEXT("op"), TEXT("name") });
+
+		TSharedPtr<FJsonObject> RootProperties = MakeShareable(new FJsonObject());
+		RootProperties->SetObjectField(TEXT("operations"), MakeArray(OperationSchema, MaxPatchOperations));
+		return MakeObject(RootProperties, { TEXT("operations") });
+	}
+}
+
+TSharedPtr<FJsonObject> ULLMIntentParser::GetResponseSchema(int32 MaxActions)
+{
+	// One schema per action limit in use, built on first request
+	static TMap<int32, TSharedPtr<FJsonObject>> Schemas;
+	check(IsInGameThread());
+
+	MaxActions = FMath::Clamp(MaxActions, 1, MaxResponseActionsLimit);
+	if (const TSharedPtr<FJsonObject>* Schema = Schemas.Find(MaxActions))
+	{
+		return *Schema;
 	}
+	return Schemas.Add(MaxActions, LLMSchema::BuildSchema(MaxActions));
+}
 
-	// Parse Ollama response
-	TSharedPtr<FJsonObject> JsonResponse;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+int32 ULLMIntentParser::GetSchemaTokenLimit(int32 MaxActions)
+{
+	static TMap<int32, int32> TokenLimits;
+	check(IsInGameThread());
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonResponse))
+	MaxActions = FMath::Clamp(MaxActions, 1, MaxResponseActionsLimit);
+	if (const int32* TokenLimit = TokenLimits.Find(MaxActions))
 	{
-		FString Error = TEXT("Failed to parse Ollama response JSON");
-		UE_LOG(LogInputStreamliner, Error, TEXT("%s"), *Error);
-		Callback.ExecuteIfBound(false, Error);
-		OnParseCompleted.Broadcast(false, Error);
-		return;
+		return *TokenLimit;
 	}
+	return TokenLimits.Add(MaxActions, LLMSchema::EstimateTokens(*GetResponseSchema(MaxActions)));
+}
 
-	// Extract the response field from Ollama's format
-	FString ResponseText = JsonResponse->GetStringField(TEXT("response"));
+const TSharedPtr<FJsonObject>& ULLMIntentParser::GetPatchSchema()
+{
+	static const TSharedPtr<FJsonObject> Schema = LLMSchema::BuildPatchSchema();
+	return Schema;
+}
 
-	UE_LOG(LogInputStreamliner, Verbose, TEXT("LLM Response: %s"), *ResponseText);
+int32 ULLMIntentParser::GetPatchTokenLimit()
+{
+	static const int32 TokenLimit = LLMSchema::EstimateTokens(*GetPatchSchema());
+	return TokenLimit;
+}
 
-	// Parse the JSON from the LLM response
-	FString ParseError;
-	if (!ParseJSONResponse(ResponseText, ParseError))
+FString ULLMIntentParser::BuildCompactConfiguration(const FInputStreamlinerConfiguration& Config)
+{
+	// One line per action: "Move Axis2D Movement | PC_Keyboard: W+Y S-Y | PC_Gamepad: Gamepad_LeftStick | iOS: VirtualJoystick_Fixed"
+	const UEnum* TypeEnum = StaticEnum<EInputActionType>();
+	const UEnum* PlatformEnum = StaticEnum<ETargetPlatform>();
+	const UEnum* AxisEnum = StaticEnum<EInputAxisDirection>();
+	const UEnum* TriggerEnum = StaticEnum<EInputTriggerType>();
+
+	FString Result;
+	for (const FInputActionDefinition& Action : Config.Actions)
 	{
-		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to parse LLM output: %s"), *ParseError);
-		Callback.ExecuteIfBound(false, ParseError);
-		OnParseCompleted.Broadcast(false, ParseError);
-		return;
+		Result += FString::Printf(TEXT("%s %s %s"), *Action.ActionName.ToString(),
+			*TypeEnum->GetNameStringByValue(static_cast<int64>(Action.ActionType)), *Action.Category);
+		if (!Action.bAllowRebinding)
+		{
+			Result += TEXT(" fixed");
+		}
+
+		for (const TPair<ETargetPlatform, FPlatformBindingConfig>& Platform : Action.PlatformBindings)
+		{
+			Result += FString::Printf(TEXT(" | %s:"), *PlatformEnum->GetNameStringByValue(static_cast<int64>(Platform.Key)));
+			if (!Platform.Value.TouchControlType.IsEmpty())
+			{
+				Result += TEXT(" ") + Platform.Value.TouchControlType;
+			}
+			for (const FKeyBindingDefinition& Binding : Platform.Value.Bindings)
+			{
+				Result += TEXT(" ") + Binding.Key.GetFName().ToString();
+
+				const EInputAxisDirection Direction = Binding.GetAxisDirection();
+				if (Direction != EInputAxisDirection::None)
+				{
+					Result += AxisEnum->GetDisplayNameTextByValue(static_cast<int64>(Direction)).ToString();
+				}
+				if (Binding.TriggerType != EInputTriggerType::Pressed)
+				{
+					Result += TEXT("(") + TriggerEnum->GetNameStringByValue(static_cast<int64>(Binding.TriggerType)) + TEXT(")");
+				}
+			}
+		}
+		Result += TEXT("\n");
 	}
+	return Result;
+}
 
-	UE_LOG(LogInputStreamliner, Log, TEXT("Successfully parsed %d actions from LLM response"),
-		LastParsedConfig.Actions.Num());
+const FString& ULLMIntentParser::GetPromptHash()
+{
+	static const FString PromptHash = []()
+	{
+		// The output schema shapes responses as much as the prompt does
+		FString SchemaString;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&SchemaString);
+		FJsonSerializer::Serialize(GetResponseSchema().ToSharedRef(), Writer);
 
-	Callback.ExecuteIfBound(true, TEXT(""));
-	OnParseCompleted.Broadcast(true, TEXT(""));
+		return ULLMResponseCache::HashString(GetSystemPrompt() + TEXT("\n") + GetFewShotExamples() + TEXT("\n") + SchemaString);
+	}();
+	return PromptHash;
 }
 
 FString ULLMIntentParser::BuildPrompt(const FString& UserDescription) const
@@ -153,7 +1410,7 @@ FString ULLMIntentParser::BuildPrompt(const FString& UserDescription) const
 		*UserDescription);
 }
 
-bool ULLMIntentParser::ParseJSONResponse(const FString& JSONString, FString& OutError)
+bool ULLMIntentParser::ExtractJSONObject(const FString& JSONString, TSharedPtr<FJsonObject>& OutObject, FString& OutError)
 {
 	FString WorkingString = JSONString;
 
@@ -218,113 +1475,41 @@ bool ULLMIntentParser::ParseJSONResponse(const FString& JSONString, FString& Out
 	UE_LOG(LogInputStreamliner, Log, TEXT("Extracted JSON: %s"), *CleanJSON.Left(500));
 
 	// Parse JSON
-	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CleanJSON);
 
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+	if (!FJsonSerializer::Deserialize(Reader, OutObject) || !OutObject.IsValid())
 	{
 		OutError = TEXT("Failed to parse JSON");
 		return false;
 	}
 
-	// Clear previous config
-	LastParsedConfig = FInputStreamlinerConfiguration();
+	return true;
+}
 
-	// Parse actions array
-	const TArray<TSharedPtr<FJsonValue>>* ActionsArray;
-	if (JsonObject->TryGetArrayField(TEXT("actions"), ActionsArray))
+bool ULLMIntentParser::ParseJSONResponse(const FString& JSONString, FInputStreamlinerConfiguration& OutConfig, FString& OutError) const
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	if (!ExtractJSONObject(JSONString, JsonObject, OutError))
 	{
-		for (const TSharedPtr<FJsonValue>& ActionValue : *ActionsArray)
-		{
-			TSharedPtr<FJsonObject> ActionObj = ActionValue->AsObject();
-			if (!ActionObj.IsValid()) continue;
-
-			FInputActionDefinition ActionDef;
-
-			ActionDef.ActionName = FName(*ActionObj->GetStringField(TEXT("name")));
-			ActionDef.DisplayName = ActionObj->GetStringField(TEXT("displayName"));
-			ActionDef.Category = ActionObj->GetStringField(TEXT("category"));
-			ActionDef.bAllowRebinding = ActionObj->GetBoolField(TEXT("allowRebinding"));
-
-			// Parse action type
-			FString TypeStr = ActionObj->GetStringField(TEXT("type"));
-			if (TypeStr == TEXT("Bool"))
-				ActionDef.ActionType = EInputActionType::Bool;
-			else if (TypeStr == TEXT("Axis1D"))
-				ActionDef.ActionType = EInputActionType::Axis1D;
-			else if (TypeStr == TEXT("Axis2D"))
-				ActionDef.ActionType = EInputActionType::Axis2D;
-			else if (TypeStr == TEXT("Axis3D"))
-				ActionDef.ActionType = EInputActionType::Axis3D;
-
-			// Parse bindings
-			const TSharedPtr<FJsonObject>* BindingsObj;
-			if (ActionObj->TryGetObjectField(TEXT("bindings"), BindingsObj))
-			{
-				// Parse each platform's bindings
-				for (const auto& Pair : (*BindingsObj)->Values)
-				{
-					ETargetPlatform Platform = ETargetPlatform::None;
-
-					if (Pair.Key == TEXT("PC_Keyboard"))
-						Platform = ETargetPlatform::PC_Keyboard;
-					else if (Pair.Key == TEXT("PC_Gamepad"))
-						Platform = ETargetPlatform::PC_Gamepad;
-					else if (Pair.Key == TEXT("Mac"))
-						Platform = ETargetPlatform::Mac;
-					else if (Pair.Key == TEXT("iOS"))
-						Platform = ETargetPlatform::iOS;
-					else if (Pair.Key == TEXT("Android"))
-						Platform = ETargetPlatform::Android;
-
-					if (Platform == ETargetPlatform::None) continue;
-
-					FPlatformBindingConfig PlatformConfig;
-
-					// Check if it's an array of key bindings or an object with touchControl
-					const TArray<TSharedPtr<FJsonValue>>* KeysArray;
-					const TSharedPtr<FJsonObject>* PlatformObj;
-
-					if (Pair.Value->TryGetArray(KeysArray))
-					{
-						for (const TSharedPtr<FJsonValue>& KeyValue : *KeysArray)
-						{
-							TSharedPtr<FJsonObject> KeyObj = KeyValue->AsObject();
-							if (!KeyObj.IsValid()) continue;
-
-							FKeyBindingDefinition Binding;
-							Binding.Key = FKey(*KeyObj->GetStringField(TEXT("key")));
-							Binding.AxisMapping = KeyObj->GetStringField(TEXT("axis"));
-
-							FString TriggerStr = KeyObj->GetStringField(TEXT("trigger"));
-							if (TriggerStr == TEXT("Hold"))
-								Binding.TriggerType = EInputTriggerType::Hold;
-
-							PlatformConfig.Bindings.Add(Binding);
-						}
-					}
-					else if (Pair.Value->TryGetObject(PlatformObj))
-					{
-						PlatformConfig.TouchControlType = (*PlatformObj)->GetStringField(TEXT("touchControl"));
-					}
+		return false;
+	}
 
-					ActionDef.PlatformBindings.Add(Platform, PlatformConfig);
-				}
-			}
+	FInputConfigurationDecoder::DecodeLLMConfiguration(JsonObject, OutConfig);
+	return true;
+}
 
-			LastParsedConfig.Actions.Add(ActionDef);
-		}
-	}
+bool ULLMIntentParser::DecodeJSONResponse(const FString& JSONString, FInputStreamlinerConfiguration& OutConfig, FString& OutError)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JSONString);
 
-	// Parse gyro config if present
-	const TSharedPtr<FJsonObject>* GyroObj;
-	if (JsonObject->TryGetObjectField(TEXT("gyro"), GyroObj))
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
 	{
-		LastParsedConfig.GyroConfig.bEnabled = (*GyroObj)->GetBoolField(TEXT("enabled"));
-		LastParsedConfig.GyroConfig.LinkedActionName = FName(*(*GyroObj)->GetStringField(TEXT("linkedAction")));
-		LastParsedConfig.GyroConfig.ActivationAction = FName(*(*GyroObj)->GetStringField(TEXT("activationAction")));
+		OutError = TEXT("Response does not match the output schema");
+		return false;
 	}
 
+	FInputConfigurationDecoder::DecodeLLMConfiguration(JsonObject, OutConfig);
 	return true;
 }
 
@@ -370,6 +1555,29 @@ VirtualDPad, RadialMenu, TouchRegion, GestureZone
 ONLY output valid JSON. No explanations.)");
 }
 
+FString ULLMIntentParser::GetRefinementPrompt()
+{
+	return TEXT(R"(You are an Unreal Engine 5 input configuration assistant. You change an existing input
+configuration. The current actions are listed one per line as
+"Name Type Category | Platform: keys or touch control", keys with an axis ("W+Y") or trigger ("LeftShift(Hold)").
+
+Output ONLY the changes as JSON operations:
+{
+  "operations": [
+    {"op": "add", "name": "Crouch", "action": {"name": "Crouch", "displayName": "Crouch", "type": "Bool", "category": "Movement", "allowRebinding": true, "bindings": {"PC_Keyboard": [{"key": "C"}], "PC_Gamepad": [{"key": "Gamepad_FaceButton_Right"}], "iOS": {"touchControl": "VirtualButton"}, "Android": {"touchControl": "VirtualButton"}}}},
+    {"op": "update", "name": "Jump", "action": {"bindings": {"PC_Keyboard": [{"key": "F"}]}}},
+    {"op": "remove", "name": "Sprint"}
+  ]
+}
+
+- "add" gives the complete action in the format shown.
+- "update" gives only the fields that change; a platform listed under "bindings" replaces that platform's bindings.
+- "remove" gives only the name.
+- Never repeat actions that do not change.
+
+Use Unreal Engine FKey names exactly. ONLY output valid JSON. No explanations.)");
+}
+
 FString ULLMIntentParser::GetFewShotExamples()
 {
 	return TEXT(R"(USER: basic platformer controls
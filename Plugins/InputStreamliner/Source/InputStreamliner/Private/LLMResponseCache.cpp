@@ -0,0 +1,222 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LLMResponseCache.h"
+#include "InputStreamlinerModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "JsonObjectConverter.h"
+
+FString ULLMResponseCache::MakeKey(const FString& ModelName, const FString& InPromptHash, const FString& Description, float Temperature, float TopP)
+{
+	// Field separator that cannot appear in a normalized description
+	const FString Combined = FString::Printf(TEXT("%s\n%s\n%s\n%.3f\n%.3f"),
+		*ModelName,
+		*InPromptHash,
+		*NormalizeDescription(Description),
+		Temperature,
+		TopP);
+
+	return HashString(Combined);
+}
+
+FString ULLMResponseCache::HashString(const FString& Input)
+{
+	FTCHARToUTF8 Utf8(*Input);
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Utf8.Get(), Utf8.Length(), Hash.Hash);
+	return Hash.ToString();
+}
+
+FString ULLMResponseCache::NormalizeDescription(const FString& Description)
+{
+	FString Normalized;
+	Normalized.Reserve(Description.Len());
+
+	bool bPendingSpace = false;
+	for (TCHAR c : Description.TrimStartAndEnd())
+	{
+		if (FChar::IsWhitespace(c))
+		{
+			bPendingSpace = true;
+			continue;
+		}
+
+		if (bPendingSpace)
+		{
+			Normalized.AppendChar(TEXT(' '));
+			bPendingSpace = false;
+		}
+		Normalized.AppendChar(FChar::ToLower(c));
+	}
+
+	return Normalized;
+}
+
+void ULLMResponseCache::SetPromptHash(const FString& InPromptHash)
+{
+	EnsureLoaded();
+
+	if (PromptHash == InPromptHash)
+	{
+		return;
+	}
+
+	if (Entries.Num() > 0)
+	{
+		UE_LOG(LogInputStreamliner, Log, TEXT("LLM prompt changed, invalidating %d cached responses"), Entries.Num());
+		Entries.Empty();
+	}
+
+	PromptHash = InPromptHash;
+	SaveToDisk();
+}
+
+bool ULLMResponseCache::Find(const FString& Key, FInputStreamlinerConfiguration& OutConfig)
+{
+	EnsureLoaded();
+
+	FLLMResponseCacheEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		MissCount++;
+		return false;
+	}
+
+	Entry->LastAccess = ++AccessCounter;
+	OutConfig = Entry->Configuration;
+	HitCount++;
+	return true;
+}
+
+void ULLMResponseCache::Add(const FString& Key, const FInputStreamlinerConfiguration& Config)
+{
+	EnsureLoaded();
+
+	FLLMResponseCacheEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.Key = Key;
+	Entry.Configuration = Config;
+	Entry.LastAccess = ++AccessCounter;
+
+	EvictToCapacity();
+	SaveToDisk();
+}
+
+void ULLMResponseCache::Clear()
+{
+	Entries.Empty();
+	HitCount = 0;
+	MissCount = 0;
+	bLoaded = true;
+
+	IFileManager::Get().Delete(*GetCacheFilePath(), false, false, true);
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("LLM response cache cleared"));
+}
+
+void ULLMResponseCache::SetMaxEntries(int32 InMaxEntries)
+{
+	MaxEntries = FMath::Max(1, InMaxEntries);
+
+	if (bLoaded && Entries.Num() > MaxEntries)
+	{
+		EvictToCapacity();
+		SaveToDisk();
+	}
+}
+
+FString ULLMResponseCache::GetCacheFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("InputStreamliner") / TEXT("LLMCache.json");
+}
+
+void ULLMResponseCache::EnsureLoaded()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+
+	bLoaded = true;
+
+	const FString CachePath = GetCacheFilePath();
+	if (!FPaths::FileExists(CachePath))
+	{
+		return;
+	}
+
+	FString JsonString;
+	FLLMResponseCacheFile CacheFile;
+	if (!FFileHelper::LoadFileToString(JsonString, *CachePath) ||
+		!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &CacheFile))
+	{
+		UE_LOG(LogInputStreamliner, Warning, TEXT("Failed to read LLM response cache: %s"), *CachePath);
+		return;
+	}
+
+	PromptHash = CacheFile.PromptHash;
+
+	for (FLLMResponseCacheEntry& Entry : CacheFile.Entries)
+	{
+		AccessCounter = FMath::Max(AccessCounter, Entry.LastAccess);
+		Entries.Add(Entry.Key, MoveTemp(Entry));
+	}
+
+	EvictToCapacity();
+
+	UE_LOG(LogInputStreamliner, Log, TEXT("Loaded %d cached LLM responses"), Entries.Num());
+}
+
+bool ULLMResponseCache::SaveToDisk() const
+{
+	FLLMResponseCacheFile CacheFile;
+	CacheFile.PromptHash = PromptHash;
+	Entries.GenerateValueArray(CacheFile.Entries);
+
+	FString JsonString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(CacheFile, JsonString))
+	{
+		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to serialize LLM response cache"));
+		return false;
+	}
+
+	const FString CachePath = GetCacheFilePath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(CachePath), true);
+
+	if (!FFileHelper::SaveStringToFile(JsonString, *CachePath))
+	{
+		UE_LOG(LogInputStreamliner, Error, TEXT("Failed to save LLM response cache to: %s"), *CachePath);
+		return false;
+	}
+
+	return true;
+}
+
+void ULLMResponseCache::EvictToCapacity()
+{
+	if (Entries.Num() <= MaxEntries)
+	{
+		return;
+	}
+
+	TArray<TPair<int64, FString>> ByAccess;
+	ByAccess.Reserve(Entries.Num());
+	for (const auto& Pair : Entries)
+	{
+		ByAccess.Emplace(Pair.Value.LastAccess, Pair.Key);
+	}
+
+	ByAccess.Sort([](const TPair<int64, FString>& A, const TPair<int64, FString>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	const int32 NumToEvict = Entries.Num() - MaxEntries;
+	for (int32 i = 0; i < NumToEvict; i++)
+	{
+		Entries.Remove(ByAccess[i].Value);
+	}
+
+	UE_LOG(LogInputStreamliner, Verbose, TEXT("Evicted %d LLM cache entries"), NumToEvict);
+}
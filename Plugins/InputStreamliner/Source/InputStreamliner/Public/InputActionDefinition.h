@@ -46,6 +46,21 @@ enum class EInputTriggerType : uint8
 	DoubleTap	UMETA(DisplayName = "Double Tap")
 };
 
+/**
+ * Axis component a digital key drives on an axis action
+ */
+UENUM(BlueprintType)
+enum class EInputAxisDirection : uint8
+{
+	None		UMETA(DisplayName = "None"),
+	PositiveX	UMETA(DisplayName = "+X"),
+	NegativeX	UMETA(DisplayName = "-X"),
+	PositiveY	UMETA(DisplayName = "+Y"),
+	NegativeY	UMETA(DisplayName = "-Y"),
+	PositiveZ	UMETA(DisplayName = "+Z"),
+	NegativeZ	UMETA(DisplayName = "-Z")
+};
+
 /**
  * A single key binding with optional modifiers and triggers
  */
@@ -68,6 +83,10 @@ struct INPUTSTREAMLINER_API FKeyBindingDefinition
 
 	/** For axis inputs, which axis direction this key represents */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Binding")
+	EInputAxisDirection AxisDirection = EInputAxisDirection::None;
+
+	/** Legacy text form of the axis direction ("+X", "-Y", ...), used only when AxisDirection is None */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Binding", AdvancedDisplay)
 	FString AxisMapping;
 
 	FKeyBindingDefinition()
@@ -81,6 +100,37 @@ struct INPUTSTREAMLINER_API FKeyBindingDefinition
 		, TriggerType(EInputTriggerType::Pressed)
 	{
 	}
+
+	/** Get the axis direction, falling back to the legacy AxisMapping text */
+	EInputAxisDirection GetAxisDirection() const
+	{
+		return AxisDirection != EInputAxisDirection::None ? AxisDirection : ParseAxisDirection(AxisMapping);
+	}
+
+	/** Parse "+X", "-Y", "Z" etc. into an axis direction */
+	static EInputAxisDirection ParseAxisDirection(const FString& Text)
+	{
+		const FString Trimmed = Text.TrimStartAndEnd();
+		if (Trimmed.IsEmpty())
+		{
+			return EInputAxisDirection::None;
+		}
+
+		const bool bNegative = Trimmed[0] == TEXT('-');
+		const TCHAR Axis = FChar::ToUpper(Trimmed[Trimmed.Len() - 1]);
+
+		switch (Axis)
+		{
+		case TEXT('X'):
+			return bNegative ? EInputAxisDirection::NegativeX : EInputAxisDirection::PositiveX;
+		case TEXT('Y'):
+			return bNegative ? EInputAxisDirection::NegativeY : EInputAxisDirection::PositiveY;
+		case TEXT('Z'):
+			return bNegative ? EInputAxisDirection::NegativeZ : EInputAxisDirection::PositiveZ;
+		default:
+			return EInputAxisDirection::None;
+		}
+	}
 };
 
 /**
@@ -8,6 +8,9 @@
 
 class UInputAction;
 class UInputMappingContext;
+class UInputAssetManifest;
+struct FScopedSlowTask;
+struct FInputGenerationManifest;
 
 /**
  * Generates Unreal Engine input assets from InputStreamliner configuration
@@ -52,12 +55,12 @@ public:
 		const FInputStreamlinerConfiguration& Config);
 
 	/**
-	 * Delete all previously generated input assets
-	 * @param Config The configuration containing paths
+	 * Delete the input assets recorded in the generation manifest through the editor's delete path.
+	 * Paths the configuration would produce but that were never generated are not touched.
 	 * @return Number of assets deleted
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Generation")
-	int32 CleanupGeneratedAssets(const FInputStreamlinerConfiguration& Config);
+	int32 CleanupGeneratedAssets();
 
 	/**
 	 * Check if an asset already exists at the given path
@@ -65,7 +68,75 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Input Streamliner|Generation")
 	bool DoesAssetExist(const FString& AssetPath) const;
 
+	/** Only regenerate assets whose definitions changed since the last run (default) */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Generation")
+	void SetIncrementalGeneration(bool bEnabled) { bIncrementalGeneration = bEnabled; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|Generation")
+	bool IsIncrementalGeneration() const { return bIncrementalGeneration; }
+
+	/**
+	 * Create and register the assets in memory only, for benchmarks and previews: nothing is saved,
+	 * the generation manifest is neither read nor written, and no undo transaction is recorded
+	 */
+	void SetTransientGeneration(bool bEnabled) { bTransientGeneration = bEnabled; }
+
+	/** Number of assets skipped as unchanged by the last GenerateInputAssets call */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|Generation")
+	int32 GetLastUnchangedCount() const { return LastUnchangedCount; }
+
+	/** Object path of the Input Action generated for an action */
+	static FString GetInputActionObjectPath(FName ActionName, const FString& Path);
+
+	/** Object path of the Mapping Context generated for a platform */
+	static FString GetMappingContextObjectPath(ETargetPlatform Platform, const FString& Path);
+
+	/** Object path of the runtime asset manifest, next to the Mapping Contexts */
+	static FString GetRuntimeManifestObjectPath(const FString& Path);
+
+	/** Keys an action is registered with for rebinding: its keyboard/mouse bindings, then its gamepad bindings, with key aliases resolved */
+	static TArray<FKey> GetDefaultKeys(const FInputActionDefinition& Definition);
+
 private:
+	/** Create or update an Input Action in memory without registering or saving it */
+	UInputAction* CreateInputActionObject(const FInputActionDefinition& Definition, const FString& Path, bool& bOutIsNew);
+
+	/** Create or rebuild a Mapping Context in memory without registering or saving it */
+	UInputMappingContext* CreateMappingContextObject(
+		ETargetPlatform Platform,
+		const TArray<const FInputActionDefinition*>& Actions,
+		const FString& Path,
+		const FInputStreamlinerConfiguration& Config,
+		bool& bOutIsNew);
+
+	/** Create or rebuild the runtime asset manifest in memory from the assets recorded for this run */
+	UInputAssetManifest* CreateRuntimeManifestObject(
+		const FInputStreamlinerConfiguration& Config,
+		const FInputGenerationManifest& Manifest,
+		bool& bOutIsNew);
+
+	/** Point the runtime project settings at the manifest so it is preloaded at startup */
+	void RegisterRuntimeManifest(const FString& ObjectPath);
+
+	/** Find the Input Action for a name, generated this run or loaded from disk */
+	UInputAction* ResolveInputAction(FName ActionName, const FInputStreamlinerConfiguration& Config);
+
+	/** Save the packages of the given assets in one pass; returns the number saved, stopping early if the user cancels */
+	int32 SaveAssets(const TArray<UObject*>& Assets, FScopedSlowTask* SlowTask, bool* bOutCancelled = nullptr);
+
+	/**
+	 * Delete the existing assets among the given object paths in batches without loading them: loaded assets
+	 * go through ObjectTools, which checks references and source control, the rest are deleted by package file;
+	 * returns the number deleted
+	 */
+	int32 DeleteAssets(const TArray<FString>& ObjectPaths, FScopedSlowTask* SlowTask, TSet<FString>* OutDeletedPaths = nullptr);
+
+	/**
+	 * Delete packages that are not loaded by file, through source control when it is enabled, and drop them from the asset registry.
+	 * Packages referenced from outside DeletingPackages are kept.
+	 */
+	void DeleteUnloadedPackages(const TArray<FName>& PackageNames, const TSet<FName>& DeletingPackages);
+
 	/** Configure triggers and modifiers on an Input Action based on the definition */
 	void ConfigureActionTriggers(UInputAction* Action, const FInputActionDefinition& Definition);
 
@@ -82,4 +153,10 @@ private:
 	/** Map of generated actions by name for quick lookup */
 	UPROPERTY(Transient)
 	TMap<FName, UInputAction*> GeneratedActions;
+
+	bool bIncrementalGeneration = true;
+
+	bool bTransientGeneration = false;
+
+	int32 LastUnchangedCount = 0;
 };
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FInputStreamlinerConfiguration;
+
+/**
+ * Writes the C++ action table for a configuration (code generation set to C++ or Both).
+ * The header declares {Prefix}Input::EAction with one value per action in configuration order,
+ * constexpr arrays of asset paths and default keys, and GetActionTable() returning an FInputActionTable.
+ */
+class INPUTSTREAMLINER_API FInputCodeGenerator
+{
+public:
+	/** Absolute path of the action table header: Source/{GeneratedCodePath}/{Prefix}InputActions.h */
+	static FString GetActionTableHeaderPath(const FInputStreamlinerConfiguration& Config);
+
+	/** Build the header source for the configuration and the mapping contexts it generated */
+	static FString BuildActionTableHeader(const FInputStreamlinerConfiguration& Config, const TArray<FString>& MappingContextPaths);
+
+	/** Write the header, leaving the file untouched when its contents did not change so nothing recompiles */
+	static bool WriteActionTableHeader(const FInputStreamlinerConfiguration& Config, const TArray<FString>& MappingContextPaths);
+
+	/** Turn a name into a valid C++ identifier, avoiding keywords and names reserved to the implementation */
+	static FString MakeIdentifier(const FString& Name);
+};
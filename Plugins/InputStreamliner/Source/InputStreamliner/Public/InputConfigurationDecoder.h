@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionDefinition.h"
+
+class FJsonObject;
+class FJsonValue;
+struct FInputStreamlinerConfiguration;
+struct FInputConfigurationPatch;
+
+/**
+ * Fast JSON decoding for configurations.
+ * Actions are decoded in parallel with table-driven enum lookups instead of reflection;
+ * InputStreamliner.FastConfigDecode 0 switches back to FJsonObjectConverter for comparison.
+ */
+class INPUTSTREAMLINER_API FInputConfigurationDecoder
+{
+public:
+	/** Decode a configuration written by FJsonObjectConverter (Configuration.json, clipboard export) */
+	static bool DecodeConfiguration(const FString& JsonString, FInputStreamlinerConfiguration& OutConfig, FString& OutError);
+
+	/** Decode the LLM output schema ({"actions": [...], "gyro": {...}}) */
+	static void DecodeLLMConfiguration(const TSharedPtr<FJsonObject>& JsonObject, FInputStreamlinerConfiguration& OutConfig);
+
+	/**
+	 * Decode a refinement patch ({"operations": [{"op": "add|update|remove", "name": ..., "action": {...}}]}).
+	 * Update operations record only the fields the model sent; updates of actions BaseConfig does not have are skipped.
+	 */
+	static void DecodeLLMPatch(const TSharedPtr<FJsonObject>& JsonObject, const FInputStreamlinerConfiguration& BaseConfig, FInputConfigurationPatch& OutPatch);
+
+	/** Decode a single action in the LLM output schema */
+	static bool DecodeLLMAction(const TSharedPtr<FJsonObject>& ActionObj, FInputActionDefinition& OutAction);
+
+	/** Enum lookups by name (case-insensitive, "EnumName::" prefix allowed) */
+	static bool FindActionType(const FString& Name, EInputActionType& OutType);
+	static bool FindPlatform(const FString& Name, ETargetPlatform& OutPlatform);
+	static bool FindTriggerType(const FString& Name, EInputTriggerType& OutTrigger);
+	static bool FindAxisDirection(const FString& Name, EInputAxisDirection& OutDirection);
+
+private:
+	/** Decode a single action in the FJsonObjectConverter layout */
+	static bool DecodeSavedAction(const TSharedPtr<FJsonObject>& ActionObj, FInputActionDefinition& OutAction);
+
+	/** Decode actions in parallel, dropping invalid entries while keeping order */
+	static void DecodeActions(const TArray<TSharedPtr<FJsonValue>>& ActionValues, bool bSavedLayout, TArray<FInputActionDefinition>& OutActions);
+};
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionDefinition.h"
+#include "InputConfigurationPatch.generated.h"
+
+/**
+ * Kind of change a patch operation makes
+ */
+UENUM(BlueprintType)
+enum class EInputPatchOperationType : uint8
+{
+	Add,
+	Update,
+	Remove
+};
+
+/**
+ * Fields of an action an update operation changes
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EInputPatchField : uint8
+{
+	None				= 0 UMETA(Hidden),
+	ActionName			= 1 << 0,
+	DisplayName			= 1 << 1,
+	Category			= 1 << 2,
+	ActionType			= 1 << 3,
+	AllowRebinding		= 1 << 4,
+	/** The bindings of the platforms present in the operation's PlatformBindings */
+	PlatformBindings	= 1 << 5
+};
+ENUM_CLASS_FLAGS(EInputPatchField);
+
+/**
+ * A single change to the actions of a configuration
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINER_API FInputPatchOperation
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch")
+	EInputPatchOperationType Operation = EInputPatchOperationType::Add;
+
+	/** Action the operation targets */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch")
+	FName ActionName;
+
+	/** Complete definition for Add; for Update, only the fields in UpdatedFields are meaningful */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch")
+	FInputActionDefinition Action;
+
+	/** EInputPatchField flags of the fields an Update changes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch", meta = (Bitmask, BitmaskEnum = "/Script/InputStreamliner.EInputPatchField"))
+	int32 UpdatedFields = 0;
+
+	/** Check if an Update changes a field */
+	bool UpdatesField(EInputPatchField Field) const { return (UpdatedFields & static_cast<int32>(Field)) != 0; }
+
+	/** Write the fields an Update changes onto an action, leaving the others as they are */
+	void ApplyUpdate(FInputActionDefinition& Target) const;
+};
+
+/**
+ * Ordered list of changes produced by a refinement request
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINER_API FInputConfigurationPatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Patch")
+	TArray<FInputPatchOperation> Operations;
+
+	bool IsEmpty() const { return Operations.Num() == 0; }
+};
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionDefinition.h"
+#include "InputGenerationManifest.generated.h"
+
+/**
+ * A generated asset and the hash of the definition it was generated from
+ */
+USTRUCT()
+struct INPUTSTREAMLINER_API FGeneratedAssetRecord
+{
+	GENERATED_BODY()
+
+	/** Object path of the generated asset */
+	UPROPERTY()
+	FString AssetPath;
+
+	/** Hash of the inputs that produced the asset */
+	UPROPERTY()
+	FString ContentHash;
+};
+
+/**
+ * Record of the assets produced by the last generation, used for incremental regeneration.
+ * Stored next to Configuration.json.
+ */
+USTRUCT()
+struct INPUTSTREAMLINER_API FInputGenerationManifest
+{
+	GENERATED_BODY()
+
+	/** Bump when generation output changes so every asset is regenerated once */
+	static constexpr int32 CurrentVersion = 1;
+
+	UPROPERTY()
+	int32 Version = CurrentVersion;
+
+	/** Generated Input Actions by action name */
+	UPROPERTY()
+	TMap<FName, FGeneratedAssetRecord> Actions;
+
+	/** Generated Mapping Contexts by platform name */
+	UPROPERTY()
+	TMap<FString, FGeneratedAssetRecord> MappingContexts;
+
+	/** The UInputAssetManifest data asset the runtime preloads */
+	UPROPERTY()
+	FGeneratedAssetRecord RuntimeManifest;
+
+	/** Path to the manifest file */
+	static FString GetManifestPath();
+
+	/** Load the manifest; an outdated or unreadable manifest loads as empty */
+	bool LoadFromDisk();
+
+	/** Write the manifest */
+	bool SaveToDisk() const;
+
+	/** Delete the manifest file */
+	static void DeleteFromDisk();
+
+	/** Object paths of every recorded asset */
+	TArray<FString> GetAllAssetPaths() const;
+
+	/** Hash of the parts of a definition that affect its Input Action asset */
+	static FString HashActionDefinition(const FInputActionDefinition& Definition);
+
+	/** Hash of everything that affects a platform's Mapping Context */
+	static FString HashMappingContext(ETargetPlatform Platform, const TArray<const FInputActionDefinition*>& Actions, const FString& InputActionsPath);
+
+	/** Hash of everything that affects the runtime asset manifest */
+	static FString HashRuntimeManifest(const TArray<FInputActionDefinition>& Actions, const FString& InputActionsPath, const TArray<FString>& MappingContextPaths);
+};
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputStreamlinerConfiguration.h"
+#include "InputIntentMatcher.generated.h"
+
+/**
+ * A known description and the configuration it resolves to
+ */
+USTRUCT()
+struct INPUTSTREAMLINER_API FInputIntentTemplate
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	/** Description text and extra keywords the template is matched on */
+	UPROPERTY()
+	FString Description;
+
+	UPROPERTY()
+	FInputStreamlinerConfiguration Configuration;
+
+	/** Normalized terms of the description, action names and bound keys */
+	TSet<FString> Terms;
+};
+
+/**
+ * Local lexical matcher that resolves common descriptions without the LLM.
+ * Confidence is the share of the description's term weight (inverse template frequency)
+ * that the best template covers, so unknown or extra requirements lower it.
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINER_API UInputIntentMatcher : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Lower-case, split and stem a description into match terms, dropping filler words */
+	static TArray<FString> Tokenize(const FString& Text);
+
+	/** Add a template; terms are taken from the description and the configuration's actions and keys */
+	void AddTemplate(const FString& Name, const FString& Description, const FInputStreamlinerConfiguration& Configuration);
+
+	/** Add a template whose configuration is in the LLM output format */
+	bool AddTemplateFromJSON(const FString& Name, const FString& Description, const FString& ConfigurationJSON);
+
+	/** Add the curated genre presets */
+	void AddBuiltInPresets();
+
+	/**
+	 * Find the template that best covers a description.
+	 * Returns the confidence in [0, 1]; ties between templates halve it.
+	 */
+	float Match(const FString& Description, FInputStreamlinerConfiguration& OutConfig, FString& OutTemplateName) const;
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|Intent Matcher")
+	int32 GetNumTemplates() const { return Templates.Num(); }
+
+	/** Remove every template */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Intent Matcher")
+	void ClearTemplates();
+
+private:
+	/** Recompute term weights after the template set changed */
+	void RebuildWeights();
+
+	/** Weight of a term; terms no template contains weigh the most */
+	float GetTermWeight(const FString& Term) const;
+
+	UPROPERTY()
+	TArray<FInputIntentTemplate> Templates;
+
+	/** Inverse template frequency of every known term */
+	TMap<FString, float> TermWeights;
+
+	/** Weight of a term that appears in no template */
+	float UnknownTermWeight = 1.0f;
+};
@@ -18,6 +18,49 @@ enum class ECodeGenerationType : uint8
 	Both			UMETA(DisplayName = "Both C++ and Blueprint")
 };
 
+struct FInputStreamlinerConfiguration;
+
+/**
+ * Lookup tables over a configuration's actions and touch controls.
+ * Stores indices into the arrays, so it must be rebuilt after they change.
+ */
+struct INPUTSTREAMLINER_API FInputConfigurationIndex
+{
+	/** One slot per ETargetPlatform bit */
+	static constexpr int32 NumPlatformSlots = 8;
+
+	/** Action index by action name */
+	TMap<FName, int32> ActionIndexByName;
+
+	/** Indices of the actions targeting each platform, in action order */
+	TArray<int32> ActionsByPlatform[NumPlatformSlots];
+
+	/** Touch control index by control name */
+	TMap<FName, int32> TouchControlIndexByName;
+
+	/** Indices of the touch controls linked to each action */
+	TMap<FName, TArray<int32>> TouchControlsByAction;
+
+	/** Array sizes the index was built for, or INDEX_NONE if never built */
+	int32 NumIndexedActions = INDEX_NONE;
+	int32 NumIndexedTouchControls = INDEX_NONE;
+
+	/** Configuration modification count the index was built at */
+	uint32 IndexedModificationCount = 0;
+
+	/** Rebuild every table from the configuration */
+	void Build(const FInputStreamlinerConfiguration& Config);
+
+	/** Clear every table */
+	void Reset();
+
+	/** Get the actions targeting a single platform */
+	const TArray<int32>& GetActionsForPlatform(ETargetPlatform Platform) const;
+
+	/** Get the slot used for a single platform flag */
+	static int32 GetPlatformSlot(ETargetPlatform Platform);
+};
+
 /**
  * Complete configuration for Input Streamliner
  * Contains all input actions, touch controls, and generation settings
@@ -93,6 +136,14 @@ struct INPUTSTREAMLINER_API FInputStreamlinerConfiguration
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM")
 	FString LLMModelName = TEXT("llama3.2:3b-instruct-q3_k_m");
 
+	/** How long Ollama keeps the model loaded after a request (e.g. "30m", "-1" for forever) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM")
+	FString LLMKeepAlive = TEXT("30m");
+
+	/** Most actions the model may return for one description; longer descriptions are cut short with a warning */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LLM", meta = (ClampMin = "1", ClampMax = "128"))
+	int32 LLMMaxActions = 32;
+
 	FInputStreamlinerConfiguration()
 		: ProjectPrefix(TEXT("Game"))
 		, CodeGenType(ECodeGenerationType::Blueprint)
@@ -106,27 +157,84 @@ struct INPUTSTREAMLINER_API FInputStreamlinerConfiguration
 		, LLMEndpointURL(TEXT("http://localhost"))
 		, LLMEndpointPort(11434)
 		, LLMModelName(TEXT("llama3.2:3b-instruct-q3_k_m"))
+		, LLMKeepAlive(TEXT("30m"))
+		, LLMMaxActions(32)
 	{
 	}
 
-	/** Find an action by name */
-	FInputActionDefinition* FindAction(FName ActionName)
+	/**
+	 * Rebuild the lookup index. Call after modifying Actions or TouchControls directly;
+	 * UInputStreamlinerManager does this on every change.
+	 */
+	void RebuildIndex() { Index.Build(*this); }
+
+	/** Record a change to Actions or TouchControls, so the index stops being trusted until the next rebuild */
+	void MarkModified() { ++ModificationCount; }
+
+	/** Number of changes recorded with MarkModified */
+	uint32 GetModificationCount() const { return ModificationCount; }
+
+	/** Check if the lookup index was built for the current arrays and no change was recorded since */
+	bool IsIndexValid() const
 	{
-		return Actions.FindByPredicate([ActionName](const FInputActionDefinition& Action)
+		return Index.IndexedModificationCount == ModificationCount
+			&& Index.NumIndexedActions == Actions.Num() && Index.NumIndexedTouchControls == TouchControls.Num();
+	}
+
+	/** Get the lookup index (check IsIndexValid first) */
+	const FInputConfigurationIndex& GetIndex() const { return Index; }
+
+	/** Find the index of an action by name */
+	int32 FindActionIndex(FName ActionName) const
+	{
+		if (IsIndexValid())
+		{
+			const int32* Found = Index.ActionIndexByName.Find(ActionName);
+			if (Found && Actions[*Found].ActionName == ActionName)
+			{
+				return *Found;
+			}
+		}
+
+		// Index missing, stale or missed by an unrecorded edit (a rename through a found pointer)
+		return Actions.IndexOfByPredicate([ActionName](const FInputActionDefinition& Action)
 		{
 			return Action.ActionName == ActionName;
 		});
 	}
 
-	/** Find an action by name (const version) */
-	const FInputActionDefinition* FindAction(FName ActionName) const
+	/** Find the index of a touch control by name */
+	int32 FindTouchControlIndex(FName ControlName) const
 	{
-		return Actions.FindByPredicate([ActionName](const FInputActionDefinition& Action)
+		if (IsIndexValid())
 		{
-			return Action.ActionName == ActionName;
+			const int32* Found = Index.TouchControlIndexByName.Find(ControlName);
+			if (Found && TouchControls[*Found].ControlName == ControlName)
+			{
+				return *Found;
+			}
+		}
+
+		return TouchControls.IndexOfByPredicate([ControlName](const FTouchControlDefinition& Control)
+		{
+			return Control.ControlName == ControlName;
 		});
 	}
 
+	/** Find an action by name */
+	FInputActionDefinition* FindAction(FName ActionName)
+	{
+		const int32 ActionIndex = FindActionIndex(ActionName);
+		return ActionIndex != INDEX_NONE ? &Actions[ActionIndex] : nullptr;
+	}
+
+	/** Find an action by name (const version) */
+	const FInputActionDefinition* FindAction(FName ActionName) const
+	{
+		const int32 ActionIndex = FindActionIndex(ActionName);
+		return ActionIndex != INDEX_NONE ? &Actions[ActionIndex] : nullptr;
+	}
+
 	/** Check if an action name exists */
 	bool HasAction(FName ActionName) const
 	{
@@ -171,4 +279,11 @@ struct INPUTSTREAMLINER_API FInputStreamlinerConfiguration
 		Categories.Sort();
 		return Categories;
 	}
+
+private:
+	/** Lookup tables, rebuilt by RebuildIndex */
+	FInputConfigurationIndex Index;
+
+	/** Bumped by MarkModified on every change to the arrays */
+	uint32 ModificationCount = 0;
 };
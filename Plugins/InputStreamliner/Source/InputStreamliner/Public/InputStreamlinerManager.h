@@ -5,12 +5,17 @@
 #include "CoreMinimal.h"
 #include "EditorSubsystem.h"
 #include "InputStreamlinerConfiguration.h"
+#include "InputConfigurationPatch.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "InputStreamlinerManager.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActionAdded, FName, ActionName);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActionRemoved, FName, ActionName);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActionUpdated, FName, ActionName);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnConfigurationChanged);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnConfigurationSaved, bool, bSuccess);
 
 /**
  * Editor subsystem that manages the Input Streamliner configuration
@@ -27,6 +32,10 @@ public:
 	virtual void Deinitialize() override;
 	//~ End UEditorSubsystem Interface
 
+	//~ Begin UObject Interface
+	virtual void PostEditUndo() override;
+	//~ End UObject Interface
+
 	// Action Management
 
 	/** Add a new input action to the configuration */
@@ -55,6 +64,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Management")
 	void RemoveAllActions();
 
+	/**
+	 * Apply a refinement patch through AddInputAction, UpdateInputAction and RemoveInputAction as one undoable change,
+	 * leaving every action it does not mention untouched. Updates write their changed fields onto the action as it is now,
+	 * so edits made since the request keep every field the patch does not change. Returns the number of operations applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Management")
+	int32 ApplyConfigurationPatch(const FInputConfigurationPatch& Patch);
+
 	/** Import actions from an existing Input Mapping Context */
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Management")
 	void ImportActionsFromContext(class UInputMappingContext* ExistingContext);
@@ -73,6 +90,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Touch")
 	bool UpdateTouchControl(FName ControlName, const FTouchControlDefinition& UpdatedControl);
 
+	// Gyro
+
+	/** Replace the gyro configuration */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Gyro")
+	void SetGyroConfiguration(const FGyroConfiguration& GyroConfig);
+
 	// Accessors
 
 	/** Get the current configuration */
@@ -102,9 +125,26 @@ public:
 
 	// Persistence
 
-	/** Save configuration to disk */
+	/**
+	 * Snapshot the configuration and write it to disk on a background task; OnConfigurationSaved reports the result.
+	 * Changes are also autosaved InputStreamliner.ConfigAutosaveDelay seconds after the last edit.
+	 * @param bWaitForWrite Block until the file is written instead of returning once the write is queued
+	 * @return With bWaitForWrite, whether the file now holds the configuration; otherwise true once the write is queued
+	 * or the file is already up to date
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Persistence")
+	bool SaveConfiguration(bool bWaitForWrite = false);
+
+	/** Write a pending autosave now instead of after the delay */
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Persistence")
-	bool SaveConfiguration();
+	void FlushAutosave();
+
+	/** Check if an edit is waiting for the autosave delay */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|Persistence")
+	bool IsAutosavePending() const { return AutosaveHandle.IsValid(); }
+
+	/** Block until background writes have finished */
+	void WaitForPendingSave();
 
 	/** Load configuration from disk */
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|Persistence")
@@ -132,14 +172,49 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Input Streamliner|Events")
 	FOnConfigurationChanged OnConfigurationChanged;
 
+	/** Called on the game thread when a queued configuration write finishes or fails; skipped and superseded writes are not reported */
+	UPROPERTY(BlueprintAssignable, Category = "Input Streamliner|Events")
+	FOnConfigurationSaved OnConfigurationSaved;
+
 private:
 	/** Current configuration */
 	UPROPERTY()
 	FInputStreamlinerConfiguration CurrentConfig;
 
-	/** Notify listeners that the configuration has changed */
+	/** Notify listeners that the configuration has changed, or note it for the end of a batch */
 	void NotifyConfigurationChanged();
 
+	/** Set while a patch is applied, so listeners are notified once for the whole patch */
+	bool bBatchingChanges = false;
+
+	/** A change was made while batching */
+	bool bChangedDuringBatch = false;
+
+	/** Restart the autosave delay */
+	void ScheduleAutosave();
+
+	/** Cancel a pending autosave */
+	void CancelAutosave();
+
+	bool HandleAutosave(float DeltaTime);
+
+	/** Incremented on every change */
+	uint64 ConfigGeneration = 0;
+
+	/** Generation of the newest snapshot queued for writing; older snapshots still queued are dropped */
+	std::atomic<uint64> QueuedGeneration = 0;
+
+	/** Whether the file holds (or will hold) QueuedGeneration */
+	bool bHasQueuedGeneration = false;
+
+	/** Set by the background write when it fails, so the next save retries */
+	std::atomic<bool> bLastSaveFailed = false;
+
+	FTSTicker::FDelegateHandle AutosaveHandle;
+
+	/** Most recent background write; each write waits for the previous one */
+	UE::Tasks::FTask PendingSaveTask;
+
 	/** Generate a unique action name based on a base name */
 	FName GenerateUniqueActionName(const FString& BaseName) const;
 };
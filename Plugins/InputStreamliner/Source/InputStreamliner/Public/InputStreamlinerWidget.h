@@ -7,7 +7,6 @@
 #include "InputStreamlinerConfiguration.h"
 #include "InputActionDefinition.h"
 #include "TouchControlDefinition.h"
-#include "Interfaces/IHttpRequest.h"
 #include "InputStreamlinerWidget.generated.h"
 
 class ULLMIntentParser;
@@ -27,6 +26,30 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLLMParseComplete, bool, bSuccess
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGenerationComplete, bool, bSuccess, const FString&, Message);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActionSelected, const FInputActionDefinition&, Action);
 
+/**
+ * Widgets of one row in the actions list, with the values they currently display
+ */
+USTRUCT()
+struct FInputStreamlinerActionRow
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UHorizontalBox> Row;
+
+	UPROPERTY()
+	TObjectPtr<UTextBlock> NameText;
+
+	UPROPERTY()
+	TObjectPtr<UTextBlock> TypeText;
+
+	/** Action name shown in NameText */
+	FName ActionName;
+
+	/** Action type shown in TypeText */
+	EInputActionType ActionType = EInputActionType::Bool;
+};
+
 /**
  * Base class for the Input Streamliner Editor Widget
  * Provides core functionality for the natural language input configuration tool
@@ -260,26 +283,48 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UInputAssetGenerator> AssetGenerator;
 
-	/** Called when LLM parsing completes */
+	/** Called when a parse request completes, fails or is cancelled; merges the result of this widget's requests */
+	UFUNCTION()
+	void HandleLLMParseRequestComplete(int32 RequestId, bool bSuccess, const FString& ErrorMessage);
+
+	/** Called in streaming mode as each parsed action arrives; shown as a preview row until its request completes */
 	UFUNCTION()
-	void HandleLLMParseComplete(bool bSuccess, const FString& ErrorMessage);
+	void HandleLLMActionParsed(int32 RequestId, const FInputActionDefinition& Action);
+
+	/** Remove the preview rows of a request that are not backed by an action in the configuration */
+	void DiscardStreamedRows(int32 RequestId);
 
 	/** Called when LLM connection test completes */
 	UFUNCTION()
 	void HandleConnectionTestComplete(bool bSuccess, const FString& ErrorMessage);
 
-	/** Broadcast configuration update */
-	void BroadcastConfigurationUpdate();
+	/** Broadcast configuration update; pass false when the caller already updated the affected rows */
+	void BroadcastConfigurationUpdate(bool bRefreshActionsList = true);
 
 	/** Build the UI programmatically */
 	void BuildUI();
 
-	/** Refresh the actions list display */
+	/** Sync the actions list with the configuration, only touching rows that changed */
 	void RefreshActionsList();
 
+	/** Create the row for an action and append it to the list */
+	void AddActionRow(const FInputActionDefinition& Action);
+
+	/** Update the row of an action, re-keying it if the action was renamed */
+	void UpdateActionRow(FName ActionName, const FInputActionDefinition& Action);
+
+	/** Remove the row of an action */
+	void RemoveActionRow(FName ActionName);
+
+	/** Show the placeholder text only while there are no actions */
+	void UpdateEmptyActionsText();
+
 	/** Update status text */
 	void SetStatusText(const FString& Text, FLinearColor Color = FLinearColor::White);
 
+	/** Update the LLM cache hit/miss display */
+	void RefreshCacheStats();
+
 	// UI Button handlers
 	UFUNCTION()
 	void OnParseButtonClicked();
@@ -306,7 +351,8 @@ protected:
 	void RefreshModelList();
 
 	/** Handle model list response from Ollama */
-	void OnModelListReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	UFUNCTION()
+	void HandleModelListReceived(bool bSuccess, const TArray<FString>& Models, const FString& ErrorMessage);
 
 	// ==================== UI Elements ====================
 
@@ -323,9 +369,29 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UVerticalBox> ActionsListBox;
 
+	/** Placeholder shown below the list when there are no actions */
+	UPROPERTY()
+	TObjectPtr<UTextBlock> EmptyActionsText;
+
+	/** Rows of the actions list, keyed by action name */
+	UPROPERTY()
+	TMap<FName, FInputStreamlinerActionRow> ActionRows;
+
+	/** Action names in the order their rows appear in ActionsListBox */
+	TArray<FName> ActionRowOrder;
+
+	/** Parse requests started by this widget and the preview rows each one added */
+	TMap<int32, TArray<FName>> StreamedRowsByRequest;
+
+	/** Font shared by every row of the actions list */
+	FSlateFontInfo ActionRowFont;
+
 	UPROPERTY()
 	TObjectPtr<UTextBlock> StatusText;
 
+	UPROPERTY()
+	TObjectPtr<UTextBlock> CacheStatsText;
+
 	UPROPERTY()
 	TObjectPtr<UEditableTextBox> ProjectPrefixInput;
 
@@ -4,11 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "InputStreamlinerConfiguration.h"
+#include "InputConfigurationPatch.h"
 #include "Interfaces/IHttpRequest.h"
 #include "LLMIntentParser.generated.h"
 
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnParseComplete, bool, bSuccess, const FString&, ErrorMessage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnParseCompleteMulticast, bool, bSuccess, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnActionParsed, int32, RequestId, const FInputActionDefinition&, Action);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnParseRequestComplete, int32, RequestId, bool, bSuccess, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnParseRequestRefined, int32, RequestId, bool, bSuccess, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnModelListReceived, bool, bSuccess, const TArray<FString>&, Models, const FString&, ErrorMessage);
+
+class FJsonObject;
+class FJsonValue;
+class ULLMResponseCache;
+class UInputIntentMatcher;
+struct FLLMStreamState;
+struct FLLMParseRequest;
+
+/**
+ * Lifecycle state of a queued parse request
+ */
+UENUM(BlueprintType)
+enum class ELLMParseRequestState : uint8
+{
+	/** Unknown or released handle */
+	None,
+	/** Waiting for a free request slot */
+	Queued,
+	/** Sent to the LLM, awaiting the response */
+	InFlight,
+	Succeeded,
+	Failed,
+	Cancelled
+};
 
 /**
  * Handles parsing natural language input descriptions using a local LLM (Ollama)
@@ -31,23 +60,212 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
 	void SetModel(const FString& ModelName);
 
+	/** Enable or disable streaming mode (actions are reported while the response is still being generated) */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetStreamingEnabled(bool bEnabled) { bStreamingEnabled = bEnabled; }
+
+	/** Check if streaming mode is enabled */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsStreamingEnabled() const { return bStreamingEnabled; }
+
+	/**
+	 * Enable or disable session mode. Session mode uses /api/chat with a fixed system and
+	 * few-shot message prefix so Ollama can reuse the evaluated prefix between requests.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetChatSessionEnabled(bool bEnabled) { bUseChatSession = bEnabled; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsChatSessionEnabled() const { return bUseChatSession; }
+
+	/** Set how long Ollama keeps the model loaded after each request (Ollama duration string) */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetKeepAlive(const FString& InKeepAlive) { KeepAlive = InKeepAlive; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	FString GetKeepAlive() const { return KeepAlive; }
+
+	/** Load the model and evaluate the static prompt prefix ahead of the first parse */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void WarmUpModel();
+
+	/**
+	 * Enable or disable schema-constrained output. The request carries a JSON schema in
+	 * Ollama's "format" field, so the response is always decodable JSON and generation
+	 * length is capped to what the schema allows.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetSchemaFormatEnabled(bool bEnabled) { bUseSchemaFormat = bEnabled; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsSchemaFormatEnabled() const { return bUseSchemaFormat; }
+
+	/** Default and largest number of actions a single response may contain */
+	static constexpr int32 DefaultMaxResponseActions = 32;
+	static constexpr int32 MaxResponseActionsLimit = 128;
+
+	/**
+	 * Set how many actions a response may contain. The schema caps the actions array at this size,
+	 * so a description with more actions is cut short; such results are reported by DidReachActionLimit.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetMaxResponseActions(int32 InMaxActions) { MaxResponseActions = FMath::Clamp(InMaxActions, 1, MaxResponseActionsLimit); }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	int32 GetMaxResponseActions() const { return MaxResponseActions; }
+
+	/** Get the JSON schema sent in schema format mode */
+	static TSharedPtr<FJsonObject> GetResponseSchema(int32 MaxActions = DefaultMaxResponseActions);
+
+	/** Upper bound on generated tokens for a response that matches the schema */
+	static int32 GetSchemaTokenLimit(int32 MaxActions = DefaultMaxResponseActions);
+
+	/** Enable or disable the persistent response cache */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetCacheEnabled(bool bEnabled) { bCacheEnabled = bEnabled; }
+
+	/** Check if the persistent response cache is enabled */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsCacheEnabled() const { return bCacheEnabled; }
+
+	/** Get the response cache */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	ULLMResponseCache* GetResponseCache() const { return ResponseCache; }
+
+	/**
+	 * Enable or disable local matching. Descriptions that a built-in template covers with at least
+	 * the local match threshold are answered without the LLM.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetLocalMatchingEnabled(bool bEnabled) { bLocalMatchingEnabled = bEnabled; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsLocalMatchingEnabled() const { return bLocalMatchingEnabled; }
+
+	/** Set the confidence (0-1) a template match needs to skip the LLM */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetLocalMatchThreshold(float Threshold) { LocalMatchThreshold = FMath::Clamp(Threshold, 0.0f, 1.0f); }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	float GetLocalMatchThreshold() const { return LocalMatchThreshold; }
+
+	/** Set the confidence (0-1) a template match needs to be used when the LLM cannot be reached */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetOfflineMatchThreshold(float Threshold) { OfflineMatchThreshold = FMath::Clamp(Threshold, 0.0f, 1.0f); }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	float GetOfflineMatchThreshold() const { return OfflineMatchThreshold; }
+
+	/**
+	 * Enable or disable background refinement. A locally matched request is also sent to the LLM
+	 * at lower priority; OnParseRequestRefined reports the LLM's result under the original request id.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetLocalRefinementEnabled(bool bEnabled) { bRefineLocalMatches = bEnabled; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsLocalRefinementEnabled() const { return bRefineLocalMatches; }
+
+	/** Get the template matcher; add project templates to it before parsing */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	UInputIntentMatcher* GetIntentMatcher();
+
+	/** Set how many parse requests may be in flight at once (match OLLAMA_NUM_PARALLEL) */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void SetMaxConcurrentRequests(int32 InMaxConcurrentRequests);
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	int32 GetMaxConcurrentRequests() const { return MaxConcurrentRequests; }
+
 	/** Check if the LLM endpoint is reachable */
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
 	void CheckConnection(FOnParseComplete OnComplete);
 
+	/** Fetch the names of the models installed on the endpoint */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void FetchAvailableModels(FOnModelListReceived OnComplete);
+
 	// Parsing
 
-	/** Parse a natural language description asynchronously */
+	/** Parse a natural language description asynchronously; the result is available from GetLastParsedConfiguration */
 	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
 	void ParseInputDescriptionAsync(const FString& Description, FOnParseComplete OnComplete);
 
+	/**
+	 * Queue a parse request and return its handle.
+	 * Higher priority requests are sent first; the result is kept until ReleaseParseRequest.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	int32 SubmitParseRequest(const FString& Description, FOnParseComplete OnComplete, int32 Priority = 0);
+
+	/**
+	 * Queue a refinement request ("also add a crouch on C"). The configuration is sent in a compact
+	 * form and the model answers with add/update/remove operations, so output length scales with the
+	 * change rather than the configuration. Apply the result with UInputStreamlinerManager::ApplyConfigurationPatch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	int32 SubmitRefinementRequest(const FInputStreamlinerConfiguration& CurrentConfig, const FString& Instruction, FOnParseComplete OnComplete, int32 Priority = 0);
+
+	/** Get the patch of a completed refinement request */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	bool GetPatchResult(int32 RequestId, FInputConfigurationPatch& OutPatch, FString& OutError) const;
+
+	/**
+	 * Check if a completed request filled the action (or patch operation) limit, in which case
+	 * the model may have dropped the rest of the description
+	 */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool DidReachActionLimit(int32 RequestId) const;
+
+	/** Get the patch of the last completed refinement request */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	const FInputConfigurationPatch& GetLastParsedPatch() const { return LastParsedPatch; }
+
+	/** Describe a configuration's actions one per line, as sent with refinement requests */
+	static FString BuildCompactConfiguration(const FInputStreamlinerConfiguration& Config);
+
+	/** Get the JSON schema sent with refinement requests in schema format mode */
+	static const TSharedPtr<FJsonObject>& GetPatchSchema();
+
+	/** Upper bound on generated tokens for a patch that matches the schema */
+	static int32 GetPatchTokenLimit();
+
+	/** Cancel a queued or in-flight request */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	bool CancelParseRequest(int32 RequestId);
+
+	/** Cancel every queued and in-flight request */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void CancelAllParseRequests();
+
+	/** Get the state of a request */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	ELLMParseRequestState GetParseRequestState(int32 RequestId) const;
+
+	/** Get the parsed configuration of a completed request */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	bool GetParseResult(int32 RequestId, FInputStreamlinerConfiguration& OutConfig, FString& OutError) const;
+
+	/** Free a completed request and its result */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM")
+	void ReleaseParseRequest(int32 RequestId);
+
 	/** Get the last parsed configuration */
 	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
 	const FInputStreamlinerConfiguration& GetLastParsedConfiguration() const { return LastParsedConfig; }
 
-	/** Check if parsing is currently in progress */
+	/** Parse a recorded LLM response, extracting the JSON object from markdown fences and surrounding text */
+	bool ParseJSONResponse(const FString& JSONString, FInputStreamlinerConfiguration& OutConfig, FString& OutError) const;
+
+	/** Check if any parse request is queued or in flight */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	bool IsParseInProgress() const { return NumInFlight > 0 || PendingQueue.Num() > 0; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
+	int32 GetNumQueuedRequests() const { return PendingQueue.Num(); }
+
 	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM")
-	bool IsParseInProgress() const { return bParseInProgress; }
+	int32 GetNumInFlightRequests() const { return NumInFlight; }
 
 	// Configuration accessors
 
@@ -66,15 +284,81 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Input Streamliner|LLM")
 	FOnParseCompleteMulticast OnParseCompleted;
 
+	/** Called when any parse request completes, fails or is cancelled */
+	UPROPERTY(BlueprintAssignable, Category = "Input Streamliner|LLM")
+	FOnParseRequestComplete OnParseRequestCompleted;
+
+	/**
+	 * Called when the background refinement of a locally matched request finishes. On success the request's
+	 * result (and GetLastParsedConfiguration) now hold the LLM's configuration; the completion callback is not called again.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Input Streamliner|LLM")
+	FOnParseRequestRefined OnParseRequestRefined;
+
+	/**
+	 * Called in streaming mode as soon as each element of the "actions" array is complete.
+	 * Streamed actions are provisional until the request completes successfully.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Input Streamliner|LLM")
+	FOnActionParsed OnActionParsed;
+
 private:
 	/** Build the complete prompt including system prompt and examples */
 	FString BuildPrompt(const FString& UserDescription) const;
 
-	/** Parse the JSON response from the LLM */
-	bool ParseJSONResponse(const FString& JSONString, FString& OutError);
+	/** Build the /api/chat message list: the shared static prefix followed by the user's description */
+	static TArray<TSharedPtr<FJsonValue>> BuildChatMessages(const FString& UserDescription);
+
+	/** System prompt and few-shot examples as chat messages; identical for every request */
+	static const TArray<TSharedPtr<FJsonValue>>& GetChatPrefixMessages();
+
+	/** Create a request to the LLM endpoint; all Ollama traffic goes through here so connections are reused */
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateEndpointRequest(const FString& Path, const FString& Verb, float Timeout) const;
+
+	/**
+	 * Queue a request and start it if a slot is free
+	 * @param RefinedRequestId Locally matched request this one refines; refinements skip local matching and report through OnParseRequestRefined
+	 */
+	int32 EnqueueRequest(const FString& Description, FOnParseComplete OnComplete, int32 Priority, bool bRetainResult, int32 RefinedRequestId = INDEX_NONE);
+
+	/** Insert a request into the pending queue by priority and start it if a slot is free */
+	void QueueRequest(int32 RequestId, int32 Priority);
+
+	/** Complete a request that already has its result on the next tick, so callers receive the handle first */
+	void CompleteOnNextTick(int32 RequestId);
+
+	/** Add the few-shot examples and genre presets to the matcher on first use */
+	void EnsureIntentTemplates();
+
+	/** Start queued requests while request slots are available */
+	void PumpQueue();
+
+	/** Send a request to the LLM */
+	void StartRequest(FLLMParseRequest& ParseRequest);
+
+	/** Finish a request and notify listeners */
+	void CompleteRequest(int32 RequestId, ELLMParseRequestState FinalState, const FString& ErrorMessage);
+
+	/** Copy a finished background refinement into the request it refines and broadcast OnParseRequestRefined */
+	void CompleteRefinement(const FLLMParseRequest& Refinement, bool bSuccess, const FString& ErrorMessage);
+
+	/** Find the JSON object in a response, skipping markdown fences and surrounding text */
+	static bool ExtractJSONObject(const FString& JSONString, TSharedPtr<FJsonObject>& OutObject, FString& OutError);
+
+	/** Decode a response that is known to be a bare JSON object (schema format mode) */
+	static bool DecodeJSONResponse(const FString& JSONString, FInputStreamlinerConfiguration& OutConfig, FString& OutError);
+
+	/** Handle streamed response progress */
+	void OnHttpRequestProgress(FHttpRequestPtr Request, uint64 BytesSent, uint64 BytesReceived, int32 RequestId);
+
+	/** Split newly received NDJSON bytes into chunks and report any completed actions */
+	void ConsumeStreamedContent(int32 RequestId, FLLMStreamState& State, const TArray<uint8>& Content, bool bFinal);
 
 	/** Handle HTTP response */
-	void OnHttpResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FOnParseComplete Callback);
+	void OnHttpResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, int32 RequestId);
+
+	/** Hash of the system prompt and few-shot examples, used to invalidate cached responses */
+	static const FString& GetPromptHash();
 
 	/** Get the system prompt for the LLM */
 	static FString GetSystemPrompt();
@@ -82,6 +366,9 @@ private:
 	/** Get few-shot examples */
 	static FString GetFewShotExamples();
 
+	/** Get the system prompt for refinement requests */
+	static FString GetRefinementPrompt();
+
 	UPROPERTY()
 	FString EndpointURL = TEXT("http://localhost");
 
@@ -91,8 +378,64 @@ private:
 	UPROPERTY()
 	FString ModelName = TEXT("llama3.2:3b-instruct-q3_k_m");
 
+	/** Keep-alive duration sent with every request */
+	UPROPERTY()
+	FString KeepAlive = TEXT("30m");
+
+	/** Sampling temperature sent to the model */
+	UPROPERTY()
+	float Temperature = 0.1f;
+
+	/** Nucleus sampling threshold sent to the model */
+	UPROPERTY()
+	float TopP = 0.9f;
+
 	UPROPERTY()
 	FInputStreamlinerConfiguration LastParsedConfig;
 
-	bool bParseInProgress = false;
+	UPROPERTY()
+	FInputConfigurationPatch LastParsedPatch;
+
+	/** Persistent cache of parsed responses */
+	UPROPERTY()
+	TObjectPtr<ULLMResponseCache> ResponseCache;
+
+	/** Templates matched before contacting the LLM */
+	UPROPERTY()
+	TObjectPtr<UInputIntentMatcher> IntentMatcher;
+
+	bool bLocalMatchingEnabled = true;
+
+	bool bRefineLocalMatches = false;
+
+	bool bIntentTemplatesBuilt = false;
+
+	float LocalMatchThreshold = 0.8f;
+
+	float OfflineMatchThreshold = 0.4f;
+
+	bool bStreamingEnabled = true;
+
+	bool bCacheEnabled = true;
+
+	bool bUseChatSession = true;
+
+	bool bUseSchemaFormat = true;
+
+	/** Maximum number of actions requested through the schema */
+	int32 MaxResponseActions = DefaultMaxResponseActions;
+
+	/** Maximum number of requests sent to the LLM at once */
+	int32 MaxConcurrentRequests = 1;
+
+	/** Number of requests currently in flight */
+	int32 NumInFlight = 0;
+
+	int32 NextRequestId = 1;
+
+	/** All live requests by handle */
+	TMap<int32, TSharedPtr<FLLMParseRequest>> Requests;
+
+	/** Handles waiting for a slot, highest priority first */
+	TArray<int32> PendingQueue;
 };
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputStreamlinerConfiguration.h"
+#include "LLMResponseCache.generated.h"
+
+/**
+ * A single cached parse result
+ */
+USTRUCT()
+struct INPUTSTREAMLINER_API FLLMResponseCacheEntry
+{
+	GENERATED_BODY()
+
+	/** Content hash of the request that produced this result */
+	UPROPERTY()
+	FString Key;
+
+	/** The parsed configuration */
+	UPROPERTY()
+	FInputStreamlinerConfiguration Configuration;
+
+	/** Access stamp used for least-recently-used eviction */
+	UPROPERTY()
+	int64 LastAccess = 0;
+};
+
+/**
+ * On-disk layout of the response cache
+ */
+USTRUCT()
+struct INPUTSTREAMLINER_API FLLMResponseCacheFile
+{
+	GENERATED_BODY()
+
+	/** Cache file version for migration */
+	UPROPERTY()
+	int32 Version = 1;
+
+	/** Hash of the system prompt and few-shot examples the entries were produced with */
+	UPROPERTY()
+	FString PromptHash;
+
+	/** Cached entries */
+	UPROPERTY()
+	TArray<FLLMResponseCacheEntry> Entries;
+};
+
+/**
+ * Persistent, content-addressed cache of LLM parse results
+ * Entries are keyed by a hash of everything that influences the generation and hold
+ * the parsed configuration, so a hit skips both the HTTP round trip and JSON parsing
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINER_API ULLMResponseCache : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Build the cache key for a parse request */
+	static FString MakeKey(const FString& ModelName, const FString& PromptHash, const FString& Description, float Temperature, float TopP);
+
+	/** Hash an arbitrary string (hex SHA-1) */
+	static FString HashString(const FString& Input);
+
+	/** Lower-case, trim and collapse whitespace so trivially different descriptions share an entry */
+	static FString NormalizeDescription(const FString& Description);
+
+	/** Set the prompt hash the cache is valid for; entries produced with a different prompt are dropped */
+	void SetPromptHash(const FString& InPromptHash);
+
+	/** Look up a cached configuration, updating hit/miss counters */
+	bool Find(const FString& Key, FInputStreamlinerConfiguration& OutConfig);
+
+	/** Store a parsed configuration and persist the cache */
+	void Add(const FString& Key, const FInputStreamlinerConfiguration& Config);
+
+	/** Remove all entries and delete the cache file */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM Cache")
+	void Clear();
+
+	/** Set the maximum number of entries kept (least recently used entries are evicted) */
+	UFUNCTION(BlueprintCallable, Category = "Input Streamliner|LLM Cache")
+	void SetMaxEntries(int32 InMaxEntries);
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM Cache")
+	int32 GetMaxEntries() const { return MaxEntries; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM Cache")
+	int32 GetHitCount() const { return HitCount; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM Cache")
+	int32 GetMissCount() const { return MissCount; }
+
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM Cache")
+	int32 GetNumEntries() const { return Entries.Num(); }
+
+	/** Get the path to the cache file */
+	UFUNCTION(BlueprintPure, Category = "Input Streamliner|LLM Cache")
+	FString GetCacheFilePath() const;
+
+private:
+	/** Load entries from disk on first use */
+	void EnsureLoaded();
+
+	/** Write all entries to disk */
+	bool SaveToDisk() const;
+
+	/** Drop least recently used entries until within MaxEntries */
+	void EvictToCapacity();
+
+	/** Cached entries by key */
+	UPROPERTY(Transient)
+	TMap<FString, FLLMResponseCacheEntry> Entries;
+
+	/** Prompt hash the current entries belong to */
+	FString PromptHash;
+
+	/** Monotonic access stamp */
+	int64 AccessCounter = 0;
+
+	int32 MaxEntries = 128;
+
+	int32 HitCount = 0;
+
+	int32 MissCount = 0;
+
+	bool bLoaded = false;
+};
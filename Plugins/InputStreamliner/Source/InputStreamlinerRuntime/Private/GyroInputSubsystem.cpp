@@ -0,0 +1,264 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GyroInputSubsystem.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "LocalPlayerRebindingManager.h"
+#include "EnhancedInputSubsystems.h"
+#include "EnhancedPlayerInput.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+
+DECLARE_CYCLE_STAT(TEXT("Gyro Integrate"), STAT_InputStreamliner_GyroIntegrate, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gyro Samples"), STAT_InputStreamliner_GyroSamples, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gyro Dropped Samples"), STAT_InputStreamliner_GyroDroppedSamples, STATGROUP_InputStreamliner);
+
+namespace GyroInput
+{
+	/** Ring buffer size; several frames of samples at 1 kHz */
+	constexpr uint32 SampleCapacity = 256;
+
+	/** Gaps longer than this restart the integration instead of producing a jump */
+	constexpr double MaxSampleGap = 0.1;
+}
+
+// ============== FOneEuroFilter ==============
+
+float FOneEuroFilter::SmoothingFactor(float Cutoff, float DeltaTime)
+{
+	const float Tau = 1.0f / (2.0f * PI * Cutoff);
+	return 1.0f / (1.0f + Tau / DeltaTime);
+}
+
+float FOneEuroFilter::Filter(float Value, float DeltaTime, float MinCutoff, float Beta, float DerivativeCutoff)
+{
+	if (!bInitialized || DeltaTime <= 0.0f)
+	{
+		PreviousValue = Value;
+		PreviousDerivative = 0.0f;
+		bInitialized = true;
+		return Value;
+	}
+
+	// Smooth the rate of change, then let it open up the cutoff
+	const float Derivative = (Value - PreviousValue) / DeltaTime;
+	const float DerivativeAlpha = SmoothingFactor(DerivativeCutoff, DeltaTime);
+	PreviousDerivative = FMath::Lerp(PreviousDerivative, Derivative, DerivativeAlpha);
+
+	const float Cutoff = MinCutoff + Beta * FMath::Abs(PreviousDerivative);
+	PreviousValue = FMath::Lerp(PreviousValue, Value, SmoothingFactor(Cutoff, DeltaTime));
+	return PreviousValue;
+}
+
+// ============== UGyroInputSubsystem ==============
+
+UGyroInputSubsystem::UGyroInputSubsystem()
+	: PendingSamples(GyroInput::SampleCapacity)
+{
+}
+
+void UGyroInputSubsystem::Deinitialize()
+{
+	StopSampling();
+
+	Super::Deinitialize();
+}
+
+void UGyroInputSubsystem::SetSettings(const FGyroInputSettings& InSettings)
+{
+	Settings = InSettings;
+
+	if (Settings.bEnabled && Settings.LinkedAction)
+	{
+		StartSampling();
+	}
+	else
+	{
+		StopSampling();
+	}
+}
+
+void UGyroInputSubsystem::PushSample(const FVector& RotationRate, double Timestamp)
+{
+	FGyroSample Sample;
+	Sample.RotationRate = FVector3f(RotationRate);
+	Sample.Timestamp = Timestamp;
+
+	if (!PendingSamples.Enqueue(Sample))
+	{
+		INC_DWORD_STAT(STAT_InputStreamliner_GyroDroppedSamples);
+	}
+}
+
+void UGyroInputSubsystem::HandlePreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetLocalPlayer()->GetWorld())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_GyroIntegrate);
+
+	const bool bActive = IsGyroActive();
+	FVector2f Delta = FVector2f::ZeroVector;
+
+	TArray<FGyroSample, TInlineAllocator<GyroInput::SampleCapacity>> Samples;
+	FGyroSample Sample;
+	while (PendingSamples.Dequeue(Sample))
+	{
+		Samples.Add(Sample);
+	}
+
+	// Slate delivers motion events in bursts, so their arrival times say nothing about when the sensor took them;
+	// samples without a sensor timestamp share the frame's time instead
+	int32 NumUntimed = 0;
+	for (const FGyroSample& Queued : Samples)
+	{
+		NumUntimed += Queued.Timestamp <= 0.0 ? 1 : 0;
+	}
+	const double UntimedDelta = NumUntimed > 0 ? DeltaSeconds / NumUntimed : 0.0;
+
+	// Integrate every sample over the time it covers so the result does not depend on frame rate
+	for (const FGyroSample& Queued : Samples)
+	{
+		INC_DWORD_STAT(STAT_InputStreamliner_GyroSamples);
+
+		double SampleDelta = UntimedDelta;
+		if (Queued.Timestamp > 0.0)
+		{
+			SampleDelta = Queued.Timestamp - LastSampleTime;
+			LastSampleTime = Queued.Timestamp;
+		}
+
+		if (!bActive || SampleDelta <= 0.0 || SampleDelta > GyroInput::MaxSampleGap)
+		{
+			HorizontalFilter.Reset();
+			VerticalFilter.Reset();
+			continue;
+		}
+
+		const float SampleDeltaSeconds = static_cast<float>(SampleDelta);
+		const float HorizontalRate = HorizontalFilter.Filter(Queued.RotationRate.Y, SampleDeltaSeconds, Settings.MinCutoff, Settings.Beta, Settings.DerivativeCutoff);
+		const float VerticalRate = VerticalFilter.Filter(Queued.RotationRate.X, SampleDeltaSeconds, Settings.MinCutoff, Settings.Beta, Settings.DerivativeCutoff);
+		Delta += FVector2f(HorizontalRate, VerticalRate) * SampleDeltaSeconds;
+	}
+
+	LastDelta = FVector2f(FMath::RadiansToDegrees(Delta.X), FMath::RadiansToDegrees(Delta.Y));
+	if (!bActive || LastDelta.IsNearlyZero())
+	{
+		return;
+	}
+
+	const ULocalPlayerRebindingManager* PlayerManager = GetLocalPlayer()->GetSubsystem<ULocalPlayerRebindingManager>();
+	const float Sensitivity = Settings.Sensitivity * (PlayerManager ? PlayerManager->GetGyroSensitivity() : 1.0f);
+	const FVector2f Output(
+		LastDelta.X * Sensitivity * (Settings.bInvertHorizontal ? -1.0f : 1.0f),
+		LastDelta.Y * Sensitivity * (Settings.bInvertVertical ? -1.0f : 1.0f));
+
+	if (UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem())
+	{
+		Subsystem->InjectInputForAction(Settings.LinkedAction, FInputActionValue(FVector2D(Output)), {}, {});
+	}
+}
+
+bool UGyroInputSubsystem::IsGyroActive() const
+{
+	if (!Settings.bEnabled || !Settings.LinkedAction)
+	{
+		return false;
+	}
+
+	if (Settings.bRequirePlayerOptIn)
+	{
+		const ULocalPlayerRebindingManager* PlayerManager = GetLocalPlayer()->GetSubsystem<ULocalPlayerRebindingManager>();
+		if (PlayerManager && !PlayerManager->GetGyroEnabled())
+		{
+			return false;
+		}
+	}
+
+	if (!Settings.ActivationAction)
+	{
+		return true;
+	}
+
+	// Value from the last input update, which is what the player is holding right now
+	const UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem();
+	const UEnhancedPlayerInput* PlayerInput = Subsystem ? Subsystem->GetPlayerInput() : nullptr;
+	return PlayerInput && PlayerInput->GetActionValue(Settings.ActivationAction).Get<bool>();
+}
+
+void UGyroInputSubsystem::StartSampling()
+{
+	if (!MotionInputProcessor.IsValid())
+	{
+		MotionInputProcessor = MakeShareable(new FGyroMotionInputProcessor(this));
+		if (FSlateApplication::IsInitialized())
+		{
+			FSlateApplication::Get().RegisterInputPreProcessor(MotionInputProcessor);
+		}
+	}
+
+	if (!PreActorTickHandle.IsValid())
+	{
+		PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UGyroInputSubsystem::HandlePreActorTick);
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Gyro input enabled for %s"), *Settings.LinkedAction->GetName());
+}
+
+void UGyroInputSubsystem::StopSampling()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	PreActorTickHandle.Reset();
+
+	if (MotionInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(MotionInputProcessor);
+	}
+	MotionInputProcessor.Reset();
+
+	PendingSamples.Empty();
+	HorizontalFilter.Reset();
+	VerticalFilter.Reset();
+	LastSampleTime = 0.0;
+	LastDelta = FVector2f::ZeroVector;
+}
+
+bool UGyroInputSubsystem::IsEventFromPlayer(uint32 SlateUserIndex) const
+{
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	const UGameInstance* GameInstance = LocalPlayer->GetGameInstance();
+
+	// With a single player every device belongs to it
+	if (!GameInstance || GameInstance->GetNumLocalPlayers() <= 1)
+	{
+		return true;
+	}
+
+	return static_cast<int32>(SlateUserIndex) == LocalPlayer->GetControllerId();
+}
+
+UEnhancedInputLocalPlayerSubsystem* UGyroInputSubsystem::GetInputSubsystem() const
+{
+	if (!CachedInputSubsystem.IsValid())
+	{
+		CachedInputSubsystem = GetLocalPlayer()->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
+	}
+	return CachedInputSubsystem.Get();
+}
+
+// ============== FGyroMotionInputProcessor Implementation ==============
+
+bool FGyroMotionInputProcessor::HandleMotionDetectedEvent(FSlateApplication& SlateApp, const FMotionEvent& MotionEvent)
+{
+	// Slate has no sensor timestamp, and another player's controller must not turn this player's view
+	if (Gyro.IsValid() && Gyro->IsEventFromPlayer(MotionEvent.GetUserIndex()))
+	{
+		Gyro->PushSample(MotionEvent.GetRotationRate());
+	}
+
+	// Leave the event to the rest of the game
+	return false;
+}
@@ -0,0 +1,66 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputActionTable.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "InputAction.h"
+#include "Engine/AssetManager.h"
+
+FInputActionTable::FInputActionTable(TConstArrayView<FInputActionTableEntry> InActions, TConstArrayView<const TCHAR*> InMappingContextPaths)
+	: Actions(InActions)
+{
+	ActionPaths.Reserve(Actions.Num());
+	for (const FInputActionTableEntry& Entry : Actions)
+	{
+		ActionPaths.Emplace(Entry.ObjectPath);
+	}
+
+	MappingContextPaths.Reserve(InMappingContextPaths.Num());
+	for (const TCHAR* Path : InMappingContextPaths)
+	{
+		MappingContextPaths.Emplace(Path);
+	}
+}
+
+UInputAction* FInputActionTable::GetAction(int32 Index) const
+{
+	return ActionPaths.IsValidIndex(Index) ? Cast<UInputAction>(ActionPaths[Index].ResolveObject()) : nullptr;
+}
+
+TArray<FKey> FInputActionTable::GetDefaultKeys(int32 Index) const
+{
+	TArray<FKey> Keys;
+	if (!Actions.IsValidIndex(Index))
+	{
+		return Keys;
+	}
+
+	const FInputActionTableEntry& Entry = Actions[Index];
+	Keys.Reserve(Entry.NumDefaultKeys);
+	for (int32 i = 0; i < Entry.NumDefaultKeys; i++)
+	{
+		const FKey Key(Entry.DefaultKeys[i]);
+		if (Key.IsValid())
+		{
+			Keys.Add(Key);
+		}
+		else
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Unknown default key %s for action %s"), Entry.DefaultKeys[i], Entry.Name);
+		}
+	}
+	return Keys;
+}
+
+TArray<FSoftObjectPath> FInputActionTable::GetAllAssetPaths() const
+{
+	TArray<FSoftObjectPath> Paths;
+	Paths.Reserve(ActionPaths.Num() + MappingContextPaths.Num());
+	Paths.Append(ActionPaths);
+	Paths.Append(MappingContextPaths);
+	return Paths;
+}
+
+TSharedPtr<FStreamableHandle> FInputActionTable::Preload(FStreamableDelegate OnLoaded) const
+{
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(GetAllAssetPaths(), MoveTemp(OnLoaded));
+}
@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputAssetManifest.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+
+TArray<FName> UInputAssetManifest::GetCurrentPlatformNames()
+{
+#if PLATFORM_IOS
+	return { TEXT("iOS") };
+#elif PLATFORM_ANDROID
+	return { TEXT("Android") };
+#elif PLATFORM_MAC
+	return { TEXT("Mac"), TEXT("PC_Gamepad") };
+#else
+	return { TEXT("PC_Keyboard"), TEXT("PC_Gamepad") };
+#endif
+}
+
+bool UInputAssetManifest::IsActionOnPlatforms(const FGeneratedInputActionEntry& Entry, const TArray<FName>& PlatformNames)
+{
+	for (const FName& Platform : Entry.Platforms)
+	{
+		if (PlatformNames.Contains(Platform))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TArray<FSoftObjectPath> UInputAssetManifest::GetAssetPathsForPlatforms(const TArray<FName>& PlatformNames) const
+{
+	TArray<FSoftObjectPath> Paths;
+	Paths.Reserve(Actions.Num() + MappingContexts.Num());
+
+	for (const FGeneratedInputActionEntry& Entry : Actions)
+	{
+		if (!Entry.Action.IsNull() && IsActionOnPlatforms(Entry, PlatformNames))
+		{
+			Paths.Add(Entry.Action.ToSoftObjectPath());
+		}
+	}
+
+	for (const FGeneratedMappingContextEntry& Entry : MappingContexts)
+	{
+		if (!Entry.Context.IsNull() && PlatformNames.Contains(Entry.Platform))
+		{
+			Paths.Add(Entry.Context.ToSoftObjectPath());
+		}
+	}
+
+	return Paths;
+}
+
+TSoftObjectPtr<UInputMappingContext> UInputAssetManifest::FindMappingContext(const TArray<FName>& PlatformNames) const
+{
+	for (const FName& Platform : PlatformNames)
+	{
+		for (const FGeneratedMappingContextEntry& Entry : MappingContexts)
+		{
+			if (Entry.Platform == Platform && !Entry.Context.IsNull())
+			{
+				return Entry.Context;
+			}
+		}
+	}
+	return nullptr;
+}
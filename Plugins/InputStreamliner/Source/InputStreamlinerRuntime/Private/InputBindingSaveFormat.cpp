@@ -0,0 +1,275 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputBindingSaveFormat.h"
+#include "InputRebindingManager.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace InputBindingSaveFormat
+{
+	enum EFlags : uint8
+	{
+		Flag_InvertY = 1 << 0,
+		Flag_GyroEnabled = 1 << 1
+	};
+
+	/** Read an element count, rejecting counts the remaining bytes cannot hold */
+	bool ReadCount(FArchive& Ar, int32& OutCount)
+	{
+		Ar << OutCount;
+		return !Ar.IsError() && OutCount >= 0 && OutCount <= Ar.TotalSize() - Ar.Tell();
+	}
+
+	bool ReadNameIndex(FArchive& Ar, const TArray<FName>& Names, FName& OutName)
+	{
+		int32 Index = INDEX_NONE;
+		Ar << Index;
+
+		if (Index == INDEX_NONE)
+		{
+			OutName = NAME_None;
+			return !Ar.IsError();
+		}
+
+		if (!Names.IsValidIndex(Index))
+		{
+			return false;
+		}
+
+		OutName = Names[Index];
+		return !Ar.IsError();
+	}
+}
+
+void FInputBindingSaveFormat::Write(const FInputBindingSaveData& Data, TArray<uint8>& OutBytes)
+{
+	TArray<FString> Names;
+	TMap<FName, int32> NameIndices;
+
+	auto GetNameIndex = [&Names, &NameIndices](FName Name) -> int32
+	{
+		if (Name.IsNone())
+		{
+			return INDEX_NONE;
+		}
+
+		if (const int32* Found = NameIndices.Find(Name))
+		{
+			return *Found;
+		}
+
+		const int32 Index = Names.Add(Name.ToString());
+		NameIndices.Add(Name, Index);
+		return Index;
+	};
+
+	// Resolve every name up front so the table can be written first
+	TArray<TArray<int32>> BindingNameIndices;
+	BindingNameIndices.Reserve(Data.Bindings.Num());
+	for (const FActionBindingSave& Binding : Data.Bindings)
+	{
+		TArray<int32>& Indices = BindingNameIndices.AddDefaulted_GetRef();
+		Indices.Reserve(Binding.Keys.Num() + 1);
+		Indices.Add(GetNameIndex(Binding.ActionName));
+		for (const FKey& Key : Binding.Keys)
+		{
+			Indices.Add(Key.IsValid() ? GetNameIndex(Key.GetFName()) : INDEX_NONE);
+		}
+	}
+
+	// Map order is not stable, so positions are written sorted by control name
+	TArray<FName> ControlNames;
+	Data.TouchControlPositions.GenerateKeyArray(ControlNames);
+	ControlNames.Sort(FNameLexicalLess());
+
+	TArray<int32> ControlNameIndices;
+	ControlNameIndices.Reserve(ControlNames.Num());
+	for (const FName& ControlName : ControlNames)
+	{
+		ControlNameIndices.Add(GetNameIndex(ControlName));
+	}
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 FileMagic = Magic;
+	int32 Version = CurrentVersion;
+	Writer << FileMagic;
+	Writer << Version;
+
+	float MouseSensitivity = Data.MouseSensitivity;
+	float GamepadSensitivity = Data.GamepadSensitivity;
+	float GyroSensitivity = Data.GyroSensitivity;
+	uint8 Flags = (Data.bInvertY ? InputBindingSaveFormat::Flag_InvertY : 0)
+		| (Data.bGyroEnabled ? InputBindingSaveFormat::Flag_GyroEnabled : 0);
+	Writer << MouseSensitivity;
+	Writer << GamepadSensitivity;
+	Writer << GyroSensitivity;
+	Writer << Flags;
+
+	int32 NumNames = Names.Num();
+	Writer << NumNames;
+	for (FString& Name : Names)
+	{
+		Writer << Name;
+	}
+
+	int32 NumBindings = BindingNameIndices.Num();
+	Writer << NumBindings;
+	for (TArray<int32>& Indices : BindingNameIndices)
+	{
+		int32 NumKeys = Indices.Num() - 1;
+		Writer << Indices[0];
+		Writer << NumKeys;
+		for (int32 KeyIndex = 1; KeyIndex < Indices.Num(); ++KeyIndex)
+		{
+			Writer << Indices[KeyIndex];
+		}
+	}
+
+	int32 NumPositions = ControlNames.Num();
+	Writer << NumPositions;
+	for (int32 Index = 0; Index < ControlNames.Num(); ++Index)
+	{
+		FVector2D Position = Data.TouchControlPositions.FindChecked(ControlNames[Index]);
+		Writer << ControlNameIndices[Index];
+		Writer << Position.X;
+		Writer << Position.Y;
+	}
+}
+
+bool FInputBindingSaveFormat::Read(const TArray<uint8>& Bytes, FInputBindingSaveData& OutData)
+{
+	using namespace InputBindingSaveFormat;
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 FileMagic = 0;
+	int32 Version = 0;
+	Reader << FileMagic;
+	Reader << Version;
+
+	if (Reader.IsError() || FileMagic != Magic)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Bindings file is not a binary bindings archive"));
+		return false;
+	}
+
+	// Binary files start at version 2; add migration branches here as the layout changes
+	if (Version < 2 || Version > CurrentVersion)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Unsupported bindings file version %d"), Version);
+		return false;
+	}
+
+	FInputBindingSaveData Data;
+	Data.Version = Version;
+
+	uint8 Flags = 0;
+	Reader << Data.MouseSensitivity;
+	Reader << Data.GamepadSensitivity;
+	Reader << Data.GyroSensitivity;
+	Reader << Flags;
+	Data.bInvertY = (Flags & Flag_InvertY) != 0;
+	Data.bGyroEnabled = (Flags & Flag_GyroEnabled) != 0;
+
+	int32 NumNames = 0;
+	if (!ReadCount(Reader, NumNames))
+	{
+		return false;
+	}
+
+	TArray<FName> Names;
+	Names.Reserve(NumNames);
+	for (int32 Index = 0; Index < NumNames; ++Index)
+	{
+		FString Name;
+		Reader << Name;
+		Names.Add(FName(*Name));
+	}
+
+	int32 NumBindings = 0;
+	if (!ReadCount(Reader, NumBindings))
+	{
+		return false;
+	}
+
+	Data.Bindings.Reserve(NumBindings);
+	for (int32 Index = 0; Index < NumBindings; ++Index)
+	{
+		FActionBindingSave& Binding = Data.Bindings.AddDefaulted_GetRef();
+
+		int32 NumKeys = 0;
+		if (!ReadNameIndex(Reader, Names, Binding.ActionName) || !ReadCount(Reader, NumKeys))
+		{
+			return false;
+		}
+
+		Binding.Keys.Reserve(NumKeys);
+		for (int32 KeyIndex = 0; KeyIndex < NumKeys; ++KeyIndex)
+		{
+			FName KeyName;
+			if (!ReadNameIndex(Reader, Names, KeyName))
+			{
+				return false;
+			}
+			Binding.Keys.Add(KeyName.IsNone() ? EKeys::Invalid : FKey(KeyName));
+		}
+	}
+
+	int32 NumPositions = 0;
+	if (!ReadCount(Reader, NumPositions))
+	{
+		return false;
+	}
+
+	Data.TouchControlPositions.Reserve(NumPositions);
+	for (int32 Index = 0; Index < NumPositions; ++Index)
+	{
+		FName ControlName;
+		FVector2D Position;
+		if (!ReadNameIndex(Reader, Names, ControlName))
+		{
+			return false;
+		}
+		Reader << Position.X;
+		Reader << Position.Y;
+		Data.TouchControlPositions.Add(ControlName, Position);
+	}
+
+	if (Reader.IsError())
+	{
+		return false;
+	}
+
+	Sanitize(Data);
+	OutData = MoveTemp(Data);
+	return true;
+}
+
+void FInputBindingSaveFormat::Sanitize(FInputBindingSaveData& Data)
+{
+	auto SanitizeSensitivity = [](float& Sensitivity, const TCHAR* Name)
+	{
+		if (!FMath::IsFinite(Sensitivity))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Loaded %s sensitivity is not a number; using 1.0"), Name);
+			Sensitivity = 1.0f;
+		}
+		Sensitivity = FMath::Clamp(Sensitivity, MinSensitivity, MaxSensitivity);
+	};
+
+	SanitizeSensitivity(Data.MouseSensitivity, TEXT("mouse"));
+	SanitizeSensitivity(Data.GamepadSensitivity, TEXT("gamepad"));
+	SanitizeSensitivity(Data.GyroSensitivity, TEXT("gyro"));
+
+	for (auto It = Data.TouchControlPositions.CreateIterator(); It; ++It)
+	{
+		if (!FMath::IsFinite(It.Value().X) || !FMath::IsFinite(It.Value().Y))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Dropping invalid saved position of touch control %s"), *It.Key().ToString());
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -1,647 +1,473 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "InputRebindingManager.h"
-#include "InputStreamlinerRuntimeModule.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/InputSettings.h"
-#include "EnhancedInputSubsystems.h"
+#include "LocalPlayerRebindingManager.h"
+#include "InputActionTable.h"
+#include "InputAssetManifest.h"
+#include "InputStreamlinerRuntimeSettings.h"
 #include "InputMappingContext.h"
-#include "EnhancedActionKeyMapping.h"
-#include "Framework/Application/SlateApplication.h"
-#include "JsonObjectConverter.h"
-#include "Misc/FileHelper.h"
-#include "Engine/LocalPlayer.h"
+#include "InputStreamlinerRuntimeModule.h"
 #include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
 
 void UInputRebindingManager::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	// Create input processor for capturing rebind keys
-	RebindInputProcessor = MakeShareable(new FRebindInputProcessor(this));
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Input Rebinding Manager initialized"));
 
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("InputRebindingManager initialized"));
-
-	// Load saved bindings
-	LoadBindings();
+	if (GetDefault<UInputStreamlinerRuntimeSettings>()->bPreloadGeneratedAssets)
+	{
+		FInputStreamlinerRuntimeModule::Get().PreloadGeneratedAssets(
+			FOnGeneratedInputAssetsLoaded::CreateUObject(this, &UInputRebindingManager::HandleGeneratedAssetsLoaded));
+	}
 }
 
 void UInputRebindingManager::Deinitialize()
 {
-	// Remove input processor
-	if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
-	{
-		FSlateApplication::Get().UnregisterInputPreProcessor(RebindInputProcessor);
-	}
-	RebindInputProcessor.Reset();
-
-	// Auto-save on shutdown
-	SaveBindings();
+	DefaultBindings.Empty();
+	BindingProfiles.Empty();
+	CompiledBindingProfiles.Empty();
+	IndexedActions.Empty();
+	GeneratedMappingContext = nullptr;
 
 	Super::Deinitialize();
 }
 
-void UInputRebindingManager::StartRebinding(UInputAction* Action)
+ULocalPlayerRebindingManager* UInputRebindingManager::GetPlayerManager(const ULocalPlayer* LocalPlayer) const
 {
-	if (!Action)
-	{
-		UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Cannot start rebinding: null action"));
-		return;
-	}
-
-	PendingRebindAction = Action;
-	PendingBindingIndex = 0;
-
-	// Register input processor to capture next key press
-	if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
-	{
-		FSlateApplication::Get().RegisterInputPreProcessor(RebindInputProcessor);
-	}
-
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Started rebinding for action: %s"), *Action->GetName());
+	return LocalPlayer ? LocalPlayer->GetSubsystem<ULocalPlayerRebindingManager>() : nullptr;
 }
 
-void UInputRebindingManager::CancelRebinding()
+ULocalPlayerRebindingManager* UInputRebindingManager::GetPrimaryPlayerManager() const
 {
-	if (PendingRebindAction)
-	{
-		UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Cancelled rebinding for action: %s"),
-			*PendingRebindAction->GetName());
-	}
-
-	// Unregister input processor
-	if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
-	{
-		FSlateApplication::Get().UnregisterInputPreProcessor(RebindInputProcessor);
-	}
-
-	PendingRebindAction = nullptr;
-	PendingBindingIndex = 0;
+	return GetPlayerManager(GetGameInstance()->GetFirstGamePlayer());
 }
 
-TArray<FKey> UInputRebindingManager::GetBindingsForAction(UInputAction* Action) const
+void UInputRebindingManager::RegisterAction(UInputAction* Action, const TArray<FKey>& InDefaultBindings)
 {
 	if (!Action)
 	{
-		return TArray<FKey>();
+		return;
 	}
 
-	const TArray<FKey>* CustomBindings = CurrentBindings.Find(Action);
-	if (CustomBindings)
-	{
-		return *CustomBindings;
-	}
+	DefaultBindings.Add(Action, InDefaultBindings);
+	++RegistrationGeneration;
 
-	const TArray<FKey>* Defaults = DefaultBindings.Find(Action);
-	if (Defaults)
+	UInputAction* const Registered[] = { Action };
+	for (ULocalPlayer* LocalPlayer : GetGameInstance()->GetLocalPlayers())
 	{
-		return *Defaults;
+		if (ULocalPlayerRebindingManager* PlayerManager = GetPlayerManager(LocalPlayer))
+		{
+			PlayerManager->HandleActionsRegistered(Registered);
+		}
 	}
 
-	return TArray<FKey>();
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Registered action: %s with %d default bindings"),
+		*Action->GetName(), InDefaultBindings.Num());
 }
 
-bool UInputRebindingManager::ApplyBinding(UInputAction* Action, FKey NewKey, int32 BindingIndex)
+void UInputRebindingManager::RegisterActions(const TArray<FActionDefaultBindings>& Actions)
 {
-	if (!Action || !NewKey.IsValid())
-	{
-		return false;
-	}
+	TArray<UInputAction*> Registered;
+	Registered.Reserve(Actions.Num());
+	DefaultBindings.Reserve(DefaultBindings.Num() + Actions.Num());
 
-	// Check for conflicts
-	UInputAction* ConflictingAction = nullptr;
-	if (HasConflict(Action, NewKey, ConflictingAction))
+	for (const FActionDefaultBindings& Entry : Actions)
 	{
-		OnBindingConflict.Broadcast(ConflictingAction, NewKey);
-		// Don't apply - let the UI handle conflict resolution
-		return false;
+		if (Entry.Action)
+		{
+			DefaultBindings.Add(Entry.Action, Entry.DefaultKeys);
+			Registered.Add(Entry.Action);
+		}
 	}
+	++RegistrationGeneration;
 
-	// Get old key for mapping context update
-	TArray<FKey> OldBindings = GetBindingsForAction(Action);
-	FKey OldKey = OldBindings.IsValidIndex(BindingIndex) ? OldBindings[BindingIndex] : EKeys::Invalid;
-
-	// Get or create binding array
-	TArray<FKey>& Bindings = CurrentBindings.FindOrAdd(Action);
-
-	// Ensure array is large enough
-	while (Bindings.Num() <= BindingIndex)
+	// Each player applies its saved bindings for the whole batch in one rebuild
+	for (ULocalPlayer* LocalPlayer : GetGameInstance()->GetLocalPlayers())
 	{
-		Bindings.Add(EKeys::Invalid);
+		if (ULocalPlayerRebindingManager* PlayerManager = GetPlayerManager(LocalPlayer))
+		{
+			PlayerManager->HandleActionsRegistered(Registered);
+		}
 	}
 
-	Bindings[BindingIndex] = NewKey;
-
-	// Apply to mapping context
-	ApplyBindingToMappingContext(Action, OldKey, NewKey);
-
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Applied binding %s to action %s at index %d"),
-		*NewKey.ToString(), *Action->GetName(), BindingIndex);
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Registered %d actions"), Registered.Num());
+}
 
-	OnRebindComplete.Broadcast(Action, NewKey);
+void UInputRebindingManager::RegisterActionTable(const FInputActionTable& Table)
+{
+	TArray<FActionDefaultBindings> Actions;
+	Actions.Reserve(Table.Num());
+	IndexedActions.SetNum(Table.Num());
 
-	// Clear rebinding state
-	if (PendingRebindAction == Action)
+	for (int32 Index = 0; Index < Table.Num(); Index++)
 	{
-		// Unregister input processor
-		if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+		UInputAction* Action = Table.GetAction(Index);
+		IndexedActions[Index] = Action;
+		if (!Action)
 		{
-			FSlateApplication::Get().UnregisterInputPreProcessor(RebindInputProcessor);
+			UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Action table entry %s is not loaded: %s"),
+				Table.GetEntry(Index).Name, *Table.GetActionPath(Index).ToString());
+			continue;
 		}
-		PendingRebindAction = nullptr;
+
+		FActionDefaultBindings& Entry = Actions.AddDefaulted_GetRef();
+		Entry.Action = Action;
+		Entry.DefaultKeys = Table.GetDefaultKeys(Index);
 	}
 
-	return true;
+	RegisterActions(Actions);
 }
 
-bool UInputRebindingManager::RemoveBinding(UInputAction* Action, int32 BindingIndex)
+void UInputRebindingManager::HandleGeneratedAssetsLoaded(const UInputAssetManifest* Manifest)
 {
-	if (!Action)
-	{
-		return false;
-	}
-
-	TArray<FKey>* Bindings = CurrentBindings.Find(Action);
-	if (!Bindings || !Bindings->IsValidIndex(BindingIndex))
+	if (!Manifest)
 	{
-		return false;
+		return;
 	}
 
-	FKey OldKey = (*Bindings)[BindingIndex];
-	(*Bindings)[BindingIndex] = EKeys::Invalid;
-
-	// Update mapping context
-	ApplyBindingToMappingContext(Action, OldKey, EKeys::Invalid);
-
-	return true;
-}
-
-bool UInputRebindingManager::HasConflict(UInputAction* Action, FKey Key, UInputAction*& OutConflictingAction) const
-{
-	OutConflictingAction = nullptr;
+	const TArray<FName> PlatformNames = UInputAssetManifest::GetCurrentPlatformNames();
 
-	for (const auto& Pair : CurrentBindings)
+	// Everything for this platform in one batch; actions the game registered itself keep its defaults
+	TArray<FActionDefaultBindings> Actions;
+	Actions.Reserve(Manifest->Actions.Num());
+	for (const FGeneratedInputActionEntry& Entry : Manifest->Actions)
 	{
-		if (Pair.Key == Action)
+		if (!UInputAssetManifest::IsActionOnPlatforms(Entry, PlatformNames))
 		{
-			continue; // Skip self
+			continue;
 		}
 
-		if (Pair.Value.Contains(Key))
+		UInputAction* Action = Entry.Action.Get();
+		if (!Action)
 		{
-			OutConflictingAction = Pair.Key;
-			return true;
+			UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Generated action failed to load: %s"), *Entry.Action.ToString());
+			continue;
 		}
-	}
-
-	return false;
-}
 
-void UInputRebindingManager::SwapBindings(UInputAction* ActionA, UInputAction* ActionB, FKey Key)
-{
-	if (!ActionA || !ActionB)
-	{
-		return;
+		if (Entry.bAllowRebinding && !DefaultBindings.Contains(Action))
+		{
+			FActionDefaultBindings& Registration = Actions.AddDefaulted_GetRef();
+			Registration.Action = Action;
+			Registration.DefaultKeys = Entry.DefaultKeys;
+		}
 	}
+	RegisterActions(Actions);
 
-	TArray<FKey>& BindingsA = CurrentBindings.FindOrAdd(ActionA);
-	TArray<FKey>& BindingsB = CurrentBindings.FindOrAdd(ActionB);
-
-	// Find indices
-	int32 IndexA = BindingsA.Find(Key);
-	int32 IndexB = BindingsB.Find(Key);
-
-	if (IndexB != INDEX_NONE)
+	const UInputStreamlinerRuntimeSettings* Settings = GetDefault<UInputStreamlinerRuntimeSettings>();
+	if (Settings->bApplyGeneratedMappingContext)
 	{
-		// Remove from B
-		BindingsB[IndexB] = EKeys::Invalid;
-		ApplyBindingToMappingContext(ActionB, Key, EKeys::Invalid);
-	}
+		GeneratedMappingContext = Manifest->FindMappingContext(PlatformNames).Get();
 
-	// Add to A
-	if (IndexA == INDEX_NONE)
-	{
-		BindingsA.Add(Key);
-		ApplyBindingToMappingContext(ActionA, EKeys::Invalid, Key);
+		// Players created later pick it up when their rebinding state initializes
+		for (ULocalPlayer* LocalPlayer : GetGameInstance()->GetLocalPlayers())
+		{
+			ULocalPlayerRebindingManager* PlayerManager = GetPlayerManager(LocalPlayer);
+			if (GeneratedMappingContext && PlayerManager && !PlayerManager->GetMappingContext())
+			{
+				PlayerManager->SetMappingContext(GeneratedMappingContext, Settings->GeneratedMappingContextPriority);
+			}
+		}
 	}
 
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Swapped binding %s from %s to %s"),
-		*Key.ToString(), *ActionB->GetName(), *ActionA->GetName());
+	bGeneratedAssetsRegistered = true;
 }
 
-void UInputRebindingManager::ResetToDefault(UInputAction* Action)
+void UInputRebindingManager::StartRebinding(UInputAction* Action)
 {
-	if (!Action)
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		return;
+		PlayerManager->StartRebinding(Action);
 	}
+}
 
-	// Get current bindings to remove from mapping context
-	TArray<FKey> CurrentKeys = GetBindingsForAction(Action);
-
-	const TArray<FKey>* Defaults = DefaultBindings.Find(Action);
-	if (Defaults)
-	{
-		CurrentBindings.Add(Action, *Defaults);
-
-		// Update mapping context - remove old, add defaults
-		for (const FKey& OldKey : CurrentKeys)
-		{
-			if (OldKey.IsValid() && !Defaults->Contains(OldKey))
-			{
-				ApplyBindingToMappingContext(Action, OldKey, EKeys::Invalid);
-			}
-		}
-		for (const FKey& NewKey : *Defaults)
-		{
-			if (NewKey.IsValid() && !CurrentKeys.Contains(NewKey))
-			{
-				ApplyBindingToMappingContext(Action, EKeys::Invalid, NewKey);
-			}
-		}
-	}
-	else
+void UInputRebindingManager::CancelRebinding()
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		CurrentBindings.Remove(Action);
+		PlayerManager->CancelRebinding();
 	}
+}
 
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Reset action %s to defaults"), *Action->GetName());
+bool UInputRebindingManager::IsRebindingInProgress() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->IsRebindingInProgress();
 }
 
-void UInputRebindingManager::ResetAllToDefaults()
+UInputAction* UInputRebindingManager::GetPendingRebindAction() const
 {
-	CurrentBindings.Empty();
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetPendingRebindAction() : nullptr;
+}
 
-	for (const auto& Pair : DefaultBindings)
+TArray<FKey> UInputRebindingManager::GetBindingsForAction(UInputAction* Action) const
+{
+	if (const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		CurrentBindings.Add(Pair.Key, Pair.Value);
+		return PlayerManager->GetBindingsForAction(Action);
 	}
 
-	// Reset sensitivity settings
-	SaveData.MouseSensitivity = 1.0f;
-	SaveData.GamepadSensitivity = 1.0f;
-	SaveData.GyroSensitivity = 1.0f;
-	SaveData.bInvertY = false;
-
-	// Reapply all bindings to mapping context
-	ApplyLoadedBindings();
-
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Reset all bindings to defaults"));
+	const TArray<FKey>* Defaults = FindDefaultBindings(Action);
+	return Defaults ? *Defaults : TArray<FKey>();
 }
 
-void UInputRebindingManager::SetMouseSensitivity(float Sensitivity)
+bool UInputRebindingManager::ApplyBinding(UInputAction* Action, FKey NewKey, int32 BindingIndex)
 {
-	SaveData.MouseSensitivity = FMath::Clamp(Sensitivity, 0.1f, 5.0f);
+	ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->ApplyBinding(Action, NewKey, BindingIndex);
 }
 
-void UInputRebindingManager::SetGamepadSensitivity(float Sensitivity)
+bool UInputRebindingManager::RemoveBinding(UInputAction* Action, int32 BindingIndex)
 {
-	SaveData.GamepadSensitivity = FMath::Clamp(Sensitivity, 0.1f, 5.0f);
+	ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->RemoveBinding(Action, BindingIndex);
 }
 
-void UInputRebindingManager::SetGyroSensitivity(float Sensitivity)
+bool UInputRebindingManager::HasConflict(UInputAction* Action, FKey Key, UInputAction*& OutConflictingAction) const
 {
-	SaveData.GyroSensitivity = FMath::Clamp(Sensitivity, 0.1f, 5.0f);
+	OutConflictingAction = nullptr;
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->HasConflict(Action, Key, OutConflictingAction);
 }
 
-void UInputRebindingManager::SetInvertY(bool bInvert)
+TArray<FInputBindingConflict> UInputRebindingManager::GetAllConflicts() const
 {
-	SaveData.bInvertY = bInvert;
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetAllConflicts() : TArray<FInputBindingConflict>();
 }
 
-bool UInputRebindingManager::SaveBindings()
+TArray<UInputAction*> UInputRebindingManager::GetActionsForKey(FKey Key) const
 {
-	// Convert current bindings to save format
-	SaveData.Bindings.Empty();
-
-	for (const auto& Pair : CurrentBindings)
-	{
-		if (!Pair.Key)
-		{
-			continue;
-		}
-
-		FActionBindingSave BindingSave;
-		BindingSave.ActionName = Pair.Key->GetFName();
-		BindingSave.Keys = Pair.Value;
-		SaveData.Bindings.Add(BindingSave);
-	}
-
-	// Serialize to JSON
-	FString JsonString;
-	if (!FJsonObjectConverter::UStructToJsonObjectString(SaveData, JsonString))
-	{
-		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to serialize bindings to JSON"));
-		return false;
-	}
-
-	// Ensure directory exists
-	FString SaveDir = FPaths::ProjectSavedDir() / TEXT("InputStreamliner");
-	IFileManager::Get().MakeDirectory(*SaveDir, true);
-
-	// Write to file
-	FString SavePath = SaveDir / TEXT("Bindings.json");
-	if (!FFileHelper::SaveStringToFile(JsonString, *SavePath))
-	{
-		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to save bindings to: %s"), *SavePath);
-		return false;
-	}
-
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Bindings saved to: %s"), *SavePath);
-	return true;
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetActionsForKey(Key) : TArray<UInputAction*>();
 }
 
-bool UInputRebindingManager::LoadBindings()
+void UInputRebindingManager::SwapBindings(UInputAction* ActionA, UInputAction* ActionB, FKey Key)
 {
-	FString SavePath = FPaths::ProjectSavedDir() / TEXT("InputStreamliner") / TEXT("Bindings.json");
-
-	if (!FPaths::FileExists(SavePath))
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("No saved bindings found at: %s"), *SavePath);
-		return false;
+		PlayerManager->SwapBindings(ActionA, ActionB, Key);
 	}
+}
 
-	// Read file
-	FString JsonString;
-	if (!FFileHelper::LoadFileToString(JsonString, *SavePath))
+void UInputRebindingManager::ResetToDefault(UInputAction* Action)
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to load bindings from: %s"), *SavePath);
-		return false;
+		PlayerManager->ResetToDefault(Action);
 	}
+}
 
-	// Deserialize JSON
-	FInputBindingSaveData LoadedData;
-	if (!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &LoadedData))
+void UInputRebindingManager::ResetAllToDefaults()
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to parse bindings JSON"));
-		return false;
+		PlayerManager->ResetAllToDefaults();
 	}
-
-	SaveData = LoadedData;
-
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Bindings loaded from: %s"), *SavePath);
-	return true;
 }
 
-void UInputRebindingManager::RegisterAction(UInputAction* Action, const TArray<FKey>& Bindings)
+void UInputRebindingManager::RegisterBindingProfile(const FInputBindingProfile& Profile)
 {
-	if (!Action)
+	if (Profile.Name.IsNone())
 	{
+		UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Binding profile needs a name"));
 		return;
 	}
 
-	DefaultBindings.Add(Action, Bindings);
+	BindingProfiles.Add(Profile.Name, Profile);
+	CompileBindingProfile(Profile, CompiledBindingProfiles.FindOrAdd(Profile.Name));
 
-	// Check if we have saved bindings for this action
-	bool bFoundSaved = false;
-	for (const FActionBindingSave& Saved : SaveData.Bindings)
-	{
-		if (Saved.ActionName == Action->GetFName())
-		{
-			CurrentBindings.Add(Action, Saved.Keys);
-			bFoundSaved = true;
-			break;
-		}
-	}
-
-	// If no saved binding exists, use default
-	if (!bFoundSaved)
-	{
-		CurrentBindings.Add(Action, Bindings);
-	}
-
-	UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Registered action %s with %d default bindings"),
-		*Action->GetName(), Bindings.Num());
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Registered binding profile %s with %d bindings"),
+		*Profile.Name.ToString(), Profile.Bindings.Num());
 }
 
-void UInputRebindingManager::SetMappingContext(UInputMappingContext* Context)
+void UInputRebindingManager::UnregisterBindingProfile(FName ProfileName)
 {
-	ActiveMappingContext = Context;
-
-	if (Context)
-	{
-		// Apply any loaded custom bindings
-		ApplyLoadedBindings();
-	}
+	BindingProfiles.Remove(ProfileName);
+	CompiledBindingProfiles.Remove(ProfileName);
 }
 
-bool UInputRebindingManager::HandleKeyDown(const FKeyEvent& KeyEvent)
+TArray<FName> UInputRebindingManager::GetBindingProfileNames() const
 {
-	if (!PendingRebindAction)
-	{
-		return false;
-	}
-
-	FKey Key = KeyEvent.GetKey();
-	OnAnyKeyPressed.Broadcast(Key);
-
-	// Ignore certain keys
-	if (Key == EKeys::Escape)
-	{
-		CancelRebinding();
-		return true;
-	}
-
-	// Ignore modifier keys by themselves
-	if (Key == EKeys::LeftShift || Key == EKeys::RightShift ||
-		Key == EKeys::LeftControl || Key == EKeys::RightControl ||
-		Key == EKeys::LeftAlt || Key == EKeys::RightAlt ||
-		Key == EKeys::LeftCommand || Key == EKeys::RightCommand)
-	{
-		return true; // Consume but don't apply
-	}
+	TArray<FName> Names;
+	BindingProfiles.GetKeys(Names);
+	return Names;
+}
 
-	ApplyBinding(PendingRebindAction, Key, PendingBindingIndex);
-	return true; // Consume the input
+bool UInputRebindingManager::ApplyBindingProfile(FName ProfileName, bool bOnlyChanged)
+{
+	ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->ApplyBindingProfile(ProfileName, bOnlyChanged);
 }
 
-bool UInputRebindingManager::HandleAnalogInput(const FAnalogInputEvent& AnalogEvent)
+FName UInputRebindingManager::GetActiveBindingProfile() const
 {
-	if (!PendingRebindAction)
-	{
-		return false;
-	}
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetActiveBindingProfile() : NAME_None;
+}
 
-	// Only capture significant analog input
-	if (FMath::Abs(AnalogEvent.GetAnalogValue()) < 0.5f)
+const FCompiledBindingProfile* UInputRebindingManager::FindCompiledBindingProfile(FName ProfileName)
+{
+	FCompiledBindingProfile* Compiled = CompiledBindingProfiles.Find(ProfileName);
+	if (Compiled && Compiled->Generation != RegistrationGeneration)
 	{
-		return false;
+		// Actions were registered since; pick up their defaults and any names that now resolve
+		CompileBindingProfile(BindingProfiles.FindChecked(ProfileName), *Compiled);
 	}
 
-	FKey Key = AnalogEvent.GetKey();
-	OnAnyKeyPressed.Broadcast(Key);
-
-	ApplyBinding(PendingRebindAction, Key, PendingBindingIndex);
-	return true;
+	return Compiled;
 }
 
-void UInputRebindingManager::ApplyLoadedBindings()
+void UInputRebindingManager::CompileBindingProfile(const FInputBindingProfile& Profile, FCompiledBindingProfile& OutCompiled) const
 {
-	if (!ActiveMappingContext)
+	TMap<FName, const TArray<FKey>*> KeysByName;
+	KeysByName.Reserve(Profile.Bindings.Num());
+	for (const FActionBindingSave& Binding : Profile.Bindings)
 	{
-		return;
+		KeysByName.Add(Binding.ActionName, &Binding.Keys);
 	}
 
-	// Get the Enhanced Input subsystem
-	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetEnhancedInputSubsystem();
-	if (!Subsystem)
-	{
-		return;
-	}
+	OutCompiled.Actions.Reset(DefaultBindings.Num());
+	OutCompiled.Generation = RegistrationGeneration;
 
-	// For each registered action, update the mapping context
-	for (const auto& Pair : CurrentBindings)
+	int32 NumResolved = 0;
+	for (const auto& Pair : DefaultBindings)
 	{
-		UInputAction* Action = Pair.Key;
-		const TArray<FKey>& CustomKeys = Pair.Value;
-		const TArray<FKey>* DefaultKeys = DefaultBindings.Find(Action);
-
-		if (!Action || !DefaultKeys)
+		if (!Pair.Key)
 		{
 			continue;
 		}
 
-		// Check if bindings differ from defaults
-		for (int32 i = 0; i < CustomKeys.Num(); i++)
-		{
-			FKey CustomKey = CustomKeys[i];
-			FKey DefaultKey = DefaultKeys->IsValidIndex(i) ? (*DefaultKeys)[i] : EKeys::Invalid;
+		const TArray<FKey>* const* ProfileKeys = KeysByName.Find(Pair.Key->GetFName());
+		NumResolved += ProfileKeys ? 1 : 0;
 
-			if (CustomKey != DefaultKey)
-			{
-				ApplyBindingToMappingContext(Action, DefaultKey, CustomKey);
-			}
-		}
+		FCompiledBindingProfile::FActionKeys& Entry = OutCompiled.Actions.AddDefaulted_GetRef();
+		Entry.Action = Pair.Key;
+		Entry.Keys = ProfileKeys ? **ProfileKeys : Pair.Value;
 	}
 
-	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Applied loaded bindings to mapping context"));
+	if (NumResolved < KeysByName.Num())
+	{
+		// Usually actions that haven't been registered yet; the profile is recompiled when they are
+		UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Binding profile %s: %d of %d actions are not registered"),
+			*Profile.Name.ToString(), KeysByName.Num() - NumResolved, KeysByName.Num());
+	}
 }
 
-void UInputRebindingManager::ApplyBindingToMappingContext(UInputAction* Action, FKey OldKey, FKey NewKey)
+void UInputRebindingManager::SetMouseSensitivity(float Sensitivity)
 {
-	if (!ActiveMappingContext || !Action)
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		return;
+		PlayerManager->SetMouseSensitivity(Sensitivity);
 	}
+}
 
-	// Get mutable mappings
-	TArray<FEnhancedActionKeyMapping>& Mappings = const_cast<TArray<FEnhancedActionKeyMapping>&>(ActiveMappingContext->GetMappings());
+float UInputRebindingManager::GetMouseSensitivity() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetMouseSensitivity() : 1.0f;
+}
 
-	// Find and update the mapping
-	bool bFoundMapping = false;
-	for (FEnhancedActionKeyMapping& Mapping : Mappings)
+void UInputRebindingManager::SetGamepadSensitivity(float Sensitivity)
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		if (Mapping.Action == Action && Mapping.Key == OldKey)
-		{
-			if (NewKey.IsValid())
-			{
-				Mapping.Key = NewKey;
-				UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Updated mapping: %s -> %s for action %s"),
-					*OldKey.ToString(), *NewKey.ToString(), *Action->GetName());
-			}
-			else
-			{
-				// Remove the mapping by setting to invalid (actual removal is complex)
-				Mapping.Key = EKeys::Invalid;
-			}
-			bFoundMapping = true;
-			break;
-		}
+		PlayerManager->SetGamepadSensitivity(Sensitivity);
 	}
+}
 
-	// If adding a new binding and no existing mapping found
-	if (!bFoundMapping && NewKey.IsValid() && !OldKey.IsValid())
-	{
-		// Add new mapping
-		FEnhancedActionKeyMapping NewMapping;
-		NewMapping.Action = Action;
-		NewMapping.Key = NewKey;
-		Mappings.Add(NewMapping);
-		UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Added new mapping: %s for action %s"),
-			*NewKey.ToString(), *Action->GetName());
-	}
+float UInputRebindingManager::GetGamepadSensitivity() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetGamepadSensitivity() : 1.0f;
+}
 
-	// Request rebuild of the input system
-	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetEnhancedInputSubsystem();
-	if (Subsystem)
+void UInputRebindingManager::SetGyroSensitivity(float Sensitivity)
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		// Force rebind by removing and re-adding the context
-		int32 Priority = 0;
-		Subsystem->RemoveMappingContext(ActiveMappingContext);
-		Subsystem->AddMappingContext(ActiveMappingContext, Priority);
+		PlayerManager->SetGyroSensitivity(Sensitivity);
 	}
 }
 
-UEnhancedInputLocalPlayerSubsystem* UInputRebindingManager::GetEnhancedInputSubsystem() const
+float UInputRebindingManager::GetGyroSensitivity() const
 {
-	UGameInstance* GameInstance = GetGameInstance();
-	if (!GameInstance)
-	{
-		return nullptr;
-	}
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetGyroSensitivity() : 1.0f;
+}
 
-	APlayerController* PC = GameInstance->GetFirstLocalPlayerController();
-	if (!PC)
+void UInputRebindingManager::SetInvertY(bool bInvert)
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		return nullptr;
+		PlayerManager->SetInvertY(bInvert);
 	}
+}
+
+bool UInputRebindingManager::GetInvertY() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->GetInvertY();
+}
 
-	ULocalPlayer* LocalPlayer = PC->GetLocalPlayer();
-	if (!LocalPlayer)
+void UInputRebindingManager::SetGyroEnabled(bool bEnabled)
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		return nullptr;
+		PlayerManager->SetGyroEnabled(bEnabled);
 	}
-
-	return LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
 }
 
-// ============== FRebindInputProcessor Implementation ==============
+bool UInputRebindingManager::GetGyroEnabled() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->GetGyroEnabled();
+}
 
-bool FRebindInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+bool UInputRebindingManager::SaveBindings()
 {
-	if (Manager.IsValid() && Manager->IsRebindingInProgress())
-	{
-		return Manager->HandleKeyDown(InKeyEvent);
-	}
-	return false;
+	ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->SaveBindings();
 }
 
-bool FRebindInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent)
+bool UInputRebindingManager::ExportBindingsToJson(const FString& FilePath)
 {
-	if (Manager.IsValid() && Manager->IsRebindingInProgress())
-	{
-		return Manager->HandleAnalogInput(InAnalogInputEvent);
-	}
-	return false;
+	ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->ExportBindingsToJson(FilePath);
 }
 
-bool FRebindInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+bool UInputRebindingManager::LoadBindings()
 {
-	if (Manager.IsValid() && Manager->IsRebindingInProgress())
-	{
-		FKey Key = MouseEvent.GetEffectingButton();
-		Manager->OnAnyKeyPressed.Broadcast(Key);
+	ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager && PlayerManager->LoadBindings();
+}
 
-		// Don't bind left mouse click (used for UI interaction)
-		if (Key == EKeys::LeftMouseButton)
-		{
-			return false;
-		}
+FString UInputRebindingManager::GetSaveSlotName() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetSaveSlotName() : TEXT("InputBindings");
+}
 
-		Manager->ApplyBinding(Manager->GetPendingRebindAction(), Key, 0);
-		return true;
+void UInputRebindingManager::SetMappingContext(UInputMappingContext* Context, int32 Priority)
+{
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
+	{
+		PlayerManager->SetMappingContext(Context, Priority);
 	}
-	return false;
 }
 
-bool FRebindInputProcessor::HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent)
+UInputMappingContext* UInputRebindingManager::GetMappingContext() const
+{
+	const ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager();
+	return PlayerManager ? PlayerManager->GetMappingContext() : nullptr;
+}
+
+void UInputRebindingManager::FlushPendingMappingChanges()
 {
-	if (Manager.IsValid() && Manager->IsRebindingInProgress())
+	if (ULocalPlayerRebindingManager* PlayerManager = GetPrimaryPlayerManager())
 	{
-		FKey Key = InWheelEvent.GetWheelDelta() > 0 ? EKeys::MouseScrollUp : EKeys::MouseScrollDown;
-		Manager->OnAnyKeyPressed.Broadcast(Key);
-		Manager->ApplyBinding(Manager->GetPendingRebindAction(), Key, 0);
-		return true;
+		PlayerManager->FlushPendingMappingChanges();
 	}
-	return false;
 }
@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputStreamlinerFileUtils.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace InputStreamlinerFileUtils
+{
+	FString GetTempPath(const FString& FilePath)
+	{
+		return FilePath + TEXT(".tmp");
+	}
+
+	bool MoveIntoPlace(const FString& TempPath, const FString& FilePath)
+	{
+		if (!IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to move %s to %s"), *TempPath, *FilePath);
+			IFileManager::Get().Delete(*TempPath, false, true, true);
+			return false;
+		}
+
+		return true;
+	}
+}
+
+bool FInputStreamlinerFileUtils::SaveBytesAtomically(const TArray<uint8>& Bytes, const FString& FilePath)
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+	const FString TempPath = InputStreamlinerFileUtils::GetTempPath(FilePath);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to write %s"), *TempPath);
+		return false;
+	}
+
+	return InputStreamlinerFileUtils::MoveIntoPlace(TempPath, FilePath);
+}
+
+bool FInputStreamlinerFileUtils::SaveStringAtomically(const FString& Text, const FString& FilePath)
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+
+	const FString TempPath = InputStreamlinerFileUtils::GetTempPath(FilePath);
+	if (!FFileHelper::SaveStringToFile(Text, *TempPath))
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to write %s"), *TempPath);
+		return false;
+	}
+
+	return InputStreamlinerFileUtils::MoveIntoPlace(TempPath, FilePath);
+}
@@ -0,0 +1,177 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputStreamlinerMetrics.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+UE_TRACE_CHANNEL_DEFINE(InputStreamlinerChannel);
+
+static FAutoConsoleCommandWithArgsAndOutputDevice InputStreamlinerMetricsCommand(
+	TEXT("InputStreamliner.Metrics"),
+	TEXT("Print the Input Streamliner counters and timings. Pass 'reset' to clear them afterwards."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		FInputStreamlinerMetrics::Dump(Ar);
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+		{
+			FInputStreamlinerMetrics::Reset();
+			Ar.Log(TEXT("Input Streamliner metrics reset"));
+		}
+	}));
+
+FCriticalSection& FInputStreamlinerMetrics::GetLock()
+{
+	static FCriticalSection Lock;
+	return Lock;
+}
+
+TMap<FName, TUniquePtr<FInputStreamlinerMetrics::FAtomicMetric>>& FInputStreamlinerMetrics::GetMetrics()
+{
+	static TMap<FName, TUniquePtr<FAtomicMetric>> Metrics;
+	return Metrics;
+}
+
+std::atomic<uint64>& FInputStreamlinerMetrics::GetResetFrame()
+{
+	static std::atomic<uint64> ResetFrame = 0;
+	return ResetFrame;
+}
+
+namespace InputStreamlinerMetrics
+{
+	template <typename T, typename PredicateType>
+	void UpdateIf(std::atomic<T>& Target, T Value, PredicateType Predicate)
+	{
+		T Current = Target.load(std::memory_order_relaxed);
+		while (Predicate(Value, Current) && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void AtomicAdd(std::atomic<double>& Target, double Value)
+	{
+		double Current = Target.load(std::memory_order_relaxed);
+		while (!Target.compare_exchange_weak(Current, Current + Value, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+FInputStreamlinerMetrics::FMetricId FInputStreamlinerMetrics::FindOrAddMetric(FName Name)
+{
+	FScopeLock Lock(&GetLock());
+	TUniquePtr<FAtomicMetric>& Metric = GetMetrics().FindOrAdd(Name);
+	if (!Metric)
+	{
+		// Entries are never removed, so ids stay valid across resets
+		Metric = MakeUnique<FAtomicMetric>();
+	}
+	return FMetricId(Metric.Get());
+}
+
+void FInputStreamlinerMetrics::Record(FMetricId Id, double Value)
+{
+	using namespace InputStreamlinerMetrics;
+
+	FAtomicMetric* Metric = Id.Metric;
+	if (!Metric)
+	{
+		return;
+	}
+
+	const uint64 Frame = GFrameCounter;
+
+	UpdateIf(Metric->Min, Value, [](double New, double Current) { return New < Current; });
+	UpdateIf(Metric->Max, Value, [](double New, double Current) { return New > Current; });
+	AtomicAdd(Metric->Total, Value);
+	Metric->Last.store(Value, std::memory_order_relaxed);
+	Metric->Count.fetch_add(1, std::memory_order_relaxed);
+
+	// Samples recorded from other threads exactly at a frame boundary may land in either frame
+	int32 CountInFrame = 1;
+	if (Metric->LastFrame.exchange(Frame, std::memory_order_relaxed) == Frame)
+	{
+		CountInFrame = Metric->CountInLastFrame.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+	else
+	{
+		Metric->CountInLastFrame.store(1, std::memory_order_relaxed);
+	}
+	UpdateIf(Metric->MaxPerFrame, CountInFrame, [](int32 New, int32 Current) { return New > Current; });
+}
+
+TArray<TPair<FName, FInputStreamlinerMetrics::FMetric>> FInputStreamlinerMetrics::GetSnapshot()
+{
+	TArray<TPair<FName, FMetric>> Snapshot;
+	{
+		FScopeLock Lock(&GetLock());
+		Snapshot.Reserve(GetMetrics().Num());
+		for (const TPair<FName, TUniquePtr<FAtomicMetric>>& Pair : GetMetrics())
+		{
+			const FAtomicMetric& Live = *Pair.Value;
+			FMetric Metric;
+			Metric.Count = Live.Count.load(std::memory_order_relaxed);
+			if (Metric.Count == 0)
+			{
+				// Registered but nothing recorded since the last reset
+				continue;
+			}
+			Metric.Total = Live.Total.load(std::memory_order_relaxed);
+			Metric.Min = Live.Min.load(std::memory_order_relaxed);
+			Metric.Max = Live.Max.load(std::memory_order_relaxed);
+			Metric.Last = Live.Last.load(std::memory_order_relaxed);
+			Metric.MaxPerFrame = Live.MaxPerFrame.load(std::memory_order_relaxed);
+			Metric.LastFrame = Live.LastFrame.load(std::memory_order_relaxed);
+			Metric.CountInLastFrame = Live.CountInLastFrame.load(std::memory_order_relaxed);
+			Snapshot.Emplace(Pair.Key, Metric);
+		}
+	}
+
+	Snapshot.Sort([](const TPair<FName, FMetric>& A, const TPair<FName, FMetric>& B)
+	{
+		return A.Key.LexicalLess(B.Key);
+	});
+	return Snapshot;
+}
+
+uint64 FInputStreamlinerMetrics::GetFramesSinceReset()
+{
+	return GFrameCounter - GetResetFrame().load(std::memory_order_relaxed);
+}
+
+void FInputStreamlinerMetrics::Reset()
+{
+	FScopeLock Lock(&GetLock());
+	for (const TPair<FName, TUniquePtr<FAtomicMetric>>& Pair : GetMetrics())
+	{
+		FAtomicMetric& Metric = *Pair.Value;
+		Metric.Count.store(0, std::memory_order_relaxed);
+		Metric.Total.store(0.0, std::memory_order_relaxed);
+		Metric.Min.store(TNumericLimits<double>::Max(), std::memory_order_relaxed);
+		Metric.Max.store(TNumericLimits<double>::Lowest(), std::memory_order_relaxed);
+		Metric.Last.store(0.0, std::memory_order_relaxed);
+		Metric.MaxPerFrame.store(0, std::memory_order_relaxed);
+		Metric.LastFrame.store(MAX_uint64, std::memory_order_relaxed);
+		Metric.CountInLastFrame.store(0, std::memory_order_relaxed);
+	}
+	GetResetFrame().store(GFrameCounter, std::memory_order_relaxed);
+}
+
+void FInputStreamlinerMetrics::Dump(FOutputDevice& Ar)
+{
+	const TArray<TPair<FName, FMetric>> Snapshot = GetSnapshot();
+	const uint64 Frames = FMath::Max<uint64>(GetFramesSinceReset(), 1);
+
+	Ar.Logf(TEXT("Input Streamliner metrics over %llu frames (%d metrics)"), Frames, Snapshot.Num());
+	Ar.Logf(TEXT("%-36s %8s %10s %10s %10s %10s %10s %8s %8s"),
+		TEXT("Name"), TEXT("Count"), TEXT("Avg"), TEXT("Min"), TEXT("Max"), TEXT("Last"), TEXT("Total"), TEXT("/Frame"), TEXT("MaxFrame"));
+
+	for (const TPair<FName, FMetric>& Pair : Snapshot)
+	{
+		const FMetric& Metric = Pair.Value;
+		Ar.Logf(TEXT("%-36s %8lld %10.3f %10.3f %10.3f %10.3f %10.1f %8.3f %8d"),
+			*Pair.Key.ToString(), Metric.Count, Metric.GetAverage(), Metric.Min, Metric.Max, Metric.Last, Metric.Total,
+			static_cast<double>(Metric.Count) / Frames, Metric.MaxPerFrame);
+	}
+}
@@ -1,6 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "InputStreamlinerRuntimeModule.h"
+#include "InputAssetManifest.h"
+#include "InputStreamlinerRuntimeSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 
 #define LOCTEXT_NAMESPACE "FInputStreamlinerRuntimeModule"
 
@@ -13,9 +17,101 @@ void FInputStreamlinerRuntimeModule::StartupModule()
 
 void FInputStreamlinerRuntimeModule::ShutdownModule()
 {
+	PendingCallbacks.Empty();
+	AssetsHandle.Reset();
+	ManifestHandle.Reset();
+
 	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("InputStreamlinerRuntime module shutting down"));
 }
 
+void FInputStreamlinerRuntimeModule::PreloadGeneratedAssets(FOnGeneratedInputAssetsLoaded OnLoaded)
+{
+	const FSoftObjectPath ManifestPath = GetDefault<UInputStreamlinerRuntimeSettings>()->GeneratedAssetManifest.ToSoftObjectPath();
+	if (bPreloadRequested && ManifestPath != RequestedManifestPath)
+	{
+		// The generator pointed the settings at a new manifest since the last load (editor only in practice)
+		AssetsHandle.Reset();
+		ManifestHandle.Reset();
+		bPreloadRequested = false;
+		bGeneratedAssetsLoaded = false;
+	}
+
+	if (bGeneratedAssetsLoaded)
+	{
+		OnLoaded.ExecuteIfBound(GetGeneratedAssetManifest());
+		return;
+	}
+
+	PendingCallbacks.Add(MoveTemp(OnLoaded));
+	if (bPreloadRequested)
+	{
+		return;
+	}
+	bPreloadRequested = true;
+	RequestedManifestPath = ManifestPath;
+
+	if (ManifestPath.IsNull() || !UAssetManager::IsInitialized())
+	{
+		HandleGeneratedAssetsLoaded();
+		return;
+	}
+
+	PreloadStartTime = FPlatformTime::Seconds();
+	ManifestHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ManifestPath,
+		FStreamableDelegate::CreateRaw(this, &FInputStreamlinerRuntimeModule::HandleManifestLoaded));
+	if (!ManifestHandle.IsValid())
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Could not request the generated asset manifest: %s"), *ManifestPath.ToString());
+		HandleGeneratedAssetsLoaded();
+	}
+}
+
+const UInputAssetManifest* FInputStreamlinerRuntimeModule::GetGeneratedAssetManifest() const
+{
+	return GetDefault<UInputStreamlinerRuntimeSettings>()->GeneratedAssetManifest.Get();
+}
+
+void FInputStreamlinerRuntimeModule::HandleManifestLoaded()
+{
+	const UInputAssetManifest* Manifest = GetGeneratedAssetManifest();
+	const TArray<FSoftObjectPath> AssetPaths = Manifest ? Manifest->GetAssetPathsForPlatforms(UInputAssetManifest::GetCurrentPlatformNames()) : TArray<FSoftObjectPath>();
+	if (AssetPaths.Num() == 0)
+	{
+		HandleGeneratedAssetsLoaded();
+		return;
+	}
+
+	AssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetPaths,
+		FStreamableDelegate::CreateRaw(this, &FInputStreamlinerRuntimeModule::HandleGeneratedAssetsLoaded));
+	if (!AssetsHandle.IsValid())
+	{
+		HandleGeneratedAssetsLoaded();
+	}
+}
+
+void FInputStreamlinerRuntimeModule::HandleGeneratedAssetsLoaded()
+{
+	if (bGeneratedAssetsLoaded)
+	{
+		return;
+	}
+	bGeneratedAssetsLoaded = true;
+
+	const UInputAssetManifest* Manifest = GetGeneratedAssetManifest();
+	if (Manifest)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Preloaded generated input assets from %s in %.1f ms"),
+			*Manifest->GetName(), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+	}
+
+	// Callbacks may request again (e.g. a second game instance in PIE), which now completes immediately
+	TArray<FOnGeneratedInputAssetsLoaded> Callbacks = MoveTemp(PendingCallbacks);
+	for (FOnGeneratedInputAssetsLoaded& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(Manifest);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FInputStreamlinerRuntimeModule, InputStreamlinerRuntime)
@@ -0,0 +1,10 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputStreamlinerRuntimeSettings.h"
+#include "InputAssetManifest.h"
+
+UInputStreamlinerRuntimeSettings::UInputStreamlinerRuntimeSettings()
+{
+	CategoryName = TEXT("Plugins");
+	SectionName = TEXT("InputStreamliner");
+}
@@ -0,0 +1,1266 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LocalPlayerRebindingManager.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "GameFramework/InputSettings.h"
+#include "EnhancedInputSubsystems.h"
+#include "InputMappingContext.h"
+#include "EnhancedActionKeyMapping.h"
+#include "Framework/Application/SlateApplication.h"
+#include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameInstance.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Crc.h"
+#include "InputBindingSaveFormat.h"
+#include "InputStreamlinerFileUtils.h"
+#include "InputStreamlinerRuntimeSettings.h"
+#include "InputStreamlinerMetrics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Mapping Update"), STAT_InputStreamliner_MappingUpdate, STATGROUP_InputStreamliner);
+DECLARE_CYCLE_STAT(TEXT("Mapping Rebuild"), STAT_InputStreamliner_MappingRebuild, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Mapping Rebuilds"), STAT_InputStreamliner_MappingRebuilds, STATGROUP_InputStreamliner);
+DECLARE_CYCLE_STAT(TEXT("Save Bindings"), STAT_InputStreamliner_SaveBindings, STATGROUP_InputStreamliner);
+DECLARE_CYCLE_STAT(TEXT("Load Bindings"), STAT_InputStreamliner_LoadBindings, STATGROUP_InputStreamliner);
+DECLARE_MEMORY_STAT(TEXT("Saved Bindings Size"), STAT_InputStreamliner_SavedBindingsSize, STATGROUP_InputStreamliner);
+
+namespace InputRebindingPaths
+{
+	FString GetSaveDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("InputStreamliner");
+	}
+
+	/** JSON file written by older versions, migrated on load into the first player's slot */
+	FString GetLegacyBindingsPath()
+	{
+		return GetSaveDir() / TEXT("Bindings.json");
+	}
+
+	/** Suffix for per-player files; empty for the first player so existing saves keep working */
+	FString GetPlayerSuffix(const ULocalPlayer* LocalPlayer)
+	{
+		const int32 PlayerIndex = LocalPlayer ? LocalPlayer->GetLocalPlayerIndex() : 0;
+		return PlayerIndex > 0 ? FString::Printf(TEXT("_P%d"), PlayerIndex) : FString();
+	}
+}
+
+void ULocalPlayerRebindingManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UGameInstance* GameInstance = GetLocalPlayer()->GetGameInstance();
+	SharedManager = GameInstance ? GameInstance->GetSubsystem<UInputRebindingManager>() : nullptr;
+
+	// Create input processor for capturing rebind keys
+	RebindInputProcessor = MakeShareable(new FRebindInputProcessor(this));
+
+	// Binding changes are applied in one rebuild at the end of the frame
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ULocalPlayerRebindingManager::HandleEndFrame);
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Rebinding state initialized for local player %d"), GetLocalPlayer()->GetLocalPlayerIndex());
+
+	// Load saved bindings; actions registered before this player joined start from their defaults otherwise
+	if (!LoadBindings() && SharedManager)
+	{
+		for (const auto& Pair : SharedManager->GetDefaultBindings())
+		{
+			InitializeActionBindings(Pair.Key);
+		}
+	}
+
+	// Joined after the generated assets were preloaded
+	if (SharedManager && SharedManager->GetGeneratedMappingContext() && !ActiveMappingContext)
+	{
+		SetMappingContext(SharedManager->GetGeneratedMappingContext(), GetDefault<UInputStreamlinerRuntimeSettings>()->GeneratedMappingContextPriority);
+	}
+}
+
+void ULocalPlayerRebindingManager::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+	DirtyActions.Empty();
+	ActionBindingsChangedDelegates.Empty();
+
+	// Remove input processor
+	if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(RebindInputProcessor);
+	}
+	RebindInputProcessor.Reset();
+
+	// Auto-save on shutdown
+	SaveBindings();
+	WaitForPendingSave();
+
+	Super::Deinitialize();
+}
+
+void ULocalPlayerRebindingManager::StartRebinding(UInputAction* Action)
+{
+	if (!Action)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Cannot start rebinding: null action"));
+		return;
+	}
+
+	PendingRebindAction = Action;
+	PendingBindingIndex = 0;
+
+	// Register input processor to capture next key press
+	if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().RegisterInputPreProcessor(RebindInputProcessor);
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Started rebinding for action: %s"), *Action->GetName());
+}
+
+void ULocalPlayerRebindingManager::CancelRebinding()
+{
+	if (PendingRebindAction)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Cancelled rebinding for action: %s"),
+			*PendingRebindAction->GetName());
+	}
+
+	// Unregister input processor
+	if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(RebindInputProcessor);
+	}
+
+	PendingRebindAction = nullptr;
+	PendingBindingIndex = 0;
+}
+
+TArray<FKey> ULocalPlayerRebindingManager::GetBindingsForAction(UInputAction* Action) const
+{
+	if (!Action)
+	{
+		return TArray<FKey>();
+	}
+
+	const TArray<FKey>* CustomBindings = CurrentBindings.Find(Action);
+	if (CustomBindings)
+	{
+		return *CustomBindings;
+	}
+
+	const TArray<FKey>* Defaults = FindDefaultBindings(Action);
+	if (Defaults)
+	{
+		return *Defaults;
+	}
+
+	return TArray<FKey>();
+}
+
+bool ULocalPlayerRebindingManager::ApplyBinding(UInputAction* Action, FKey NewKey, int32 BindingIndex)
+{
+	if (!Action || !NewKey.IsValid())
+	{
+		return false;
+	}
+
+	// Check for conflicts
+	UInputAction* ConflictingAction = nullptr;
+	if (HasConflict(Action, NewKey, ConflictingAction))
+	{
+		OnBindingConflict.Broadcast(ConflictingAction, NewKey);
+		if (SharedManager)
+		{
+			SharedManager->OnBindingConflict.Broadcast(ConflictingAction, NewKey);
+		}
+		// Don't apply - let the UI handle conflict resolution
+		return false;
+	}
+
+	// Get or create binding array
+	TArray<FKey>& Bindings = CurrentBindings.FindOrAdd(Action);
+
+	// Ensure array is large enough
+	while (Bindings.Num() <= BindingIndex)
+	{
+		Bindings.Add(EKeys::Invalid);
+	}
+
+	RemoveKeyFromIndex(Action, Bindings[BindingIndex]);
+	Bindings[BindingIndex] = NewKey;
+	AddKeyToIndex(Action, NewKey);
+
+	// Apply to mapping context
+	SetMappingKey(Action, BindingIndex, NewKey);
+
+	ActiveBindingProfile = NAME_None;
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Applied binding %s to action %s at index %d"),
+		*NewKey.ToString(), *Action->GetName(), BindingIndex);
+
+	NotifyActionBindingsChanged(Action);
+	OnRebindComplete.Broadcast(Action, NewKey);
+	if (SharedManager)
+	{
+		SharedManager->OnRebindComplete.Broadcast(Action, NewKey);
+	}
+
+	// Clear rebinding state
+	if (PendingRebindAction == Action)
+	{
+		// Unregister input processor
+		if (RebindInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+		{
+			FSlateApplication::Get().UnregisterInputPreProcessor(RebindInputProcessor);
+		}
+		PendingRebindAction = nullptr;
+	}
+
+	return true;
+}
+
+bool ULocalPlayerRebindingManager::RemoveBinding(UInputAction* Action, int32 BindingIndex)
+{
+	if (!Action)
+	{
+		return false;
+	}
+
+	TArray<FKey>* Bindings = CurrentBindings.Find(Action);
+	if (!Bindings || !Bindings->IsValidIndex(BindingIndex))
+	{
+		return false;
+	}
+
+	FKey OldKey = (*Bindings)[BindingIndex];
+	(*Bindings)[BindingIndex] = EKeys::Invalid;
+	RemoveKeyFromIndex(Action, OldKey);
+
+	// Update mapping context
+	SetMappingKey(Action, BindingIndex, EKeys::Invalid);
+	ActiveBindingProfile = NAME_None;
+
+	NotifyActionBindingsChanged(Action);
+	return true;
+}
+
+bool ULocalPlayerRebindingManager::HasConflict(UInputAction* Action, FKey Key, UInputAction*& OutConflictingAction) const
+{
+	OutConflictingAction = nullptr;
+
+	const TArray<TObjectPtr<UInputAction>>* BoundActions = ActionsByKey.Find(Key);
+	if (!BoundActions)
+	{
+		return false;
+	}
+
+	for (UInputAction* BoundAction : *BoundActions)
+	{
+		if (BoundAction != Action)
+		{
+			OutConflictingAction = BoundAction;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TArray<FInputBindingConflict> ULocalPlayerRebindingManager::GetAllConflicts() const
+{
+	TArray<FInputBindingConflict> Conflicts;
+
+	for (const auto& Pair : ActionsByKey)
+	{
+		if (Pair.Value.Num() < 2)
+		{
+			continue;
+		}
+
+		FInputBindingConflict Conflict;
+		Conflict.Key = Pair.Key;
+		for (UInputAction* BoundAction : Pair.Value)
+		{
+			Conflict.Actions.AddUnique(BoundAction);
+		}
+
+		// The same action bound twice to one key is not a conflict
+		if (Conflict.Actions.Num() > 1)
+		{
+			Conflicts.Add(MoveTemp(Conflict));
+		}
+	}
+
+	return Conflicts;
+}
+
+TArray<UInputAction*> ULocalPlayerRebindingManager::GetActionsForKey(FKey Key) const
+{
+	TArray<UInputAction*> Actions;
+
+	if (const TArray<TObjectPtr<UInputAction>>* BoundActions = ActionsByKey.Find(Key))
+	{
+		for (UInputAction* BoundAction : *BoundActions)
+		{
+			Actions.AddUnique(BoundAction);
+		}
+	}
+
+	return Actions;
+}
+
+void ULocalPlayerRebindingManager::SwapBindings(UInputAction* ActionA, UInputAction* ActionB, FKey Key)
+{
+	if (!ActionA || !ActionB)
+	{
+		return;
+	}
+
+	// Add both entries before taking references; adding can reallocate the map
+	CurrentBindings.FindOrAdd(ActionA);
+	CurrentBindings.FindOrAdd(ActionB);
+	TArray<FKey>& BindingsA = CurrentBindings[ActionA];
+	TArray<FKey>& BindingsB = CurrentBindings[ActionB];
+
+	// Find indices
+	int32 IndexA = BindingsA.Find(Key);
+	int32 IndexB = BindingsB.Find(Key);
+
+	if (IndexB != INDEX_NONE)
+	{
+		// Remove from B
+		BindingsB[IndexB] = EKeys::Invalid;
+		RemoveKeyFromIndex(ActionB, Key);
+		SetMappingKey(ActionB, IndexB, EKeys::Invalid);
+	}
+
+	// Add to A
+	if (IndexA == INDEX_NONE)
+	{
+		const int32 NewIndex = BindingsA.Add(Key);
+		AddKeyToIndex(ActionA, Key);
+		SetMappingKey(ActionA, NewIndex, Key);
+	}
+
+	ActiveBindingProfile = NAME_None;
+	NotifyActionBindingsChanged(ActionA);
+	NotifyActionBindingsChanged(ActionB);
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Swapped binding %s from %s to %s"),
+		*Key.ToString(), *ActionB->GetName(), *ActionA->GetName());
+}
+
+void ULocalPlayerRebindingManager::ResetToDefault(UInputAction* Action)
+{
+	if (!Action)
+	{
+		return;
+	}
+
+	const TArray<FKey>* Defaults = FindDefaultBindings(Action);
+	if (Defaults)
+	{
+		SetCurrentBindings(Action, *Defaults);
+
+		// Update mapping context to match the defaults
+		SyncActionMappings(Action);
+	}
+	else
+	{
+		ClearCurrentBindings(Action);
+	}
+
+	ActiveBindingProfile = NAME_None;
+	NotifyActionBindingsChanged(Action);
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Reset action %s to defaults"), *Action->GetName());
+}
+
+void ULocalPlayerRebindingManager::ResetAllToDefaults()
+{
+	CurrentBindings.Empty();
+
+	if (SharedManager)
+	{
+		for (const auto& Pair : SharedManager->GetDefaultBindings())
+		{
+			CurrentBindings.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	RebuildKeyIndex();
+	ActiveBindingProfile = NAME_None;
+
+	// Reset sensitivity settings
+	SaveData.MouseSensitivity = 1.0f;
+	SaveData.GamepadSensitivity = 1.0f;
+	SaveData.GyroSensitivity = 1.0f;
+	SaveData.bInvertY = false;
+
+	// Reapply all bindings to mapping context
+	ApplyLoadedBindings();
+
+	for (const auto& Pair : CurrentBindings)
+	{
+		NotifyActionBindingsChanged(Pair.Key);
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Reset all bindings to defaults"));
+}
+
+bool ULocalPlayerRebindingManager::ApplyBindingProfile(FName ProfileName, bool bOnlyChanged)
+{
+	const FCompiledBindingProfile* Profile = SharedManager ? SharedManager->FindCompiledBindingProfile(ProfileName) : nullptr;
+	if (!Profile)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Warning, TEXT("Unknown binding profile: %s"), *ProfileName.ToString());
+		return false;
+	}
+
+	FInputStreamlinerMetrics::FScopedTimer Timer(TEXT("Bindings.ProfileApplyMs"));
+
+	// A key captured mid-switch would land on the new profile
+	if (PendingRebindAction)
+	{
+		CancelRebinding();
+	}
+
+	TArray<UInputAction*> ChangedActions;
+	for (const FCompiledBindingProfile::FActionKeys& Entry : Profile->Actions)
+	{
+		const TArray<FKey>* Current = CurrentBindings.Find(Entry.Action);
+		if (bOnlyChanged && Current && *Current == Entry.Keys)
+		{
+			continue;
+		}
+
+		// Profiles are applied as authored, so there is no per-key conflict check
+		SetCurrentBindings(Entry.Action, Entry.Keys);
+		SyncActionMappings(Entry.Action);
+		if (!bOnlyChanged && MappingSlotsByAction.Contains(Entry.Action.Get()))
+		{
+			// Rebuild even if the mappings already match
+			DirtyActions.Add(Entry.Action);
+		}
+		ChangedActions.Add(Entry.Action);
+	}
+
+	ActiveBindingProfile = ProfileName;
+	const int32 NumProfileActions = Profile->Actions.Num();
+
+	// The whole switch lands in one rebuild, before anyone hears about it
+	FlushPendingMappingChanges();
+	FInputStreamlinerMetrics::Record(TEXT("Bindings.ProfileChangedActions"), ChangedActions.Num());
+
+	// Listeners may register profiles, so Profile is not used past this point
+
+	for (UInputAction* Action : ChangedActions)
+	{
+		NotifyActionBindingsChanged(Action);
+	}
+
+	OnBindingProfileApplied.Broadcast(ProfileName, ChangedActions);
+	if (SharedManager)
+	{
+		SharedManager->OnBindingProfileApplied.Broadcast(ProfileName, ChangedActions);
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Applied binding profile %s (%d of %d actions changed)"),
+		*ProfileName.ToString(), ChangedActions.Num(), NumProfileActions);
+	return true;
+}
+
+void ULocalPlayerRebindingManager::SetMouseSensitivity(float Sensitivity)
+{
+	SaveData.MouseSensitivity = FMath::Clamp(Sensitivity, FInputBindingSaveFormat::MinSensitivity, FInputBindingSaveFormat::MaxSensitivity);
+}
+
+void ULocalPlayerRebindingManager::SetGamepadSensitivity(float Sensitivity)
+{
+	SaveData.GamepadSensitivity = FMath::Clamp(Sensitivity, FInputBindingSaveFormat::MinSensitivity, FInputBindingSaveFormat::MaxSensitivity);
+}
+
+void ULocalPlayerRebindingManager::SetGyroSensitivity(float Sensitivity)
+{
+	SaveData.GyroSensitivity = FMath::Clamp(Sensitivity, FInputBindingSaveFormat::MinSensitivity, FInputBindingSaveFormat::MaxSensitivity);
+}
+
+void ULocalPlayerRebindingManager::SetInvertY(bool bInvert)
+{
+	SaveData.bInvertY = bInvert;
+}
+
+void ULocalPlayerRebindingManager::SetGyroEnabled(bool bEnabled)
+{
+	SaveData.bGyroEnabled = bEnabled;
+}
+
+void ULocalPlayerRebindingManager::UpdateSaveData()
+{
+	TArray<FActionBindingSave> Bindings;
+	TSet<FName> RegisteredNames;
+
+	for (const auto& Pair : CurrentBindings)
+	{
+		if (!Pair.Key)
+		{
+			continue;
+		}
+
+		RegisteredNames.Add(Pair.Key->GetFName());
+
+		// Only store the delta against the defaults
+		const TArray<FKey>* Defaults = FindDefaultBindings(Pair.Key);
+		if (Defaults && *Defaults == Pair.Value)
+		{
+			continue;
+		}
+
+		FActionBindingSave BindingSave;
+		BindingSave.ActionName = Pair.Key->GetFName();
+		BindingSave.Keys = Pair.Value;
+		Bindings.Add(MoveTemp(BindingSave));
+	}
+
+	// Keep saved bindings for actions that have not been registered this session
+	for (FActionBindingSave& Saved : SaveData.Bindings)
+	{
+		if (!RegisteredNames.Contains(Saved.ActionName))
+		{
+			Bindings.Add(MoveTemp(Saved));
+		}
+	}
+
+	// Stable order so unchanged bindings produce an identical file
+	Bindings.Sort([](const FActionBindingSave& A, const FActionBindingSave& B)
+	{
+		return A.ActionName.LexicalLess(B.ActionName);
+	});
+
+	SaveData.Bindings = MoveTemp(Bindings);
+	RebuildSavedBindingIndex();
+}
+
+void ULocalPlayerRebindingManager::RebuildSavedBindingIndex()
+{
+	SavedBindingIndexByName.Reset();
+	SavedBindingIndexByName.Reserve(SaveData.Bindings.Num());
+
+	for (int32 Index = 0; Index < SaveData.Bindings.Num(); ++Index)
+	{
+		SavedBindingIndexByName.Add(SaveData.Bindings[Index].ActionName, Index);
+	}
+}
+
+bool ULocalPlayerRebindingManager::SaveBindings()
+{
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_SaveBindings);
+	INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_SaveBindings);
+	FInputStreamlinerMetrics::FScopedTimer Timer(TEXT("Bindings.SaveMs"));
+
+	UpdateSaveData();
+	SaveData.Version = FInputBindingSaveFormat::CurrentVersion;
+
+	TArray<uint8> Bytes;
+	FInputBindingSaveFormat::Write(SaveData, Bytes);
+
+	const uint32 Crc = FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+	if (bHasLastSavedCrc && Crc == LastSavedCrc && !bLastSaveFailed)
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Bindings unchanged, skipping save"));
+		return true;
+	}
+
+	LastSavedCrc = Crc;
+	bHasLastSavedCrc = true;
+	bLastSaveFailed = false;
+
+	FInputStreamlinerMetrics::Record(TEXT("Bindings.SaveBytes"), Bytes.Num());
+	SET_MEMORY_STAT(STAT_InputStreamliner_SavedBindingsSize, Bytes.Num());
+
+	const FString SavePath = GetBindingsFilePath();
+	auto WriteFile = [this, Bytes = MoveTemp(Bytes), SavePath]()
+	{
+		INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_WriteBindings);
+		FInputStreamlinerMetrics::FScopedTimer WriteTimer(TEXT("Bindings.WriteMs"));
+
+		if (FInputStreamlinerFileUtils::SaveBytesAtomically(Bytes, SavePath))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Bindings saved to: %s"), *SavePath);
+		}
+		else
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to save bindings to: %s"), *SavePath);
+			bLastSaveFailed = true;
+		}
+	};
+
+	// Writes are chained so an older snapshot can never land after a newer one
+	PendingSaveTask = PendingSaveTask.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteFile), UE::Tasks::Prerequisites(PendingSaveTask))
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(WriteFile));
+
+	return true;
+}
+
+bool ULocalPlayerRebindingManager::ExportBindingsToJson(const FString& FilePath)
+{
+	UpdateSaveData();
+
+	FString JsonString;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(SaveData, JsonString))
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to serialize bindings to JSON"));
+		return false;
+	}
+
+	const FString ExportPath = FilePath.IsEmpty()
+		? InputRebindingPaths::GetSaveDir() / FString::Printf(TEXT("BindingsDebug%s.json"), *InputRebindingPaths::GetPlayerSuffix(GetLocalPlayer()))
+		: FilePath;
+	if (!FInputStreamlinerFileUtils::SaveStringAtomically(JsonString, ExportPath))
+	{
+		return false;
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Bindings exported to: %s"), *ExportPath);
+	return true;
+}
+
+void ULocalPlayerRebindingManager::WaitForPendingSave()
+{
+	if (PendingSaveTask.IsValid())
+	{
+		PendingSaveTask.Wait();
+		PendingSaveTask = UE::Tasks::FTask();
+	}
+}
+
+bool ULocalPlayerRebindingManager::LoadBindings()
+{
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_LoadBindings);
+	INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_LoadBindings);
+	FInputStreamlinerMetrics::FScopedTimer Timer(TEXT("Bindings.LoadMs"));
+
+	// Don't read a file that is still being written
+	WaitForPendingSave();
+
+	const FString SavePath = GetBindingsFilePath();
+	const FString LegacyPath = InputRebindingPaths::GetLegacyBindingsPath();
+	const bool bIsFirstPlayer = GetLocalPlayer()->GetLocalPlayerIndex() == 0;
+
+	FInputBindingSaveData LoadedData;
+
+	if (FPaths::FileExists(SavePath))
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *SavePath))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to load bindings from: %s"), *SavePath);
+			return false;
+		}
+
+		if (!FInputBindingSaveFormat::Read(Bytes, LoadedData))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to parse bindings file: %s"), *SavePath);
+			return false;
+		}
+
+		LastSavedCrc = FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+		bHasLastSavedCrc = true;
+
+		FInputStreamlinerMetrics::Record(TEXT("Bindings.LoadBytes"), Bytes.Num());
+		SET_MEMORY_STAT(STAT_InputStreamliner_SavedBindingsSize, Bytes.Num());
+	}
+	else if (bIsFirstPlayer && FPaths::FileExists(LegacyPath))
+	{
+		FString JsonString;
+		if (!FFileHelper::LoadFileToString(JsonString, *LegacyPath) ||
+			!FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &LoadedData))
+		{
+			UE_LOG(LogInputStreamlinerRuntime, Error, TEXT("Failed to parse bindings JSON: %s"), *LegacyPath);
+			return false;
+		}
+		FInputStreamlinerMetrics::Record(TEXT("Bindings.LoadBytes"), FTCHARToUTF8(*JsonString).Length());
+		FInputBindingSaveFormat::Sanitize(LoadedData);
+
+		// Rewritten in the binary format on the next save
+		bHasLastSavedCrc = false;
+		UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Migrating version %d bindings from: %s"), LoadedData.Version, *LegacyPath);
+	}
+	else
+	{
+		UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("No saved bindings found at: %s"), *SavePath);
+		return false;
+	}
+
+	SaveData = MoveTemp(LoadedData);
+	RebuildSavedBindingIndex();
+	ActiveBindingProfile = NAME_None;
+
+	// Actions registered before the load pick up the loaded bindings in one rebuild
+	if (SharedManager)
+	{
+		for (const auto& Pair : SharedManager->GetDefaultBindings())
+		{
+			InitializeActionBindings(Pair.Key);
+		}
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Bindings loaded (%d custom actions)"), SaveData.Bindings.Num());
+	return true;
+}
+
+FString ULocalPlayerRebindingManager::GetSaveSlotName() const
+{
+	return TEXT("InputBindings") + InputRebindingPaths::GetPlayerSuffix(GetLocalPlayer());
+}
+
+FString ULocalPlayerRebindingManager::GetBindingsFilePath() const
+{
+	return InputRebindingPaths::GetSaveDir() / FString::Printf(TEXT("Bindings%s.sav"), *InputRebindingPaths::GetPlayerSuffix(GetLocalPlayer()));
+}
+
+void ULocalPlayerRebindingManager::HandleActionsRegistered(TConstArrayView<UInputAction*> Actions)
+{
+	CurrentBindings.Reserve(CurrentBindings.Num() + Actions.Num());
+
+	for (UInputAction* Action : Actions)
+	{
+		InitializeActionBindings(Action);
+	}
+}
+
+void ULocalPlayerRebindingManager::InitializeActionBindings(UInputAction* Action)
+{
+	const TArray<FKey>* Defaults = FindDefaultBindings(Action);
+	if (!Action || !Defaults)
+	{
+		return;
+	}
+
+	// Use saved bindings for this action if we have them, otherwise the defaults
+	const int32* SavedIndex = SavedBindingIndexByName.Find(Action->GetFName());
+	SetCurrentBindings(Action, SavedIndex ? SaveData.Bindings[*SavedIndex].Keys : *Defaults);
+
+	// Queued into the end-of-frame rebuild with every other registration
+	SyncActionMappings(Action);
+	NotifyActionBindingsChanged(Action);
+}
+
+const TArray<FKey>* ULocalPlayerRebindingManager::FindDefaultBindings(UInputAction* Action) const
+{
+	return SharedManager ? SharedManager->FindDefaultBindings(Action) : nullptr;
+}
+
+void ULocalPlayerRebindingManager::SetMappingContext(UInputMappingContext* Context, int32 Priority)
+{
+	if (SourceMappingContext == Context)
+	{
+		if (Priority == MappingContextPriority)
+		{
+			return;
+		}
+		MappingContextPriority = Priority;
+
+		// A copy still waiting for its add picks up the new priority when it's flushed
+		UEnhancedInputLocalPlayerSubsystem* Subsystem = GetEnhancedInputSubsystem();
+		int32 AppliedPriority = 0;
+		if (Subsystem && ActiveMappingContext && Subsystem->HasMappingContext(ActiveMappingContext, AppliedPriority) && AppliedPriority != Priority)
+		{
+			// Enhanced Input only takes the priority on add, so re-add the copy to move it
+			FModifyContextOptions Options;
+			Options.bForceImmediately = true;
+			Options.bIgnoreAllPressedKeysUntilRelease = true;
+			Subsystem->RemoveMappingContext(ActiveMappingContext, Options);
+			Subsystem->AddMappingContext(ActiveMappingContext, Priority, Options);
+		}
+		return;
+	}
+
+	// Changes to the previous context still need their rebuild
+	FlushPendingMappingChanges();
+
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetEnhancedInputSubsystem();
+	if (Subsystem && ActiveMappingContext)
+	{
+		Subsystem->RemoveMappingContext(ActiveMappingContext);
+	}
+
+	SourceMappingContext = Context;
+	MappingContextPriority = Priority;
+	ActiveMappingContext = nullptr;
+	bMappingContextPendingAdd = false;
+
+	if (Context)
+	{
+		// Rebinding edits the mappings in place, so each player works on its own copy and the asset stays untouched
+		ActiveMappingContext = DuplicateObject<UInputMappingContext>(Context, this, MakeUniqueObjectName(this, UInputMappingContext::StaticClass(), Context->GetFName()));
+		ActiveMappingContext->ClearFlags(RF_Public | RF_Standalone | RF_Transactional);
+		ActiveMappingContext->SetFlags(RF_Transient);
+
+		// The game may have applied the asset itself; the copy takes its place at the same priority
+		int32 AppliedPriority = 0;
+		if (Subsystem && Subsystem->HasMappingContext(Context, AppliedPriority))
+		{
+			MappingContextPriority = AppliedPriority;
+			Subsystem->RemoveMappingContext(Context);
+		}
+		bMappingContextPendingAdd = true;
+	}
+
+	BuildMappingSlots();
+
+	if (ActiveMappingContext)
+	{
+		// Apply any loaded custom bindings
+		ApplyLoadedBindings();
+		FlushPendingMappingChanges();
+	}
+}
+
+bool ULocalPlayerRebindingManager::HandleKeyDown(const FKeyEvent& KeyEvent)
+{
+	if (!PendingRebindAction)
+	{
+		return false;
+	}
+
+	FKey Key = KeyEvent.GetKey();
+	NotifyAnyKeyPressed(Key);
+
+	// Ignore certain keys
+	if (Key == EKeys::Escape)
+	{
+		CancelRebinding();
+		return true;
+	}
+
+	// Ignore modifier keys by themselves
+	if (Key == EKeys::LeftShift || Key == EKeys::RightShift ||
+		Key == EKeys::LeftControl || Key == EKeys::RightControl ||
+		Key == EKeys::LeftAlt || Key == EKeys::RightAlt ||
+		Key == EKeys::LeftCommand || Key == EKeys::RightCommand)
+	{
+		return true; // Consume but don't apply
+	}
+
+	ApplyBinding(PendingRebindAction, Key, PendingBindingIndex);
+	return true; // Consume the input
+}
+
+bool ULocalPlayerRebindingManager::HandleAnalogInput(const FAnalogInputEvent& AnalogEvent)
+{
+	if (!PendingRebindAction)
+	{
+		return false;
+	}
+
+	// Only capture significant analog input
+	if (FMath::Abs(AnalogEvent.GetAnalogValue()) < 0.5f)
+	{
+		return false;
+	}
+
+	FKey Key = AnalogEvent.GetKey();
+	NotifyAnyKeyPressed(Key);
+
+	ApplyBinding(PendingRebindAction, Key, PendingBindingIndex);
+	return true;
+}
+
+void ULocalPlayerRebindingManager::ApplyLoadedBindings()
+{
+	if (!ActiveMappingContext)
+	{
+		return;
+	}
+
+	// Bring every registered action's mappings in line with its current bindings
+	for (const auto& Pair : CurrentBindings)
+	{
+		SyncActionMappings(Pair.Key);
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Applied loaded bindings to mapping context (%d actions changed)"), DirtyActions.Num());
+}
+
+void ULocalPlayerRebindingManager::BuildMappingSlots()
+{
+	MappingSlotsByAction.Reset();
+	MappingTemplates.Reset();
+	MappingTemplateSlotsByAction.Reset();
+	NumDeadMappings = 0;
+
+	if (!ActiveMappingContext)
+	{
+		return;
+	}
+
+	// Mappings for an action appear in binding order, as generated
+	const TArray<FEnhancedActionKeyMapping>& Mappings = ActiveMappingContext->GetMappings();
+	for (int32 SlotIndex = 0; SlotIndex < Mappings.Num(); ++SlotIndex)
+	{
+		if (Mappings[SlotIndex].Action)
+		{
+			MappingSlotsByAction.FindOrAdd(Mappings[SlotIndex].Action).Add(SlotIndex);
+		}
+	}
+
+	// Compaction drops mappings along with their modifiers and triggers; keep them to restore a binding that returns
+	MappingTemplates = Mappings;
+	MappingTemplateSlotsByAction = MappingSlotsByAction;
+}
+
+void ULocalPlayerRebindingManager::SetMappingKey(UInputAction* Action, int32 BindingIndex, const FKey& NewKey)
+{
+	if (!ActiveMappingContext || !Action || BindingIndex < 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_MappingUpdate);
+	FInputStreamlinerMetrics::FScopedTimer Timer(TEXT("Mapping.UpdateMs"));
+
+	TArray<int32>* Slots = MappingSlotsByAction.Find(Action);
+	if (!Slots)
+	{
+		// Action belongs to a different mapping context
+		UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Action %s is not in mapping context %s"),
+			*Action->GetName(), *ActiveMappingContext->GetName());
+		return;
+	}
+
+	// Only ever this player's copy, never the shared asset
+	TArray<FEnhancedActionKeyMapping>& Mappings = const_cast<TArray<FEnhancedActionKeyMapping>&>(ActiveMappingContext->GetMappings());
+
+	const int32 SlotIndex = Slots->IsValidIndex(BindingIndex) ? (*Slots)[BindingIndex] : INDEX_NONE;
+	if (SlotIndex != INDEX_NONE)
+	{
+		FEnhancedActionKeyMapping& Mapping = Mappings[SlotIndex];
+		if (Mapping.Key == NewKey)
+		{
+			return;
+		}
+
+		if (!NewKey.IsValid())
+		{
+			// Removed mappings are compacted on the next flush
+			++NumDeadMappings;
+		}
+		else if (!Mapping.Key.IsValid())
+		{
+			NumDeadMappings = FMath::Max(0, NumDeadMappings - 1);
+		}
+
+		UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Updated mapping: %s -> %s for action %s"),
+			*Mapping.Key.ToString(), *NewKey.ToString(), *Action->GetName());
+		Mapping.Key = NewKey;
+	}
+	else if (NewKey.IsValid())
+	{
+		// Add new mapping, with the modifiers and triggers the context had for this binding
+		FEnhancedActionKeyMapping NewMapping;
+		const TArray<int32>* TemplateSlots = MappingTemplateSlotsByAction.Find(Action);
+		if (TemplateSlots && TemplateSlots->IsValidIndex(BindingIndex))
+		{
+			NewMapping = MappingTemplates[(*TemplateSlots)[BindingIndex]];
+		}
+		NewMapping.Action = Action;
+		NewMapping.Key = NewKey;
+
+		while (Slots->Num() <= BindingIndex)
+		{
+			Slots->Add(INDEX_NONE);
+		}
+		(*Slots)[BindingIndex] = Mappings.Add(NewMapping);
+
+		UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Added new mapping: %s for action %s"),
+			*NewKey.ToString(), *Action->GetName());
+	}
+	else
+	{
+		return;
+	}
+
+	// Rebuilt once at the end of the frame, however many keys change
+	DirtyActions.Add(Action);
+}
+
+void ULocalPlayerRebindingManager::SyncActionMappings(UInputAction* Action)
+{
+	const TArray<FKey>* Keys = CurrentBindings.Find(Action);
+	const TArray<int32>* Slots = MappingSlotsByAction.Find(Action);
+	if (!Keys || !Slots)
+	{
+		return;
+	}
+
+	const int32 NumBindings = FMath::Max(Keys->Num(), Slots->Num());
+	for (int32 BindingIndex = 0; BindingIndex < NumBindings; ++BindingIndex)
+	{
+		SetMappingKey(Action, BindingIndex, Keys->IsValidIndex(BindingIndex) ? (*Keys)[BindingIndex] : EKeys::Invalid);
+	}
+}
+
+void ULocalPlayerRebindingManager::CompactMappings()
+{
+	if (NumDeadMappings == 0 || !ActiveMappingContext)
+	{
+		return;
+	}
+
+	TArray<FEnhancedActionKeyMapping>& Mappings = const_cast<TArray<FEnhancedActionKeyMapping>&>(ActiveMappingContext->GetMappings());
+
+	// Mappings of tracked actions that were left without a key
+	TBitArray<> DeadSlots(false, Mappings.Num());
+	for (const auto& Pair : MappingSlotsByAction)
+	{
+		for (const int32 SlotIndex : Pair.Value)
+		{
+			if (SlotIndex != INDEX_NONE && !Mappings[SlotIndex].Key.IsValid())
+			{
+				DeadSlots[SlotIndex] = true;
+			}
+		}
+	}
+
+	// Remove dead slots in place and remember where the survivors moved
+	TArray<int32> NewSlotIndex;
+	NewSlotIndex.SetNumUninitialized(Mappings.Num());
+
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < Mappings.Num(); ++ReadIndex)
+	{
+		if (DeadSlots[ReadIndex])
+		{
+			NewSlotIndex[ReadIndex] = INDEX_NONE;
+			continue;
+		}
+
+		if (WriteIndex != ReadIndex)
+		{
+			Mappings[WriteIndex] = MoveTemp(Mappings[ReadIndex]);
+		}
+		NewSlotIndex[ReadIndex] = WriteIndex++;
+	}
+
+	const int32 NumRemoved = Mappings.Num() - WriteIndex;
+	Mappings.SetNum(WriteIndex);
+
+	for (auto& Pair : MappingSlotsByAction)
+	{
+		for (int32& SlotIndex : Pair.Value)
+		{
+			if (SlotIndex != INDEX_NONE)
+			{
+				SlotIndex = NewSlotIndex[SlotIndex];
+			}
+		}
+	}
+
+	NumDeadMappings = 0;
+
+	UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Compacted %d removed mappings from %s"),
+		NumRemoved, *ActiveMappingContext->GetName());
+}
+
+void ULocalPlayerRebindingManager::HandleEndFrame()
+{
+	if (HasPendingMappingChanges())
+	{
+		FlushPendingMappingChanges();
+	}
+}
+
+void ULocalPlayerRebindingManager::FlushPendingMappingChanges()
+{
+	if (!HasPendingMappingChanges() || !ActiveMappingContext)
+	{
+		DirtyActions.Reset();
+		bMappingContextPendingAdd = false;
+		return;
+	}
+
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetEnhancedInputSubsystem();
+	if (!Subsystem)
+	{
+		// Keep the changes until a local player exists
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_MappingRebuild);
+	INPUTSTREAMLINER_TRACE_SCOPE(InputStreamliner_MappingRebuild);
+	FInputStreamlinerMetrics::FScopedTimer Timer(TEXT("Mapping.RebuildMs"));
+	INC_DWORD_STAT(STAT_InputStreamliner_MappingRebuilds);
+	FInputStreamlinerMetrics::Record(TEXT("Mapping.RebuildActions"), DirtyActions.Num());
+
+	CompactMappings();
+
+	FModifyContextOptions Options;
+	Options.bForceImmediately = true;
+	// Don't fire the action for the key that was just pressed to bind it
+	Options.bIgnoreAllPressedKeysUntilRelease = true;
+
+	int32 AppliedPriority = 0;
+	if (Subsystem->HasMappingContext(ActiveMappingContext, AppliedPriority))
+	{
+		// Already applied; rebuild in place so the context keeps its priority
+		Subsystem->RequestRebuildControlMappings(Options);
+	}
+	else
+	{
+		Subsystem->AddMappingContext(ActiveMappingContext, MappingContextPriority, Options);
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Verbose, TEXT("Rebuilt control mappings for %d changed actions"), DirtyActions.Num());
+	DirtyActions.Reset();
+	bMappingContextPendingAdd = false;
+}
+
+void ULocalPlayerRebindingManager::SetCurrentBindings(UInputAction* Action, const TArray<FKey>& Keys)
+{
+	ClearCurrentBindings(Action);
+
+	CurrentBindings.Add(Action, Keys);
+	for (const FKey& Key : Keys)
+	{
+		AddKeyToIndex(Action, Key);
+	}
+}
+
+void ULocalPlayerRebindingManager::ClearCurrentBindings(UInputAction* Action)
+{
+	TArray<FKey> OldKeys;
+	if (CurrentBindings.RemoveAndCopyValue(Action, OldKeys))
+	{
+		for (const FKey& Key : OldKeys)
+		{
+			RemoveKeyFromIndex(Action, Key);
+		}
+	}
+}
+
+void ULocalPlayerRebindingManager::AddKeyToIndex(UInputAction* Action, const FKey& Key)
+{
+	if (Action && Key.IsValid())
+	{
+		ActionsByKey.FindOrAdd(Key).Add(Action);
+	}
+}
+
+void ULocalPlayerRebindingManager::RemoveKeyFromIndex(UInputAction* Action, const FKey& Key)
+{
+	TArray<TObjectPtr<UInputAction>>* BoundActions = ActionsByKey.Find(Key);
+	if (!BoundActions)
+	{
+		return;
+	}
+
+	BoundActions->RemoveSingle(Action);
+	if (BoundActions->Num() == 0)
+	{
+		ActionsByKey.Remove(Key);
+	}
+}
+
+void ULocalPlayerRebindingManager::RebuildKeyIndex()
+{
+	ActionsByKey.Reset();
+
+	for (const auto& Pair : CurrentBindings)
+	{
+		for (const FKey& Key : Pair.Value)
+		{
+			AddKeyToIndex(Pair.Key, Key);
+		}
+	}
+}
+
+UEnhancedInputLocalPlayerSubsystem* ULocalPlayerRebindingManager::GetEnhancedInputSubsystem() const
+{
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
+}
+
+bool ULocalPlayerRebindingManager::IsEventFromPlayer(uint32 SlateUserIndex) const
+{
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	const UGameInstance* GameInstance = LocalPlayer->GetGameInstance();
+
+	// With a single player every device belongs to it
+	if (!GameInstance || GameInstance->GetNumLocalPlayers() <= 1)
+	{
+		return true;
+	}
+
+	return static_cast<int32>(SlateUserIndex) == LocalPlayer->GetControllerId();
+}
+
+void ULocalPlayerRebindingManager::NotifyActionBindingsChanged(UInputAction* Action)
+{
+	if (const FOnActionBindingsChanged* Delegate = ActionBindingsChangedDelegates.Find(FObjectKey(Action)))
+	{
+		Delegate->Broadcast(Action);
+	}
+}
+
+void ULocalPlayerRebindingManager::NotifyAnyKeyPressed(const FKey& Key)
+{
+	OnAnyKeyPressed.Broadcast(Key);
+	if (SharedManager)
+	{
+		SharedManager->OnAnyKeyPressed.Broadcast(Key);
+	}
+}
+
+// ============== FRebindInputProcessor Implementation ==============
+
+bool FRebindInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+	if (Manager.IsValid() && Manager->IsRebindingInProgress() && Manager->IsEventFromPlayer(InKeyEvent.GetUserIndex()))
+	{
+		return Manager->HandleKeyDown(InKeyEvent);
+	}
+	return false;
+}
+
+bool FRebindInputProcessor::HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent)
+{
+	if (Manager.IsValid() && Manager->IsRebindingInProgress() && Manager->IsEventFromPlayer(InAnalogInputEvent.GetUserIndex()))
+	{
+		return Manager->HandleAnalogInput(InAnalogInputEvent);
+	}
+	return false;
+}
+
+bool FRebindInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+{
+	if (Manager.IsValid() && Manager->IsRebindingInProgress() && Manager->IsEventFromPlayer(MouseEvent.GetUserIndex()))
+	{
+		FKey Key = MouseEvent.GetEffectingButton();
+		Manager->NotifyAnyKeyPressed(Key);
+
+		// Don't bind left mouse click (used for UI interaction)
+		if (Key == EKeys::LeftMouseButton)
+		{
+			return false;
+		}
+
+		Manager->ApplyBinding(Manager->GetPendingRebindAction(), Key, 0);
+		return true;
+	}
+	return false;
+}
+
+bool FRebindInputProcessor::HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent)
+{
+	if (Manager.IsValid() && Manager->IsRebindingInProgress() && Manager->IsEventFromPlayer(InWheelEvent.GetUserIndex()))
+	{
+		FKey Key = InWheelEvent.GetWheelDelta() > 0 ? EKeys::MouseScrollUp : EKeys::MouseScrollDown;
+		Manager->NotifyAnyKeyPressed(Key);
+		Manager->ApplyBinding(Manager->GetPendingRebindAction(), Key, 0);
+		return true;
+	}
+	return false;
+}
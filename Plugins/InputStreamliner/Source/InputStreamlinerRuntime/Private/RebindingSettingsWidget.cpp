@@ -9,6 +9,7 @@
 #include "Components/Slider.h"
 #include "Components/CheckBox.h"
 #include "Components/ScrollBox.h"
+#include "Components/ListView.h"
 #include "Components/Spacer.h"
 #include "Components/Border.h"
 #include "Components/VerticalBoxSlot.h"
@@ -17,6 +18,50 @@
 #include "InputAction.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "UObject/UnrealType.h"
+
+namespace RebindingSettingsWidget
+{
+	/** EntryWidgetClass is only exposed to the UMG designer, so set it through reflection for generated lists */
+	void SetListEntryClass(UListView* ListView, TSubclassOf<UUserWidget> EntryClass)
+	{
+		if (FClassProperty* EntryClassProperty = FindFProperty<FClassProperty>(UListViewBase::StaticClass(), TEXT("EntryWidgetClass")))
+		{
+			EntryClassProperty->SetObjectPropertyValue_InContainer(ListView, EntryClass.Get());
+		}
+	}
+}
+
+// ============== URebindActionListItem ==============
+
+FText URebindActionListItem::MakeDisplayName(const UInputAction* Action)
+{
+	if (!Action)
+	{
+		return FText::GetEmpty();
+	}
+
+	// Get display name from action
+	FString ActionName = Action->GetName();
+	// Remove IA_ prefix if present
+	if (ActionName.StartsWith(TEXT("IA_")))
+	{
+		ActionName = ActionName.RightChop(3);
+	}
+	// Add spaces before capital letters
+	FString DisplayName;
+	DisplayName.Reserve(ActionName.Len() * 2);
+	for (int32 i = 0; i < ActionName.Len(); i++)
+	{
+		if (i > 0 && FChar::IsUpper(ActionName[i]) && !FChar::IsUpper(ActionName[i-1]))
+		{
+			DisplayName += TEXT(" ");
+		}
+		DisplayName += ActionName[i];
+	}
+	return FText::FromString(DisplayName);
+}
 
 // ============== URebindActionRow ==============
 
@@ -97,42 +142,67 @@ void URebindActionRow::CreateWidgets()
 	bWidgetsCreated = true;
 }
 
-void URebindActionRow::SetupAction(UInputAction* InAction, UInputRebindingManager* InManager)
+void URebindActionRow::NativeDestruct()
+{
+	UnbindFromManager();
+
+	Super::NativeDestruct();
+}
+
+void URebindActionRow::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	SetupItem(Cast<URebindActionListItem>(ListItemObject));
+}
+
+void URebindActionRow::SetupAction(UInputAction* InAction, ULocalPlayerRebindingManager* InManager)
+{
+	SetupRow(InAction, InManager, URebindActionListItem::MakeDisplayName(InAction));
+}
+
+void URebindActionRow::SetupItem(URebindActionListItem* Item)
 {
+	if (Item)
+	{
+		SetupRow(Item->Action, Item->RebindingManager, Item->DisplayName);
+	}
+	else
+	{
+		SetupRow(nullptr, nullptr, FText::GetEmpty());
+	}
+}
+
+void URebindActionRow::SetupRow(UInputAction* InAction, ULocalPlayerRebindingManager* InManager, const FText& DisplayName)
+{
+	// Recycled rows stop listening to the action they showed before
+	UnbindFromManager();
+
 	Action = InAction;
 	RebindingManager = InManager;
 
 	if (ActionNameText && Action)
 	{
-		// Get display name from action
-		FString ActionName = Action->GetName();
-		// Remove IA_ prefix if present
-		if (ActionName.StartsWith(TEXT("IA_")))
-		{
-			ActionName = ActionName.RightChop(3);
-		}
-		// Add spaces before capital letters
-		FString DisplayName;
-		for (int32 i = 0; i < ActionName.Len(); i++)
-		{
-			if (i > 0 && FChar::IsUpper(ActionName[i]) && !FChar::IsUpper(ActionName[i-1]))
-			{
-				DisplayName += TEXT(" ");
-			}
-			DisplayName += ActionName[i];
-		}
-		ActionNameText->SetText(FText::FromString(DisplayName));
+		ActionNameText->SetText(DisplayName);
 	}
 
-	// Bind to rebind complete event
-	if (RebindingManager)
+	// Only this action's changes refresh the row
+	if (RebindingManager && Action)
 	{
-		RebindingManager->OnRebindComplete.AddDynamic(this, &URebindActionRow::OnRebindComplete);
+		BindingsChangedHandle = RebindingManager->OnActionBindingsChanged(Action).AddUObject(this, &URebindActionRow::HandleBindingsChanged);
 	}
 
+	SetRebindingState(RebindingManager && Action && RebindingManager->GetPendingRebindAction() == Action);
 	RefreshKeyDisplay();
 }
 
+void URebindActionRow::UnbindFromManager()
+{
+	if (RebindingManager && Action && BindingsChangedHandle.IsValid())
+	{
+		RebindingManager->OnActionBindingsChanged(Action).Remove(BindingsChangedHandle);
+	}
+	BindingsChangedHandle.Reset();
+}
+
 void URebindActionRow::RefreshKeyDisplay()
 {
 	if (!KeyBindingText || !Action || !RebindingManager)
@@ -193,18 +263,15 @@ void URebindActionRow::OnResetClicked()
 {
 	if (RebindingManager && Action)
 	{
+		// The row refreshes from the binding change notification
 		RebindingManager->ResetToDefault(Action);
-		RefreshKeyDisplay();
 	}
 }
 
-void URebindActionRow::OnRebindComplete(UInputAction* CompletedAction, FKey NewKey)
+void URebindActionRow::HandleBindingsChanged(UInputAction* ChangedAction)
 {
-	if (CompletedAction == Action)
-	{
-		SetRebindingState(false);
-		RefreshKeyDisplay();
-	}
+	SetRebindingState(false);
+	RefreshKeyDisplay();
 }
 
 // ============== URebindingSettingsWidget ==============
@@ -218,6 +285,12 @@ void URebindingSettingsWidget::NativeConstruct()
 		CreateWidgets();
 	}
 
+	// Show actions registered before the widget was constructed
+	if (ActionsListView && ActionsListView->GetNumItems() == 0 && ActionItems.Num() > 0)
+	{
+		ActionsListView->SetListItems(TArray<UObject*>(ActionItems));
+	}
+
 	// Get rebinding manager
 	CachedManager = GetRebindingManager();
 	if (CachedManager)
@@ -225,6 +298,7 @@ void URebindingSettingsWidget::NativeConstruct()
 		CachedManager->OnRebindComplete.AddDynamic(this, &URebindingSettingsWidget::OnRebindComplete);
 		CachedManager->OnAnyKeyPressed.AddDynamic(this, &URebindingSettingsWidget::OnAnyKeyPressed);
 		CachedManager->OnBindingConflict.AddDynamic(this, &URebindingSettingsWidget::OnBindingConflict);
+		CachedManager->OnBindingProfileApplied.AddDynamic(this, &URebindingSettingsWidget::OnBindingProfileApplied);
 
 		// Initialize sensitivity sliders
 		if (MouseSensitivitySlider)
@@ -271,6 +345,7 @@ void URebindingSettingsWidget::NativeDestruct()
 		CachedManager->OnRebindComplete.RemoveDynamic(this, &URebindingSettingsWidget::OnRebindComplete);
 		CachedManager->OnAnyKeyPressed.RemoveDynamic(this, &URebindingSettingsWidget::OnAnyKeyPressed);
 		CachedManager->OnBindingConflict.RemoveDynamic(this, &URebindingSettingsWidget::OnBindingConflict);
+		CachedManager->OnBindingProfileApplied.RemoveDynamic(this, &URebindingSettingsWidget::OnBindingProfileApplied);
 	}
 
 	Super::NativeDestruct();
@@ -306,15 +381,27 @@ void URebindingSettingsWidget::CreateWidgets()
 	BindingsHeader->SetFont(HeaderFont);
 	RootBox->AddChildToVerticalBox(BindingsHeader);
 
-	// Scroll box for action rows
-	ActionsScrollBox = WidgetTree->ConstructWidget<UScrollBox>(UScrollBox::StaticClass(), TEXT("ActionsScrollBox"));
-	UVerticalBoxSlot* ScrollSlot = RootBox->AddChildToVerticalBox(ActionsScrollBox);
-	ScrollSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
-	ScrollSlot->SetPadding(FMargin(0.f, 5.f));
+	if (bUseListView)
+	{
+		// Pooled list: only the visible rows exist, recycled as the list scrolls
+		ActionsListView = WidgetTree->ConstructWidget<UListView>(UListView::StaticClass(), TEXT("ActionsListView"));
+		RebindingSettingsWidget::SetListEntryClass(ActionsListView, ActionRowClass ? TSubclassOf<UUserWidget>(ActionRowClass) : TSubclassOf<UUserWidget>(URebindActionRow::StaticClass()));
+		UVerticalBoxSlot* ListSlot = RootBox->AddChildToVerticalBox(ActionsListView);
+		ListSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
+		ListSlot->SetPadding(FMargin(0.f, 5.f));
+	}
+	else
+	{
+		// Scroll box for action rows
+		ActionsScrollBox = WidgetTree->ConstructWidget<UScrollBox>(UScrollBox::StaticClass(), TEXT("ActionsScrollBox"));
+		UVerticalBoxSlot* ScrollSlot = RootBox->AddChildToVerticalBox(ActionsScrollBox);
+		ScrollSlot->SetSize(FSlateChildSize(ESlateSizeRule::Fill));
+		ScrollSlot->SetPadding(FMargin(0.f, 5.f));
 
-	// Actions container inside scroll box
-	ActionsContainer = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("ActionsContainer"));
-	ActionsScrollBox->AddChild(ActionsContainer);
+		// Actions container inside scroll box
+		ActionsContainer = WidgetTree->ConstructWidget<UVerticalBox>(UVerticalBox::StaticClass(), TEXT("ActionsContainer"));
+		ActionsScrollBox->AddChild(ActionsContainer);
+	}
 
 	// Sensitivity section
 	UTextBlock* SensitivityHeader = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("SensitivityHeader"));
@@ -436,7 +523,19 @@ void URebindingSettingsWidget::CreateWidgets()
 	bWidgetsCreated = true;
 }
 
-UInputRebindingManager* URebindingSettingsWidget::GetRebindingManager() const
+ULocalPlayerRebindingManager* URebindingSettingsWidget::GetRebindingManager() const
+{
+	if (ULocalPlayer* LocalPlayer = GetOwningLocalPlayer())
+	{
+		return LocalPlayer->GetSubsystem<ULocalPlayerRebindingManager>();
+	}
+
+	// Widgets created without an owning player edit the first player's bindings
+	UInputRebindingManager* SharedManager = GetSharedRebindingManager();
+	return SharedManager ? SharedManager->GetPrimaryPlayerManager() : nullptr;
+}
+
+UInputRebindingManager* URebindingSettingsWidget::GetSharedRebindingManager() const
 {
 	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(GetWorld());
 	if (GameInstance)
@@ -453,42 +552,93 @@ void URebindingSettingsWidget::RegisterAction(UInputAction* Action, const TArray
 		return;
 	}
 
-	UInputRebindingManager* Manager = GetRebindingManager();
+	UInputRebindingManager* Manager = GetSharedRebindingManager();
 	if (Manager)
 	{
 		Manager->RegisterAction(Action, DefaultBindings);
 	}
 
-	// Create row widget
-	URebindActionRow* Row = CreateActionRow(Action);
-	if (Row)
-	{
-		ActionRows.Add(Action, Row);
-	}
+	AddActionItem(Action);
 }
 
 void URebindingSettingsWidget::RegisterActions(const TMap<UInputAction*, FKey>& ActionsAndDefaults)
 {
+	TArray<FActionDefaultBindings> Entries;
+	Entries.Reserve(ActionsAndDefaults.Num());
 	for (const auto& Pair : ActionsAndDefaults)
 	{
-		TArray<FKey> Bindings;
-		Bindings.Add(Pair.Value);
-		RegisterAction(Pair.Key, Bindings);
+		if (Pair.Key)
+		{
+			FActionDefaultBindings& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Action = Pair.Key;
+			Entry.DefaultKeys.Add(Pair.Value);
+		}
+	}
+
+	// Register with the manager in one batch, then build the rows
+	UInputRebindingManager* Manager = GetSharedRebindingManager();
+	if (Manager)
+	{
+		Manager->RegisterActions(Entries);
+	}
+
+	ActionItems.Reserve(ActionItems.Num() + Entries.Num());
+	for (const FActionDefaultBindings& Entry : Entries)
+	{
+		AddActionItem(Entry.Action);
 	}
 }
 
 void URebindingSettingsWidget::SetMappingContext(UInputMappingContext* Context)
 {
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		Manager->SetMappingContext(Context);
 	}
 }
 
-URebindActionRow* URebindingSettingsWidget::CreateActionRow(UInputAction* Action)
+void URebindingSettingsWidget::AddActionItem(UInputAction* Action)
 {
-	if (!Action || !ActionsContainer)
+	if (!Action || ActionItemsByAction.Contains(Action))
+	{
+		return;
+	}
+
+	// Display name is computed once here, not each time a row shows the action
+	URebindActionListItem* Item = NewObject<URebindActionListItem>(this);
+	Item->Action = Action;
+	Item->DisplayName = URebindActionListItem::MakeDisplayName(Action);
+	Item->RebindingManager = GetRebindingManager();
+
+	ActionItems.Add(Item);
+	ActionItemsByAction.Add(Action, Item);
+
+	if (ActionsListView)
+	{
+		ActionsListView->AddItem(Item);
+	}
+	else if (URebindActionRow* Row = CreateActionRow(Item))
+	{
+		ActionRows.Add(Action, Row);
+	}
+}
+
+URebindActionRow* URebindingSettingsWidget::FindActionRow(UInputAction* Action) const
+{
+	if (ActionsListView)
+	{
+		const TObjectPtr<URebindActionListItem>* Item = ActionItemsByAction.Find(Action);
+		return Item ? ActionsListView->GetEntryWidgetFromItem<URebindActionRow>(*Item) : nullptr;
+	}
+
+	const TObjectPtr<URebindActionRow>* Row = ActionRows.Find(Action);
+	return Row ? Row->Get() : nullptr;
+}
+
+URebindActionRow* URebindingSettingsWidget::CreateActionRow(URebindActionListItem* Item)
+{
+	if (!Item || !ActionsContainer)
 	{
 		return nullptr;
 	}
@@ -502,7 +652,7 @@ URebindActionRow* URebindingSettingsWidget::CreateActionRow(UInputAction* Action
 	URebindActionRow* Row = CreateWidget<URebindActionRow>(this, RowClass);
 	if (Row)
 	{
-		Row->SetupAction(Action, GetRebindingManager());
+		Row->SetupItem(Item);
 		ActionsContainer->AddChildToVerticalBox(Row);
 	}
 
@@ -511,6 +661,18 @@ URebindActionRow* URebindingSettingsWidget::CreateActionRow(UInputAction* Action
 
 void URebindingSettingsWidget::RefreshAllBindings()
 {
+	// Only rows on screen exist in the list view; recycled rows refresh when they are reused
+	if (ActionsListView)
+	{
+		for (UUserWidget* EntryWidget : ActionsListView->GetDisplayedEntryWidgets())
+		{
+			if (URebindActionRow* Row = Cast<URebindActionRow>(EntryWidget))
+			{
+				Row->RefreshKeyDisplay();
+			}
+		}
+	}
+
 	for (const auto& Pair : ActionRows)
 	{
 		if (Pair.Value)
@@ -522,7 +684,7 @@ void URebindingSettingsWidget::RefreshAllBindings()
 
 void URebindingSettingsWidget::ResetAllToDefaults()
 {
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		Manager->ResetAllToDefaults();
@@ -548,7 +710,7 @@ void URebindingSettingsWidget::ResetAllToDefaults()
 
 void URebindingSettingsWidget::SaveBindings()
 {
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		if (Manager->SaveBindings())
@@ -590,12 +752,26 @@ void URebindingSettingsWidget::OnBindingConflict(UInputAction* ExistingAction, F
 	// Reset the rebinding state on the current row
 	if (CurrentlyRebindingAction)
 	{
-		TObjectPtr<URebindActionRow>* RowPtr = ActionRows.Find(CurrentlyRebindingAction);
-		if (RowPtr && *RowPtr)
+		if (URebindActionRow* Row = FindActionRow(CurrentlyRebindingAction))
+		{
+			Row->SetRebindingState(false);
+		}
+	}
+}
+
+void URebindingSettingsWidget::OnBindingProfileApplied(FName ProfileName, const TArray<UInputAction*>& ChangedActions)
+{
+	// The switch cancels any rebind in progress; rows refresh through their own action listeners
+	if (CurrentlyRebindingAction)
+	{
+		if (URebindActionRow* Row = FindActionRow(CurrentlyRebindingAction))
 		{
-			(*RowPtr)->SetRebindingState(false);
+			Row->SetRebindingState(false);
 		}
+		CurrentlyRebindingAction = nullptr;
 	}
+
+	SetStatus(FString::Printf(TEXT("Switched to %s (%d actions changed)"), *ProfileName.ToString(), ChangedActions.Num()));
 }
 
 void URebindingSettingsWidget::OnMouseSensitivityChanged(float Value)
@@ -603,7 +779,7 @@ void URebindingSettingsWidget::OnMouseSensitivityChanged(float Value)
 	float Sensitivity = Value * 5.0f; // 0-5 range
 	Sensitivity = FMath::Max(0.1f, Sensitivity);
 
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		Manager->SetMouseSensitivity(Sensitivity);
@@ -620,7 +796,7 @@ void URebindingSettingsWidget::OnGamepadSensitivityChanged(float Value)
 	float Sensitivity = Value * 5.0f;
 	Sensitivity = FMath::Max(0.1f, Sensitivity);
 
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		Manager->SetGamepadSensitivity(Sensitivity);
@@ -634,7 +810,7 @@ void URebindingSettingsWidget::OnGamepadSensitivityChanged(float Value)
 
 void URebindingSettingsWidget::OnInvertYChanged(bool bIsChecked)
 {
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		Manager->SetInvertY(bIsChecked);
@@ -654,7 +830,7 @@ void URebindingSettingsWidget::OnSaveClicked()
 void URebindingSettingsWidget::OnCancelClicked()
 {
 	// Reload saved bindings to discard changes
-	UInputRebindingManager* Manager = GetRebindingManager();
+	ULocalPlayerRebindingManager* Manager = GetRebindingManager();
 	if (Manager)
 	{
 		Manager->LoadBindings();
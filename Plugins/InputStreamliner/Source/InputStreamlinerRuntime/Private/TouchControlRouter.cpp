@@ -0,0 +1,465 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TouchControlRouter.h"
+#include "InputStreamlinerRuntimeModule.h"
+#include "InputStreamlinerMetrics.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/GameInstance.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/CoreDelegates.h"
+#include "Widgets/SViewport.h"
+
+DECLARE_CYCLE_STAT(TEXT("Touch Route"), STAT_InputStreamliner_TouchRoute, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Touch Events Routed"), STAT_InputStreamliner_TouchEventsRouted, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Touch Control Injections"), STAT_InputStreamliner_TouchControlInjections, STATGROUP_InputStreamliner);
+
+namespace TouchControlRouter
+{
+	/** Minimum normalized d-pad component counted as pressed (sin 22.5 degrees, for 8 directions) */
+	constexpr float DPadAxisThreshold = 0.383f;
+
+	/** Snap a direction to the dominant axis */
+	FVector2f SnapTo4Directions(const FVector2f& Direction)
+	{
+		if (FMath::Abs(Direction.X) >= FMath::Abs(Direction.Y))
+		{
+			return FVector2f(FMath::Sign(Direction.X), 0.0f);
+		}
+		return FVector2f(0.0f, FMath::Sign(Direction.Y));
+	}
+}
+
+void UTouchControlRouter::Deinitialize()
+{
+	StopRouting();
+
+	Controls.Empty();
+	HitRects.Empty();
+	States.Empty();
+
+	Super::Deinitialize();
+}
+
+void UTouchControlRouter::SetControls(const TArray<FTouchControlLayout>& InControls)
+{
+	Controls = InControls;
+
+	HitRects.Reset(Controls.Num());
+	States.Reset(Controls.Num());
+	States.SetNum(Controls.Num());
+
+	for (const FTouchControlLayout& Control : Controls)
+	{
+		// Layout is bottom-left based, Slate is top-left based
+		const FVector2f Center(Control.ScreenPosition.X, 1.0f - Control.ScreenPosition.Y);
+		const FVector2f HalfSize = FVector2f(Control.Size) * 0.5f;
+		HitRects.Add(FBox2f(Center - HalfSize, Center + HalfSize));
+	}
+
+	for (int32& ControlIndex : ControlByPointer)
+	{
+		ControlIndex = INDEX_NONE;
+	}
+
+	if (Controls.Num() > 0)
+	{
+		StartRouting();
+	}
+	else
+	{
+		StopRouting();
+	}
+
+	UE_LOG(LogInputStreamlinerRuntime, Log, TEXT("Touch router: %d controls"), Controls.Num());
+}
+
+void UTouchControlRouter::ClearControls()
+{
+	SetControls(TArray<FTouchControlLayout>());
+}
+
+FVector2D UTouchControlRouter::GetControlValue(FName ControlName) const
+{
+	const int32 ControlIndex = Controls.IndexOfByPredicate([ControlName](const FTouchControlLayout& Control)
+	{
+		return Control.ControlName == ControlName;
+	});
+	return ControlIndex != INDEX_NONE ? FVector2D(States[ControlIndex].Value) : FVector2D::ZeroVector;
+}
+
+bool UTouchControlRouter::IsControlActive(FName ControlName) const
+{
+	const int32 ControlIndex = Controls.IndexOfByPredicate([ControlName](const FTouchControlLayout& Control)
+	{
+		return Control.ControlName == ControlName;
+	});
+	return ControlIndex != INDEX_NONE && States[ControlIndex].PointerIndex != INDEX_NONE;
+}
+
+bool UTouchControlRouter::HandleTouchStarted(const FPointerEvent& TouchEvent)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_TouchRoute);
+	INC_DWORD_STAT(STAT_InputStreamliner_TouchEventsRouted);
+
+	const uint32 PointerIndex = TouchEvent.GetPointerIndex();
+	FVector2f Pixels;
+	FVector2f Normalized;
+	if (PointerIndex >= EKeys::NUM_TOUCH_KEYS || !ToViewportSpace(TouchEvent, Pixels, Normalized))
+	{
+		return false;
+	}
+
+	const int32 ControlIndex = HitTest(Normalized);
+	if (ControlIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FTouchControlLayout& Control = Controls[ControlIndex];
+	FControlState& State = States[ControlIndex];
+	State.PointerIndex = PointerIndex;
+	State.PressTime = FPlatformTime::Seconds();
+	State.PendingTouchTime = State.PressTime;
+	State.Position = Pixels;
+
+	if (Control.ControlType == ETouchRouterControlType::Joystick || Control.ControlType == ETouchRouterControlType::DPad)
+	{
+		// Fixed controls measure from their center, the others from the touch start
+		State.Origin = HitRects[ControlIndex].GetCenter() * ViewportSize;
+	}
+	else
+	{
+		State.Origin = Pixels;
+	}
+
+	ControlByPointer[PointerIndex] = ControlIndex;
+
+	UpdateControlValue(ControlIndex);
+	InjectControl(ControlIndex);
+	return true;
+}
+
+bool UTouchControlRouter::HandleTouchMoved(const FPointerEvent& TouchEvent)
+{
+	const uint32 PointerIndex = TouchEvent.GetPointerIndex();
+	if (PointerIndex >= EKeys::NUM_TOUCH_KEYS || ControlByPointer[PointerIndex] == INDEX_NONE)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_TouchRoute);
+	INC_DWORD_STAT(STAT_InputStreamliner_TouchEventsRouted);
+
+	const int32 ControlIndex = ControlByPointer[PointerIndex];
+	FVector2f Pixels;
+	FVector2f Normalized;
+	if (ToViewportSpace(TouchEvent, Pixels, Normalized))
+	{
+		FControlState& State = States[ControlIndex];
+		if (State.PendingTouchTime == 0.0)
+		{
+			State.PendingTouchTime = FPlatformTime::Seconds();
+		}
+		if (Controls[ControlIndex].ControlType == ETouchRouterControlType::TouchRegion)
+		{
+			// Regions report movement, accumulated until the next injection
+			State.Value += Pixels - State.Position;
+			State.bPendingPulse = true;
+		}
+		State.Position = Pixels;
+
+		UpdateControlValue(ControlIndex);
+		InjectControl(ControlIndex);
+	}
+	return true;
+}
+
+bool UTouchControlRouter::HandleTouchEnded(const FPointerEvent& TouchEvent)
+{
+	const uint32 PointerIndex = TouchEvent.GetPointerIndex();
+	if (PointerIndex >= EKeys::NUM_TOUCH_KEYS || ControlByPointer[PointerIndex] == INDEX_NONE)
+	{
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_TouchRoute);
+	INC_DWORD_STAT(STAT_InputStreamliner_TouchEventsRouted);
+
+	const int32 ControlIndex = ControlByPointer[PointerIndex];
+	ControlByPointer[PointerIndex] = INDEX_NONE;
+
+	const FTouchControlLayout& Control = Controls[ControlIndex];
+	FControlState& State = States[ControlIndex];
+	State.PointerIndex = INDEX_NONE;
+	if (State.PendingTouchTime == 0.0)
+	{
+		State.PendingTouchTime = FPlatformTime::Seconds();
+	}
+
+	switch (Control.ControlType)
+	{
+	case ETouchRouterControlType::Joystick:
+	case ETouchRouterControlType::FloatingJoystick:
+		if (Control.bAutoCenter)
+		{
+			State.Value = FVector2f::ZeroVector;
+		}
+		break;
+
+	case ETouchRouterControlType::GestureZone:
+	{
+		const FVector2f Delta = State.Position - State.Origin;
+		const bool bMoved = Delta.Size() >= Control.SwipeThreshold;
+		const bool bHeld = FPlatformTime::Seconds() - State.PressTime >= Control.LongPressDuration;
+
+		State.Value = FVector2f::ZeroVector;
+		if (Control.Gesture == ETouchRouterGesture::Tap && !bMoved && !bHeld)
+		{
+			State.Value = FVector2f(1.0f, 0.0f);
+			State.bPendingPulse = true;
+		}
+		else if (Control.Gesture == ETouchRouterGesture::Swipe && bMoved)
+		{
+			State.Value = TouchControlRouter::SnapTo4Directions(Delta);
+			State.bPendingPulse = true;
+		}
+		break;
+	}
+
+	case ETouchRouterControlType::TouchRegion:
+		// Keep any movement that has not been injected yet
+		break;
+
+	default:
+		State.Value = FVector2f::ZeroVector;
+		break;
+	}
+
+	InjectControl(ControlIndex);
+	return true;
+}
+
+bool UTouchControlRouter::ToViewportSpace(const FPointerEvent& TouchEvent, FVector2f& OutPixels, FVector2f& OutNormalized)
+{
+	const UGameViewportClient* ViewportClient = GetLocalPlayer()->ViewportClient;
+	const TSharedPtr<SViewport> ViewportWidget = ViewportClient ? ViewportClient->GetGameViewportWidget() : nullptr;
+	if (!ViewportWidget.IsValid())
+	{
+		return false;
+	}
+
+	const FGeometry& Geometry = ViewportWidget->GetCachedGeometry();
+	const FVector2f LocalSize = FVector2f(Geometry.GetLocalSize());
+	if (LocalSize.X <= 0.0f || LocalSize.Y <= 0.0f)
+	{
+		return false;
+	}
+
+	ViewportSize = LocalSize;
+	OutPixels = FVector2f(Geometry.AbsoluteToLocal(TouchEvent.GetScreenSpacePosition()));
+	OutNormalized = OutPixels / LocalSize;
+	return true;
+}
+
+int32 UTouchControlRouter::HitTest(const FVector2f& NormalizedPosition) const
+{
+	// Later controls are drawn on top, so they win overlaps
+	for (int32 ControlIndex = HitRects.Num() - 1; ControlIndex >= 0; --ControlIndex)
+	{
+		if (States[ControlIndex].PointerIndex == INDEX_NONE && HitRects[ControlIndex].IsInside(NormalizedPosition))
+		{
+			return ControlIndex;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void UTouchControlRouter::UpdateControlValue(int32 ControlIndex)
+{
+	const FTouchControlLayout& Control = Controls[ControlIndex];
+	FControlState& State = States[ControlIndex];
+
+	switch (Control.ControlType)
+	{
+	case ETouchRouterControlType::Joystick:
+	case ETouchRouterControlType::FloatingJoystick:
+	case ETouchRouterControlType::DPad:
+	{
+		// Same range as UVirtualJoystickWidget: half the smaller side of the control, Y down
+		const FVector2f ControlSize = HitRects[ControlIndex].GetSize() * ViewportSize;
+		const float MaxOffset = FMath::Max(FMath::Min(ControlSize.X, ControlSize.Y) * 0.5f, 1.0f);
+
+		FVector2f Offset = (State.Position - State.Origin) / MaxOffset;
+		const float Magnitude = FMath::Min(Offset.Size(), 1.0f);
+		if (Magnitude < Control.DeadZone)
+		{
+			State.Value = FVector2f::ZeroVector;
+			break;
+		}
+
+		const FVector2f Direction = Offset.GetSafeNormal();
+		if (Control.ControlType == ETouchRouterControlType::DPad)
+		{
+			State.Value = FVector2f(
+				FMath::Abs(Direction.X) >= TouchControlRouter::DPadAxisThreshold ? FMath::Sign(Direction.X) : 0.0f,
+				FMath::Abs(Direction.Y) >= TouchControlRouter::DPadAxisThreshold ? FMath::Sign(Direction.Y) : 0.0f);
+		}
+		else
+		{
+			// Remap from dead zone to 1
+			State.Value = Direction * ((Magnitude - Control.DeadZone) / (1.0f - Control.DeadZone));
+		}
+		break;
+	}
+
+	case ETouchRouterControlType::Button:
+		State.Value = FVector2f(1.0f, 0.0f);
+		break;
+
+	case ETouchRouterControlType::GestureZone:
+		// Long presses hold the action while the finger stays down (see HandleEndFrame)
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UTouchControlRouter::InjectControl(int32 ControlIndex)
+{
+	const FTouchControlLayout& Control = Controls[ControlIndex];
+	FControlState& State = States[ControlIndex];
+
+	if (!Control.Action || State.LastInjectionFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	// Held controls inject every frame; released ones only while they still have a value
+	const bool bHeld = State.PointerIndex != INDEX_NONE && Control.ControlType != ETouchRouterControlType::TouchRegion && Control.ControlType != ETouchRouterControlType::GestureZone;
+	if (!bHeld && !State.bPendingPulse && State.Value.IsNearlyZero())
+	{
+		// Nothing to inject for this touch, so there is no latency to measure
+		State.PendingTouchTime = 0.0;
+		return;
+	}
+
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem();
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	Subsystem->InjectInputForAction(Control.Action, FInputActionValue(Control.Action->ValueType, FVector(State.Value.X, State.Value.Y, 0.0f)), {}, {});
+	State.LastInjectionFrame = GFrameCounter;
+
+	INC_DWORD_STAT(STAT_InputStreamliner_TouchControlInjections);
+	// Once per injected frame, so the metrics are looked up once and recorded without the lock
+	static const FInputStreamlinerMetrics::FMetricId InjectionsMetric = FInputStreamlinerMetrics::FindOrAddMetric(TEXT("Touch.Injections"));
+	static const FInputStreamlinerMetrics::FMetricId TouchToInjectMetric = FInputStreamlinerMetrics::FindOrAddMetric(TEXT("Touch.TouchToInjectMs"));
+	FInputStreamlinerMetrics::Increment(InjectionsMetric);
+	if (State.PendingTouchTime > 0.0)
+	{
+		FInputStreamlinerMetrics::Record(TouchToInjectMetric, (FPlatformTime::Seconds() - State.PendingTouchTime) * 1000.0);
+		State.PendingTouchTime = 0.0;
+	}
+
+	// One-shot outputs are consumed by the injection
+	if (State.bPendingPulse)
+	{
+		State.bPendingPulse = false;
+		State.Value = FVector2f::ZeroVector;
+	}
+}
+
+void UTouchControlRouter::HandleEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	for (int32 ControlIndex = 0; ControlIndex < States.Num(); ++ControlIndex)
+	{
+		const FTouchControlLayout& Control = Controls[ControlIndex];
+		FControlState& State = States[ControlIndex];
+
+		if (Control.ControlType == ETouchRouterControlType::GestureZone && Control.Gesture == ETouchRouterGesture::LongPress)
+		{
+			const bool bPressed = State.PointerIndex != INDEX_NONE
+				&& Now - State.PressTime >= Control.LongPressDuration
+				&& (State.Position - State.Origin).Size() < Control.SwipeThreshold;
+			State.Value = bPressed ? FVector2f(1.0f, 0.0f) : FVector2f::ZeroVector;
+		}
+
+		InjectControl(ControlIndex);
+	}
+}
+
+void UTouchControlRouter::StartRouting()
+{
+	if (!TouchInputProcessor.IsValid())
+	{
+		TouchInputProcessor = MakeShareable(new FTouchControlInputProcessor(this));
+		if (FSlateApplication::IsInitialized())
+		{
+			FSlateApplication::Get().RegisterInputPreProcessor(TouchInputProcessor);
+		}
+	}
+
+	if (!EndFrameHandle.IsValid())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UTouchControlRouter::HandleEndFrame);
+	}
+}
+
+void UTouchControlRouter::StopRouting()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
+	if (TouchInputProcessor.IsValid() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(TouchInputProcessor);
+	}
+	TouchInputProcessor.Reset();
+}
+
+UEnhancedInputLocalPlayerSubsystem* UTouchControlRouter::GetInputSubsystem()
+{
+	if (!CachedInputSubsystem.IsValid())
+	{
+		CachedInputSubsystem = GetLocalPlayer()->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
+	}
+	return CachedInputSubsystem.Get();
+}
+
+bool UTouchControlRouter::IsEventFromPlayer(const FPointerEvent& TouchEvent) const
+{
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	const UGameInstance* GameInstance = LocalPlayer->GetGameInstance();
+
+	// With a single player every touch belongs to it
+	if (!GameInstance || GameInstance->GetNumLocalPlayers() <= 1)
+	{
+		return true;
+	}
+
+	return static_cast<int32>(TouchEvent.GetUserIndex()) == LocalPlayer->GetControllerId();
+}
+
+// ============== FTouchControlInputProcessor Implementation ==============
+
+bool FTouchControlInputProcessor::HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+{
+	return MouseEvent.IsTouchEvent() && Router.IsValid() && Router->IsEventFromPlayer(MouseEvent) && Router->HandleTouchMoved(MouseEvent);
+}
+
+bool FTouchControlInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+{
+	return MouseEvent.IsTouchEvent() && Router.IsValid() && Router->IsEventFromPlayer(MouseEvent) && Router->HandleTouchStarted(MouseEvent);
+}
+
+bool FTouchControlInputProcessor::HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+{
+	return MouseEvent.IsTouchEvent() && Router.IsValid() && Router->IsEventFromPlayer(MouseEvent) && Router->HandleTouchEnded(MouseEvent);
+}
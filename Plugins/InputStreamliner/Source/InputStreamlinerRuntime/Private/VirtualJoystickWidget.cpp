@@ -2,8 +2,16 @@
 
 #include "VirtualJoystickWidget.h"
 #include "InputStreamlinerRuntimeModule.h"
+#include "InputStreamlinerMetrics.h"
 #include "EnhancedInputSubsystems.h"
 #include "EnhancedPlayerInput.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Joystick Inject"), STAT_InputStreamliner_JoystickInject, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Joystick Injections"), STAT_InputStreamliner_JoystickInjections, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Joystick Collapsed Samples"), STAT_InputStreamliner_JoystickCollapsedSamples, STATGROUP_InputStreamliner);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Joystick Subsystem Lookups"), STAT_InputStreamliner_JoystickSubsystemLookups, STATGROUP_InputStreamliner);
 
 UVirtualJoystickWidget::UVirtualJoystickWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -35,6 +43,28 @@ FVector2D UVirtualJoystickWidget::GetValueWithDeadZone() const
 	return CurrentValue.GetSafeNormal() * RemappedMagnitude;
 }
 
+void UVirtualJoystickWidget::SetLinkedAction(UInputAction* Action)
+{
+	LinkedAction = Action;
+	RefreshInputSubsystem();
+}
+
+void UVirtualJoystickWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	RefreshInputSubsystem();
+	WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UVirtualJoystickWidget::HandleWorldTickStart);
+}
+
+void UVirtualJoystickWidget::NativeDestruct()
+{
+	FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+	WorldTickStartHandle.Reset();
+
+	Super::NativeDestruct();
+}
+
 FReply UVirtualJoystickWidget::NativeOnTouchStarted(const FGeometry& InGeometry, const FPointerEvent& InGestureEvent)
 {
 	if (ActiveTouchIndex != -1)
@@ -59,6 +89,8 @@ FReply UVirtualJoystickWidget::NativeOnTouchStarted(const FGeometry& InGeometry,
 		CenterPosition = InGeometry.GetLocalSize() * 0.5f;
 	}
 
+	PendingTouchTime = FPlatformTime::Seconds();
+	bTouchSamplePending = true;
 	UpdateJoystickPosition(LocalPosition, InGeometry);
 	OnJoystickActivated();
 
@@ -72,6 +104,19 @@ FReply UVirtualJoystickWidget::NativeOnTouchMoved(const FGeometry& InGeometry, c
 		return FReply::Unhandled();
 	}
 
+	// Latency is measured from the oldest touch not yet injected
+	if (PendingTouchTime == 0.0)
+	{
+		PendingTouchTime = FPlatformTime::Seconds();
+	}
+
+	// Only the latest sample of the frame is injected
+	if (bTouchSamplePending)
+	{
+		INC_DWORD_STAT(STAT_InputStreamliner_JoystickCollapsedSamples);
+	}
+	bTouchSamplePending = true;
+
 	FVector2D LocalPosition = InGeometry.AbsoluteToLocal(InGestureEvent.GetScreenSpacePosition());
 	UpdateJoystickPosition(LocalPosition, InGeometry);
 
@@ -103,11 +148,17 @@ void UVirtualJoystickWidget::NativeTick(const FGeometry& MyGeometry, float InDel
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
-	// Continuously inject the input value while active
-	if (bIsActive || CurrentValue.SizeSquared() > KINDA_SMALL_NUMBER)
+	// Continuously inject the input value while active (skipped if the world tick hook already injected this frame)
+	const bool bHasValue = bIsActive || CurrentValue.SizeSquared() > KINDA_SMALL_NUMBER;
+	if (bHasValue && LastInjectionFrame != GFrameCounter)
 	{
 		InjectInputValue(GetValueWithDeadZone());
 	}
+	else if (!bHasValue)
+	{
+		// Released without anything left to inject
+		PendingTouchTime = 0.0;
+	}
 }
 
 void UVirtualJoystickWidget::UpdateJoystickPosition(const FVector2D& TouchPosition, const FGeometry& Geometry)
@@ -138,21 +189,14 @@ void UVirtualJoystickWidget::InjectInputValue(const FVector2D& Value)
 		return;
 	}
 
-	// Get the local player controller
-	APlayerController* PC = GetOwningPlayer();
-	if (!PC)
+	if (LastInjectionFrame == GFrameCounter)
 	{
 		return;
 	}
 
-	// Get the Enhanced Input Local Player Subsystem
-	ULocalPlayer* LocalPlayer = PC->GetLocalPlayer();
-	if (!LocalPlayer)
-	{
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_InputStreamliner_JoystickInject);
 
-	UEnhancedInputLocalPlayerSubsystem* Subsystem = LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
+	UEnhancedInputLocalPlayerSubsystem* Subsystem = GetInputSubsystem();
 	if (!Subsystem)
 	{
 		return;
@@ -160,4 +204,43 @@ void UVirtualJoystickWidget::InjectInputValue(const FVector2D& Value)
 
 	// Inject the input value
 	Subsystem->InjectInputForAction(LinkedAction, FInputActionValue(Value), {}, {});
+	LastInjectionFrame = GFrameCounter;
+	bTouchSamplePending = false;
+
+	INC_DWORD_STAT(STAT_InputStreamliner_JoystickInjections);
+	// Once per injected frame, so the metrics are looked up once and recorded without the lock
+	static const FInputStreamlinerMetrics::FMetricId InjectionsMetric = FInputStreamlinerMetrics::FindOrAddMetric(TEXT("Joystick.Injections"));
+	static const FInputStreamlinerMetrics::FMetricId TouchToInjectMetric = FInputStreamlinerMetrics::FindOrAddMetric(TEXT("Joystick.TouchToInjectMs"));
+	FInputStreamlinerMetrics::Increment(InjectionsMetric);
+	if (PendingTouchTime > 0.0)
+	{
+		FInputStreamlinerMetrics::Record(TouchToInjectMetric, (FPlatformTime::Seconds() - PendingTouchTime) * 1000.0);
+		PendingTouchTime = 0.0;
+	}
+}
+
+void UVirtualJoystickWidget::HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	// Touch events for this frame have been processed and player input has not run yet
+	if (bInjectAtWorldTickStart && bTouchSamplePending && World == GetWorld())
+	{
+		InjectInputValue(GetValueWithDeadZone());
+	}
+}
+
+UEnhancedInputLocalPlayerSubsystem* UVirtualJoystickWidget::GetInputSubsystem()
+{
+	if (!CachedInputSubsystem.IsValid())
+	{
+		RefreshInputSubsystem();
+	}
+	return CachedInputSubsystem.Get();
+}
+
+void UVirtualJoystickWidget::RefreshInputSubsystem()
+{
+	INC_DWORD_STAT(STAT_InputStreamliner_JoystickSubsystemLookups);
+
+	const ULocalPlayer* LocalPlayer = GetOwningLocalPlayer();
+	CachedInputSubsystem = LocalPlayer ? LocalPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>() : nullptr;
 }
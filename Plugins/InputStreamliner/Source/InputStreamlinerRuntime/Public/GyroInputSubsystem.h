@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Containers/CircularQueue.h"
+#include "Engine/EngineBaseTypes.h"
+#include "InputAction.h"
+#include "GyroInputSubsystem.generated.h"
+
+class UEnhancedInputLocalPlayerSubsystem;
+
+/**
+ * Runtime gyro settings, the counterpart of FGyroConfiguration with action references
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FGyroInputSettings
+{
+	GENERATED_BODY()
+
+	/** Whether gyro input is enabled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro")
+	bool bEnabled = false;
+
+	/** Also require the player's saved gyro setting (ULocalPlayerRebindingManager::SetGyroEnabled) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro")
+	bool bRequirePlayerOptIn = true;
+
+	/** The Axis2D input action that receives gyro output (typically Look or Aim) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro")
+	TObjectPtr<UInputAction> LinkedAction;
+
+	/** Action that must be held for gyro to work (e.g., Aim for ADS-only gyro); none means always on */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro")
+	TObjectPtr<UInputAction> ActivationAction;
+
+	/** Sensitivity multiplier, applied on top of the player's gyro sensitivity */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro", meta = (ClampMin = "0.1", ClampMax = "5.0"))
+	float Sensitivity = 1.0f;
+
+	/** Whether to invert horizontal axis */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro")
+	bool bInvertHorizontal = false;
+
+	/** Whether to invert vertical axis */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro")
+	bool bInvertVertical = false;
+
+	/** One-euro filter cutoff at rest in Hz; lower removes more jitter when holding still */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro|Smoothing", meta = (ClampMin = "0.01", ClampMax = "10.0"))
+	float MinCutoff = 1.0f;
+
+	/** One-euro filter speed coefficient; higher reduces lag during fast turns */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro|Smoothing", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Beta = 0.05f;
+
+	/** One-euro filter cutoff for the rate of change in Hz */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gyro|Smoothing", meta = (ClampMin = "0.1", ClampMax = "10.0"))
+	float DerivativeCutoff = 1.0f;
+};
+
+/**
+ * One-euro filter (Casiez et al.): a low-pass filter whose cutoff rises with speed,
+ * smoothing jitter at rest without adding lag to fast movements
+ */
+struct INPUTSTREAMLINERRUNTIME_API FOneEuroFilter
+{
+	/** Filter a sample taken DeltaTime seconds after the previous one */
+	float Filter(float Value, float DeltaTime, float MinCutoff, float Beta, float DerivativeCutoff);
+
+	/** Forget the previous samples */
+	void Reset() { bInitialized = false; }
+
+private:
+	static float SmoothingFactor(float Cutoff, float DeltaTime);
+
+	float PreviousValue = 0.0f;
+	float PreviousDerivative = 0.0f;
+	bool bInitialized = false;
+};
+
+/**
+ * Drives an input action from the device gyroscope.
+ * Motion samples are queued as they arrive in a lock-free ring buffer; right before actors tick,
+ * every pending sample is smoothed and integrated over the time it covers, so aim depends on how far
+ * the device turned rather than on how many frames were rendered.
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINERRUNTIME_API UGyroInputSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGyroInputSubsystem();
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/** Apply gyro settings; sampling starts when enabled with a linked action */
+	UFUNCTION(BlueprintCallable, Category = "Gyro")
+	void SetSettings(const FGyroInputSettings& InSettings);
+
+	/** Get the gyro settings */
+	UFUNCTION(BlueprintPure, Category = "Gyro")
+	const FGyroInputSettings& GetSettings() const { return Settings; }
+
+	/** Gyro output injected this frame, in degrees (before sensitivity) */
+	UFUNCTION(BlueprintPure, Category = "Gyro")
+	FVector2D GetLastDelta() const { return FVector2D(LastDelta); }
+
+	/**
+	 * Queue a rotation rate sample (radians per second, device space).
+	 * Safe to call from one producer thread at a time, e.g. a platform sensor callback.
+	 * @param Timestamp Time the sensor took the sample in seconds, or 0 if unknown; samples without
+	 * a timestamp split the frame's delta time evenly
+	 */
+	void PushSample(const FVector& RotationRate, double Timestamp = 0.0);
+
+	/** Check if a Slate input event came from this player */
+	bool IsEventFromPlayer(uint32 SlateUserIndex) const;
+
+	friend class FGyroMotionInputProcessor;
+
+private:
+	/** Motion sample queued for the game thread */
+	struct FGyroSample
+	{
+		FVector3f RotationRate = FVector3f::ZeroVector;
+		double Timestamp = 0.0;
+	};
+
+	/** Integrate the pending samples and inject the result */
+	void HandlePreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Check if the activation action, the settings and the player allow gyro input */
+	bool IsGyroActive() const;
+
+	/** Register or unregister the motion processor and tick handler */
+	void StartSampling();
+	void StopSampling();
+
+	/** Get the owning player's Enhanced Input subsystem */
+	UEnhancedInputLocalPlayerSubsystem* GetInputSubsystem() const;
+
+	/** Current settings */
+	UPROPERTY(Transient)
+	FGyroInputSettings Settings;
+
+	/** Samples waiting for the game thread */
+	TCircularQueue<FGyroSample> PendingSamples;
+
+	/** Per-axis smoothing */
+	FOneEuroFilter HorizontalFilter;
+	FOneEuroFilter VerticalFilter;
+
+	/** Timestamp of the last integrated sample, or 0 before the first */
+	double LastSampleTime = 0.0;
+
+	/** Output of the last frame */
+	FVector2f LastDelta = FVector2f::ZeroVector;
+
+	/** Enhanced Input subsystem of the owning player */
+	mutable TWeakObjectPtr<UEnhancedInputLocalPlayerSubsystem> CachedInputSubsystem;
+
+	/** Handle for the once-per-frame integration */
+	FDelegateHandle PreActorTickHandle;
+
+	/** Input processor receiving motion events */
+	TSharedPtr<class FGyroMotionInputProcessor> MotionInputProcessor;
+};
+
+/**
+ * Input processor that queues motion events for the gyro subsystem
+ */
+class FGyroMotionInputProcessor : public IInputProcessor
+{
+public:
+	FGyroMotionInputProcessor(UGyroInputSubsystem* InGyro) : Gyro(InGyro) {}
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+	virtual bool HandleMotionDetectedEvent(FSlateApplication& SlateApp, const FMotionEvent& MotionEvent) override;
+
+	virtual const TCHAR* GetDebugName() const override { return TEXT("GyroInput"); }
+
+private:
+	TWeakObjectPtr<UGyroInputSubsystem> Gyro;
+};
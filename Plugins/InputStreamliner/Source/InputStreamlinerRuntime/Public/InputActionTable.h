@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputCoreTypes.h"
+#include "Engine/StreamableManager.h"
+
+class UInputAction;
+
+/**
+ * One action of a generated action table
+ */
+struct FInputActionTableEntry
+{
+	/** Action name from the Input Streamliner configuration */
+	const TCHAR* Name;
+
+	/** Object path of the generated Input Action */
+	const TCHAR* ObjectPath;
+
+	/** Names of the default keys (FKey names), or nullptr when there are none */
+	const TCHAR* const* DefaultKeys;
+
+	/** Number of entries in DefaultKeys */
+	int32 NumDefaultKeys;
+};
+
+/**
+ * Runtime view of an action table generated by Input Streamliner (code generation set to C++).
+ * The generated header declares an enum of actions and constexpr arrays of their paths and default keys;
+ * this wraps those arrays so actions are addressed by enum index instead of by path or name lookups.
+ */
+class INPUTSTREAMLINERRUNTIME_API FInputActionTable
+{
+public:
+	FInputActionTable(TConstArrayView<FInputActionTableEntry> InActions, TConstArrayView<const TCHAR*> InMappingContextPaths);
+
+	/** Number of actions */
+	int32 Num() const { return Actions.Num(); }
+
+	/** Get the generated entry of an action */
+	const FInputActionTableEntry& GetEntry(int32 Index) const { return Actions[Index]; }
+
+	/** Object path of an action */
+	const FSoftObjectPath& GetActionPath(int32 Index) const { return ActionPaths[Index]; }
+
+	/** Object paths of the generated mapping contexts */
+	const TArray<FSoftObjectPath>& GetMappingContextPaths() const { return MappingContextPaths; }
+
+	/** Get an action if it is loaded; never loads */
+	UInputAction* GetAction(int32 Index) const;
+
+	/** Default keys of an action */
+	TArray<FKey> GetDefaultKeys(int32 Index) const;
+
+	/** Object paths of every action and mapping context */
+	TArray<FSoftObjectPath> GetAllAssetPaths() const;
+
+	/** Load every action and mapping context asynchronously in one streamable handle */
+	TSharedPtr<FStreamableHandle> Preload(FStreamableDelegate OnLoaded = FStreamableDelegate()) const;
+
+private:
+	/** The generated entries */
+	TConstArrayView<FInputActionTableEntry> Actions;
+
+	/** Parsed action paths, parallel to Actions */
+	TArray<FSoftObjectPath> ActionPaths;
+
+	/** Parsed mapping context paths */
+	TArray<FSoftObjectPath> MappingContextPaths;
+};
@@ -0,0 +1,82 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "InputCoreTypes.h"
+#include "InputAssetManifest.generated.h"
+
+class UInputAction;
+class UInputMappingContext;
+
+/**
+ * A generated Input Action and the keys it is registered with for rebinding
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FGeneratedInputActionEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	TSoftObjectPtr<UInputAction> Action;
+
+	/** Default keys registered with UInputRebindingManager */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	TArray<FKey> DefaultKeys;
+
+	/** Platforms the action is used on (PC_Keyboard, PC_Gamepad, Mac, iOS, Android) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	TArray<FName> Platforms;
+
+	/** Whether players can rebind the action; only these are registered with the rebinding manager */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	bool bAllowRebinding = true;
+};
+
+/**
+ * A generated Mapping Context and the platform it was generated for
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FGeneratedMappingContextEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	TSoftObjectPtr<UInputMappingContext> Context;
+
+	/** Platform name (PC_Keyboard, PC_Gamepad, Mac, iOS, Android) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	FName Platform;
+};
+
+/**
+ * Every asset produced by the last Input Streamliner generation, written by the editor generator.
+ * Referenced from the project settings so the runtime module can preload and register the assets at startup.
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINERRUNTIME_API UInputAssetManifest : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Generated Input Actions */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	TArray<FGeneratedInputActionEntry> Actions;
+
+	/** Generated Mapping Contexts */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Manifest")
+	TArray<FGeneratedMappingContextEntry> MappingContexts;
+
+	/** Platform names whose assets this build uses, most specific first */
+	static TArray<FName> GetCurrentPlatformNames();
+
+	/** Check if an action is used on any of the platforms */
+	static bool IsActionOnPlatforms(const FGeneratedInputActionEntry& Entry, const TArray<FName>& PlatformNames);
+
+	/** Object paths of the actions and mapping contexts used on the platforms */
+	TArray<FSoftObjectPath> GetAssetPathsForPlatforms(const TArray<FName>& PlatformNames) const;
+
+	/** Mapping context of the first platform that has one */
+	TSoftObjectPtr<UInputMappingContext> FindMappingContext(const TArray<FName>& PlatformNames) const;
+};
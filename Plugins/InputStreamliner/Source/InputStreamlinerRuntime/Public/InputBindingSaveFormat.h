@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FInputBindingSaveData;
+
+/**
+ * Compact binary encoding of FInputBindingSaveData.
+ * Action and key names are written once to a string table and referenced by index.
+ */
+struct INPUTSTREAMLINERRUNTIME_API FInputBindingSaveFormat
+{
+	/** Identifies a binary bindings file */
+	static constexpr uint32 Magic = 0x4E425349; // "ISBN"
+
+	/** Version written by Write. Version 1 is the legacy JSON layout. */
+	static constexpr int32 CurrentVersion = 2;
+
+	/** Range the sensitivity setters clamp to */
+	static constexpr float MinSensitivity = 0.1f;
+	static constexpr float MaxSensitivity = 5.0f;
+
+	/** Encode save data; output is deterministic for equal data */
+	static void Write(const FInputBindingSaveData& Data, TArray<uint8>& OutBytes);
+
+	/** Decode save data, migrating older binary versions; loaded values are sanitized */
+	static bool Read(const TArray<uint8>& Bytes, FInputBindingSaveData& OutData);
+
+	/** Reset non-finite sensitivities, clamp them to the setters' range and drop non-finite touch positions */
+	static void Sanitize(FInputBindingSaveData& Data);
+};
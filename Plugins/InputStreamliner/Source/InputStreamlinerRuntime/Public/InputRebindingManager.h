@@ -5,15 +5,19 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "InputAction.h"
-#include "Framework/Application/IInputProcessor.h"
 #include "InputRebindingManager.generated.h"
 
-class UEnhancedInputLocalPlayerSubsystem;
 class UInputMappingContext;
+class ULocalPlayer;
+class ULocalPlayerRebindingManager;
+class FInputActionTable;
+class UInputAssetManifest;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRebindComplete, UInputAction*, Action, FKey, NewKey);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAnyKeyPressed, FKey, Key);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBindingConflict, UInputAction*, ExistingAction, FKey, ConflictingKey);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnActionBindingsChanged, UInputAction* /*Action*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBindingProfileApplied, FName, ProfileName, const TArray<UInputAction*>&, ChangedActions);
 
 /**
  * Data structure for saving player input bindings
@@ -38,11 +42,11 @@ struct INPUTSTREAMLINERRUNTIME_API FInputBindingSaveData
 {
 	GENERATED_BODY()
 
-	/** Save data version for migration */
+	/** Save data version for migration (1 = legacy JSON, see FInputBindingSaveFormat) */
 	UPROPERTY(SaveGame)
 	int32 Version = 1;
 
-	/** Per-action key bindings */
+	/** Per-action key bindings that differ from the registered defaults */
 	UPROPERTY(SaveGame)
 	TArray<FActionBindingSave> Bindings;
 
@@ -72,8 +76,75 @@ struct INPUTSTREAMLINERRUNTIME_API FInputBindingSaveData
 };
 
 /**
- * Runtime subsystem for managing input rebinding
- * Persists player bindings and handles the rebinding UI flow
+ * An action and its default keys, for batch registration
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FActionDefaultBindings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rebinding")
+	TObjectPtr<UInputAction> Action;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rebinding")
+	TArray<FKey> DefaultKeys;
+};
+
+/**
+ * A key bound to more than one action
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FInputBindingConflict
+{
+	GENERATED_BODY()
+
+	/** The shared key */
+	UPROPERTY(BlueprintReadOnly, Category = "Rebinding")
+	FKey Key;
+
+	/** Every action currently bound to the key */
+	UPROPERTY(BlueprintReadOnly, Category = "Rebinding")
+	TArray<TObjectPtr<UInputAction>> Actions;
+};
+
+/**
+ * A named set of bindings, such as a control preset or a cloud profile.
+ * Actions the profile doesn't list keep their default bindings.
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FInputBindingProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rebinding")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rebinding")
+	TArray<FActionBindingSave> Bindings;
+};
+
+/**
+ * A profile resolved against the registered actions: the complete keys of every action, ready to apply
+ */
+struct INPUTSTREAMLINERRUNTIME_API FCompiledBindingProfile
+{
+	struct FActionKeys
+	{
+		TObjectPtr<UInputAction> Action;
+		TArray<FKey> Keys;
+	};
+
+	TArray<FActionKeys> Actions;
+
+	/** Registration generation the profile was compiled against */
+	uint32 Generation = 0;
+};
+
+/**
+ * Runtime subsystem for managing input rebinding.
+ * Owns the default bindings shared by every local player; each player's bindings,
+ * mapping context and save slot live in its ULocalPlayerRebindingManager.
+ * The binding functions here act on the first local player.
  */
 UCLASS(BlueprintType)
 class INPUTSTREAMLINERRUNTIME_API UInputRebindingManager : public UGameInstanceSubsystem
@@ -86,7 +157,47 @@ public:
 	virtual void Deinitialize() override;
 	//~ End USubsystem Interface
 
-	// Rebinding Flow
+	// Players
+
+	/** Get the rebinding state of a local player */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	ULocalPlayerRebindingManager* GetPlayerManager(const ULocalPlayer* LocalPlayer) const;
+
+	/** Get the rebinding state of the first local player */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	ULocalPlayerRebindingManager* GetPrimaryPlayerManager() const;
+
+	// Registration
+
+	/** Register an action with its default bindings (call during game setup) */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void RegisterAction(UInputAction* Action, const TArray<FKey>& InDefaultBindings);
+
+	/** Register many actions at once; their saved bindings are applied in a single rebuild per player */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void RegisterActions(const TArray<FActionDefaultBindings>& Actions);
+
+	/**
+	 * Register every action of a generated action table with its default keys, in one batch.
+	 * The actions must be loaded (see FInputActionTable::Preload); they can then be looked up by table index.
+	 */
+	void RegisterActionTable(const FInputActionTable& Table);
+
+	/** Get an action registered from an action table by its index, or null */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	UInputAction* GetIndexedAction(int32 Index) const { return IndexedActions.IsValidIndex(Index) ? IndexedActions[Index].Get() : nullptr; }
+
+	/** Get an action registered from an action table by its generated enum value */
+	template<typename EnumType>
+	UInputAction* GetTableAction(EnumType Action) const { return GetIndexedAction(static_cast<int32>(Action)); }
+
+	/** Get the default bindings of a registered action */
+	const TArray<FKey>* FindDefaultBindings(UInputAction* Action) const { return DefaultBindings.Find(Action); }
+
+	/** Get every registered action and its default bindings */
+	const TMap<TObjectPtr<UInputAction>, TArray<FKey>>& GetDefaultBindings() const { return DefaultBindings; }
+
+	// Rebinding Flow (first local player)
 
 	/** Start listening for a new key binding for an action */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
@@ -98,13 +209,13 @@ public:
 
 	/** Check if currently waiting for a key press */
 	UFUNCTION(BlueprintPure, Category = "Rebinding")
-	bool IsRebindingInProgress() const { return PendingRebindAction != nullptr; }
+	bool IsRebindingInProgress() const;
 
 	/** Get the action currently being rebound */
 	UFUNCTION(BlueprintPure, Category = "Rebinding")
-	UInputAction* GetPendingRebindAction() const { return PendingRebindAction; }
+	UInputAction* GetPendingRebindAction() const;
 
-	// Binding Management
+	// Binding Management (first local player)
 
 	/** Get current bindings for an action */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
@@ -122,6 +233,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
 	bool HasConflict(UInputAction* Action, FKey Key, UInputAction*& OutConflictingAction) const;
 
+	/** Get every key bound to more than one action */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	TArray<FInputBindingConflict> GetAllConflicts() const;
+
+	/** Get the actions currently bound to a key */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	TArray<UInputAction*> GetActionsForKey(FKey Key) const;
+
 	/** Swap bindings between two actions (for conflict resolution) */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
 	void SwapBindings(UInputAction* ActionA, UInputAction* ActionB, FKey Key);
@@ -134,53 +253,85 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
 	void ResetAllToDefaults();
 
-	// Sensitivity Settings
+	// Binding Profiles
+
+	/** Register a binding profile, replacing any with the same name; it is compiled once against the registered actions */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Profiles")
+	void RegisterBindingProfile(const FInputBindingProfile& Profile);
+
+	/** Remove a registered binding profile */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Profiles")
+	void UnregisterBindingProfile(FName ProfileName);
+
+	/** Get the names of every registered binding profile */
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Profiles")
+	TArray<FName> GetBindingProfileNames() const;
+
+	/**
+	 * Switch the first local player to a registered profile in a single mapping rebuild.
+	 * With bOnlyChanged, actions whose keys already match are left untouched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Profiles")
+	bool ApplyBindingProfile(FName ProfileName, bool bOnlyChanged = true);
+
+	/** Get the profile the first local player last switched to (None after a manual change) */
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Profiles")
+	FName GetActiveBindingProfile() const;
+
+	/** Get a compiled profile, recompiling it if actions were registered since; null if unknown */
+	const FCompiledBindingProfile* FindCompiledBindingProfile(FName ProfileName);
+
+	// Sensitivity Settings (first local player)
 
 	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
 	void SetMouseSensitivity(float Sensitivity);
 
 	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
-	float GetMouseSensitivity() const { return SaveData.MouseSensitivity; }
+	float GetMouseSensitivity() const;
 
 	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
 	void SetGamepadSensitivity(float Sensitivity);
 
 	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
-	float GetGamepadSensitivity() const { return SaveData.GamepadSensitivity; }
+	float GetGamepadSensitivity() const;
 
 	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
 	void SetGyroSensitivity(float Sensitivity);
 
 	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
-	float GetGyroSensitivity() const { return SaveData.GyroSensitivity; }
+	float GetGyroSensitivity() const;
 
 	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
 	void SetInvertY(bool bInvert);
 
 	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
-	bool GetInvertY() const { return SaveData.bInvertY; }
+	bool GetInvertY() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
+	void SetGyroEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
+	bool GetGyroEnabled() const;
 
-	// Persistence
+	// Persistence (first local player)
 
 	/** Save bindings to local storage */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding|Persistence")
 	bool SaveBindings();
 
+	/** Write the current bindings as JSON for debugging */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Persistence")
+	bool ExportBindingsToJson(const FString& FilePath = TEXT(""));
+
 	/** Load bindings from local storage */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding|Persistence")
 	bool LoadBindings();
 
 	/** Get the save slot name */
 	UFUNCTION(BlueprintPure, Category = "Rebinding|Persistence")
-	FString GetSaveSlotName() const { return TEXT("InputBindings"); }
-
-	// Registration
+	FString GetSaveSlotName() const;
 
-	/** Register an action with its default bindings (call during game setup) */
-	UFUNCTION(BlueprintCallable, Category = "Rebinding")
-	void RegisterAction(UInputAction* Action, const TArray<FKey>& DefaultBindings);
-
-	// Events
+	// Events (broadcast for every local player)
 
 	/** Called when rebinding completes successfully */
 	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
@@ -194,76 +345,59 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
 	FOnBindingConflict OnBindingConflict;
 
-	/** Get the active mapping context for a player */
+	/** Called once per profile switch with every action whose bindings changed */
+	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
+	FOnBindingProfileApplied OnBindingProfileApplied;
+
+	// Mapping Context (first local player)
+
+	/** Set the active mapping context, added at the given priority if not already applied */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
-	void SetMappingContext(UInputMappingContext* Context);
+	void SetMappingContext(UInputMappingContext* Context, int32 Priority = 0);
 
-	/** Get the registered mapping context */
+	/** Get the first local player's copy of the mapping context */
 	UFUNCTION(BlueprintPure, Category = "Rebinding")
-	UInputMappingContext* GetMappingContext() const { return ActiveMappingContext; }
+	UInputMappingContext* GetMappingContext() const;
 
-	// Allow input processor to access private members
-	friend class FRebindInputProcessor;
+	/** Rebuild input mappings now if any binding changed */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void FlushPendingMappingChanges();
 
-private:
-	/** Handle key input during rebinding */
-	bool HandleKeyDown(const FKeyEvent& KeyEvent);
+	/** Generated mapping context for this platform, once the generated assets are preloaded */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	UInputMappingContext* GetGeneratedMappingContext() const { return GeneratedMappingContext; }
 
-	/** Handle gamepad input during rebinding */
-	bool HandleAnalogInput(const FAnalogInputEvent& AnalogEvent);
+	/** Check if the generated assets from the project settings have been loaded and registered */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	bool AreGeneratedAssetsRegistered() const { return bGeneratedAssetsRegistered; }
 
-	/** Apply loaded bindings to the input system */
-	void ApplyLoadedBindings();
+private:
+	/** Register the preloaded generated actions in one batch and apply the generated mapping context */
+	void HandleGeneratedAssetsLoaded(const UInputAssetManifest* Manifest);
 
-	/** Apply a single binding change to the mapping context */
-	void ApplyBindingToMappingContext(UInputAction* Action, FKey OldKey, FKey NewKey);
+	/** Resolve a profile's action names and fill in the defaults of actions it doesn't list */
+	void CompileBindingProfile(const FInputBindingProfile& Profile, FCompiledBindingProfile& OutCompiled) const;
 
-	/** Get Enhanced Input subsystem for local player */
-	UEnhancedInputLocalPlayerSubsystem* GetEnhancedInputSubsystem() const;
+	/** Stored default bindings, shared by every player (not UPROPERTY - TMap<TArray> not supported) */
+	TMap<TObjectPtr<UInputAction>, TArray<FKey>> DefaultBindings;
 
-	/** The action currently being rebound */
+	/** Registered binding profiles by name */
 	UPROPERTY(Transient)
-	TObjectPtr<UInputAction> PendingRebindAction;
+	TMap<FName, FInputBindingProfile> BindingProfiles;
 
-	/** Index of the binding being changed */
-	int32 PendingBindingIndex = 0;
+	/** Compiled form of each registered profile */
+	TMap<FName, FCompiledBindingProfile> CompiledBindingProfiles;
 
-	/** Stored default bindings for reset functionality (not UPROPERTY - TMap<TArray> not supported) */
-	TMap<TObjectPtr<UInputAction>, TArray<FKey>> DefaultBindings;
-
-	/** Current custom bindings (not UPROPERTY - TMap<TArray> not supported) */
-	TMap<TObjectPtr<UInputAction>, TArray<FKey>> CurrentBindings;
+	/** Bumped whenever the registered actions change, so compiled profiles know they are stale */
+	uint32 RegistrationGeneration = 1;
 
-	/** Save data */
+	/** Actions registered from an action table, by table index */
 	UPROPERTY(Transient)
-	FInputBindingSaveData SaveData;
+	TArray<TObjectPtr<UInputAction>> IndexedActions;
 
-	/** The active mapping context to modify */
+	/** Generated mapping context for this platform */
 	UPROPERTY(Transient)
-	TObjectPtr<UInputMappingContext> ActiveMappingContext;
-
-	/** Input processor for capturing rebind keys */
-	TSharedPtr<class FRebindInputProcessor> RebindInputProcessor;
-};
-
-/**
- * Input processor that captures key presses during rebinding
- */
-class FRebindInputProcessor : public IInputProcessor
-{
-public:
-	FRebindInputProcessor(UInputRebindingManager* InManager) : Manager(InManager) {}
+	TObjectPtr<UInputMappingContext> GeneratedMappingContext;
 
-	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
-
-	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
-	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override { return false; }
-	virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override;
-	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return false; }
-	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
-	virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return false; }
-	virtual bool HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent) override;
-
-private:
-	TWeakObjectPtr<UInputRebindingManager> Manager;
+	bool bGeneratedAssetsRegistered = false;
 };
@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * File helpers shared by the Input Streamliner save paths
+ */
+struct INPUTSTREAMLINERRUNTIME_API FInputStreamlinerFileUtils
+{
+	/**
+	 * Write to a temp file next to the destination, then move it over the destination.
+	 * A crash mid-write leaves the previous file intact. Safe to call from any thread.
+	 */
+	static bool SaveBytesAtomically(const TArray<uint8>& Bytes, const FString& FilePath);
+
+	/** Text variant of SaveBytesAtomically */
+	static bool SaveStringAtomically(const FString& Text, const FString& FilePath);
+};
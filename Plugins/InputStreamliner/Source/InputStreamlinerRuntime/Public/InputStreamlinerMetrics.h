@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+/** Unreal Insights channel for Input Streamliner scopes (trace.enable InputStreamliner) */
+UE_TRACE_CHANNEL_EXTERN(InputStreamlinerChannel, INPUTSTREAMLINERRUNTIME_API);
+
+/** Trace a scope on the Input Streamliner channel */
+#define INPUTSTREAMLINER_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, InputStreamlinerChannel)
+
+/**
+ * Process-wide counters and timings recorded next to the STATGROUP_InputStreamliner stats.
+ * Unlike stats they are collected in every build configuration, so QA can dump them with
+ * InputStreamliner.Metrics and attach the output to perf bugs. Safe to record from any thread.
+ * Recording is lock-free; the lock is only taken to register a metric and to read or reset them.
+ * Per-event paths should cache an FMetricId in a function-local static instead of passing a name each time.
+ */
+class INPUTSTREAMLINERRUNTIME_API FInputStreamlinerMetrics
+{
+public:
+	/** Accumulated samples of one metric */
+	struct FMetric
+	{
+		int64 Count = 0;
+		double Total = 0.0;
+		double Min = 0.0;
+		double Max = 0.0;
+		double Last = 0.0;
+
+		/** Most samples recorded within one frame */
+		int32 MaxPerFrame = 0;
+
+		/** Frame of the last sample and the samples recorded in it */
+		uint64 LastFrame = MAX_uint64;
+		int32 CountInLastFrame = 0;
+
+		double GetAverage() const { return Count > 0 ? Total / Count : 0.0; }
+	};
+
+private:
+	/** Live storage of one metric, updated without the lock */
+	struct FAtomicMetric
+	{
+		std::atomic<int64> Count = 0;
+		std::atomic<double> Total = 0.0;
+		std::atomic<double> Min = TNumericLimits<double>::Max();
+		std::atomic<double> Max = TNumericLimits<double>::Lowest();
+		std::atomic<double> Last = 0.0;
+		std::atomic<int32> MaxPerFrame = 0;
+		std::atomic<uint64> LastFrame = MAX_uint64;
+		std::atomic<int32> CountInLastFrame = 0;
+	};
+
+public:
+	/** Registered metric, valid for the lifetime of the process */
+	class FMetricId
+	{
+	public:
+		bool IsValid() const { return Metric != nullptr; }
+
+	private:
+		friend class FInputStreamlinerMetrics;
+		explicit FMetricId(FAtomicMetric* InMetric) : Metric(InMetric) {}
+
+		FAtomicMetric* Metric = nullptr;
+	};
+
+	/** Register a metric, or find it if it already exists. Takes the lock, so cache the result on hot paths */
+	static FMetricId FindOrAddMetric(FName Name);
+
+	/** Add a sample (a duration in ms, a byte count, a rate...) */
+	static void Record(FMetricId Id, double Value);
+	static void Record(FName Name, double Value) { Record(FindOrAddMetric(Name), Value); }
+
+	/** Add a sample of 1, for per-frame event counts */
+	static void Increment(FMetricId Id) { Record(Id, 1.0); }
+	static void Increment(FName Name) { Record(Name, 1.0); }
+
+	/** Copy of every metric, sorted by name */
+	static TArray<TPair<FName, FMetric>> GetSnapshot();
+
+	/** Frames since the metrics were last reset */
+	static uint64 GetFramesSinceReset();
+
+	/** Forget every sample */
+	static void Reset();
+
+	/** One line per metric, for the console and logs */
+	static void Dump(FOutputDevice& Ar);
+
+	/** Records the milliseconds between construction and destruction */
+	class FScopedTimer
+	{
+	public:
+		explicit FScopedTimer(FMetricId InId)
+			: Id(InId)
+			, StartTime(FPlatformTime::Seconds())
+		{
+		}
+
+		explicit FScopedTimer(FName InName)
+			: FScopedTimer(FindOrAddMetric(InName))
+		{
+		}
+
+		~FScopedTimer()
+		{
+			Record(Id, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+	private:
+		FMetricId Id;
+		double StartTime;
+	};
+
+private:
+	static FCriticalSection& GetLock();
+	static TMap<FName, TUniquePtr<FAtomicMetric>>& GetMetrics();
+	static std::atomic<uint64>& GetResetFrame();
+};
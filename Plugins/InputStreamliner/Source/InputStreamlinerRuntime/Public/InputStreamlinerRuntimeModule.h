@@ -4,9 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+#include "UObject/SoftObjectPath.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogInputStreamlinerRuntime, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("InputStreamliner"), STATGROUP_InputStreamliner, STATCAT_Advanced);
+
+class UInputAssetManifest;
+struct FStreamableHandle;
+
+/** Called once the generated assets are loaded; the manifest is null when there is none */
+DECLARE_DELEGATE_OneParam(FOnGeneratedInputAssetsLoaded, const UInputAssetManifest* /*Manifest*/);
+
 class FInputStreamlinerRuntimeModule : public IModuleInterface
 {
 public:
@@ -29,4 +39,39 @@ public:
 	{
 		return FModuleManager::Get().IsModuleLoaded("InputStreamlinerRuntime");
 	}
+
+	/**
+	 * Asynchronously load the generated asset manifest from the project settings, then every action and
+	 * mapping context it lists for this platform, in one streamable handle.
+	 * OnLoaded runs on the game thread when done, right away if the assets are already loaded.
+	 */
+	void PreloadGeneratedAssets(FOnGeneratedInputAssetsLoaded OnLoaded);
+
+	/** The loaded generated asset manifest, or null */
+	const UInputAssetManifest* GetGeneratedAssetManifest() const;
+
+private:
+	/** Request the assets listed in the manifest */
+	void HandleManifestLoaded();
+
+	/** Mark loading done and run the waiting callbacks */
+	void HandleGeneratedAssetsLoaded();
+
+	/** Keeps the manifest loaded */
+	TSharedPtr<FStreamableHandle> ManifestHandle;
+
+	/** Keeps the generated assets loaded */
+	TSharedPtr<FStreamableHandle> AssetsHandle;
+
+	/** Callbacks waiting for the load to finish */
+	TArray<FOnGeneratedInputAssetsLoaded> PendingCallbacks;
+
+	/** Manifest the current preload was requested for */
+	FSoftObjectPath RequestedManifestPath;
+
+	/** Time the preload was requested */
+	double PreloadStartTime = 0.0;
+
+	bool bPreloadRequested = false;
+	bool bGeneratedAssetsLoaded = false;
 };
@@ -0,0 +1,37 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "InputStreamlinerRuntimeSettings.generated.h"
+
+class UInputAssetManifest;
+
+/**
+ * Project settings for the Input Streamliner runtime (Project Settings > Plugins > Input Streamliner)
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Input Streamliner"))
+class INPUTSTREAMLINERRUNTIME_API UInputStreamlinerRuntimeSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UInputStreamlinerRuntimeSettings();
+
+	/** Manifest of the generated assets; set automatically by the generator */
+	UPROPERTY(config, EditAnywhere, Category = "Generated Assets")
+	TSoftObjectPtr<UInputAssetManifest> GeneratedAssetManifest;
+
+	/** Load this platform's generated assets asynchronously at startup and register them for rebinding */
+	UPROPERTY(config, EditAnywhere, Category = "Generated Assets")
+	bool bPreloadGeneratedAssets = true;
+
+	/** Use the generated mapping context for players that have none set */
+	UPROPERTY(config, EditAnywhere, Category = "Generated Assets", meta = (EditCondition = "bPreloadGeneratedAssets"))
+	bool bApplyGeneratedMappingContext = true;
+
+	/** Priority the generated mapping context is added with */
+	UPROPERTY(config, EditAnywhere, Category = "Generated Assets", meta = (EditCondition = "bPreloadGeneratedAssets && bApplyGeneratedMappingContext"))
+	int32 GeneratedMappingContextPriority = 0;
+};
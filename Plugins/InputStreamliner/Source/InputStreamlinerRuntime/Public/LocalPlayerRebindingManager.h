@@ -0,0 +1,380 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "InputRebindingManager.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "EnhancedActionKeyMapping.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+#include "LocalPlayerRebindingManager.generated.h"
+
+class UEnhancedInputLocalPlayerSubsystem;
+class UInputMappingContext;
+
+/**
+ * Per-player rebinding state: current bindings, mapping context, save slot and rebinding flow.
+ * Default bindings are shared through UInputRebindingManager, so each local player only
+ * stores and rebuilds its own changes.
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINERRUNTIME_API ULocalPlayerRebindingManager : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	// Rebinding Flow
+
+	/** Start listening for a new key binding for an action */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void StartRebinding(UInputAction* Action);
+
+	/** Cancel the current rebinding operation */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void CancelRebinding();
+
+	/** Check if currently waiting for a key press */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	bool IsRebindingInProgress() const { return PendingRebindAction != nullptr; }
+
+	/** Get the action currently being rebound */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	UInputAction* GetPendingRebindAction() const { return PendingRebindAction; }
+
+	// Binding Management
+
+	/** Get current bindings for an action */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	TArray<FKey> GetBindingsForAction(UInputAction* Action) const;
+
+	/** Apply a new binding to an action */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	bool ApplyBinding(UInputAction* Action, FKey NewKey, int32 BindingIndex = 0);
+
+	/** Remove a binding from an action */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	bool RemoveBinding(UInputAction* Action, int32 BindingIndex);
+
+	/** Check for binding conflicts */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	bool HasConflict(UInputAction* Action, FKey Key, UInputAction*& OutConflictingAction) const;
+
+	/** Get every key bound to more than one action in this player's mapping context */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	TArray<FInputBindingConflict> GetAllConflicts() const;
+
+	/** Get the actions currently bound to a key */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	TArray<UInputAction*> GetActionsForKey(FKey Key) const;
+
+	/** Swap bindings between two actions (for conflict resolution) */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void SwapBindings(UInputAction* ActionA, UInputAction* ActionB, FKey Key);
+
+	/** Reset an action to its default binding */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void ResetToDefault(UInputAction* Action);
+
+	/** Reset all actions to default bindings */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void ResetAllToDefaults();
+
+	// Binding Profiles
+
+	/**
+	 * Switch to a profile registered on UInputRebindingManager in a single mapping rebuild, without conflict checks.
+	 * With bOnlyChanged, actions whose keys already match are left untouched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Profiles")
+	bool ApplyBindingProfile(FName ProfileName, bool bOnlyChanged = true);
+
+	/** Get the profile last switched to (None after a manual change) */
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Profiles")
+	FName GetActiveBindingProfile() const { return ActiveBindingProfile; }
+
+	// Sensitivity Settings
+
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
+	void SetMouseSensitivity(float Sensitivity);
+
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
+	float GetMouseSensitivity() const { return SaveData.MouseSensitivity; }
+
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
+	void SetGamepadSensitivity(float Sensitivity);
+
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
+	float GetGamepadSensitivity() const { return SaveData.GamepadSensitivity; }
+
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
+	void SetGyroSensitivity(float Sensitivity);
+
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
+	float GetGyroSensitivity() const { return SaveData.GyroSensitivity; }
+
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
+	void SetInvertY(bool bInvert);
+
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
+	bool GetInvertY() const { return SaveData.bInvertY; }
+
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Sensitivity")
+	void SetGyroEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Sensitivity")
+	bool GetGyroEnabled() const { return SaveData.bGyroEnabled; }
+
+	// Persistence
+
+	/**
+	 * Save bindings to local storage. The file is written on a background task
+	 * and skipped when nothing changed since the last write.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Persistence")
+	bool SaveBindings();
+
+	/** Write the current bindings as JSON for debugging (defaults to a BindingsDebug file next to the save slot) */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Persistence")
+	bool ExportBindingsToJson(const FString& FilePath = TEXT(""));
+
+	/** Load bindings from local storage */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding|Persistence")
+	bool LoadBindings();
+
+	/** Get the save slot name; the first local player keeps the original slot */
+	UFUNCTION(BlueprintPure, Category = "Rebinding|Persistence")
+	FString GetSaveSlotName() const;
+
+	/** Called by UInputRebindingManager when actions are registered */
+	void HandleActionsRegistered(TConstArrayView<UInputAction*> Actions);
+
+	// Events
+
+	/** Called when rebinding completes successfully */
+	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
+	FOnRebindComplete OnRebindComplete;
+
+	/** Called when any key is pressed during rebinding (for UI feedback) */
+	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
+	FOnAnyKeyPressed OnAnyKeyPressed;
+
+	/** Called when a binding conflict is detected */
+	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
+	FOnBindingConflict OnBindingConflict;
+
+	/** Called once per profile switch with every action whose bindings changed */
+	UPROPERTY(BlueprintAssignable, Category = "Rebinding|Events")
+	FOnBindingProfileApplied OnBindingProfileApplied;
+
+	/** Called when the bindings of one action change; only that action's listeners are notified */
+	FOnActionBindingsChanged& OnActionBindingsChanged(const UInputAction* Action) { return ActionBindingsChangedDelegates.FindOrAdd(FObjectKey(Action)); }
+
+	/**
+	 * Set the mapping context for this player. A transient copy is added at the given priority and edited by rebinding;
+	 * if the asset itself is already applied, the copy replaces it at its priority. Passing the same context again only moves it to the new priority.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void SetMappingContext(UInputMappingContext* Context, int32 Priority = 0);
+
+	/** Get this player's copy of the mapping context, the one applied to the player */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	UInputMappingContext* GetMappingContext() const { return ActiveMappingContext; }
+
+	/** Get the mapping context asset the player's copy was made from */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	UInputMappingContext* GetSourceMappingContext() const { return SourceMappingContext; }
+
+	/** Get the priority the mapping context is added with */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	int32 GetMappingContextPriority() const { return MappingContextPriority; }
+
+	/**
+	 * Rebuild player input mappings now if any binding changed.
+	 * Changes are otherwise batched and applied once at the end of the frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void FlushPendingMappingChanges();
+
+	/** Check if binding changes are waiting for the end-of-frame rebuild */
+	UFUNCTION(BlueprintPure, Category = "Rebinding")
+	bool HasPendingMappingChanges() const { return DirtyActions.Num() > 0 || bMappingContextPendingAdd; }
+
+	// Allow input processor to access private members
+	friend class FRebindInputProcessor;
+
+private:
+	/** Handle key input during rebinding */
+	bool HandleKeyDown(const FKeyEvent& KeyEvent);
+
+	/** Handle gamepad input during rebinding */
+	bool HandleAnalogInput(const FAnalogInputEvent& AnalogEvent);
+
+	/** Refresh SaveData.Bindings from the current bindings */
+	void UpdateSaveData();
+
+	/** Rebuild SavedBindingIndexByName from SaveData.Bindings */
+	void RebuildSavedBindingIndex();
+
+	/** Take saved (or default) bindings for a registered action and queue its mappings */
+	void InitializeActionBindings(UInputAction* Action);
+
+	/** Get the shared default bindings for an action */
+	const TArray<FKey>* FindDefaultBindings(UInputAction* Action) const;
+
+	/** Get the bindings file for this player */
+	FString GetBindingsFilePath() const;
+
+	/** Block until the background save, if any, has finished */
+	void WaitForPendingSave();
+
+	/** Apply loaded bindings to the input system */
+	void ApplyLoadedBindings();
+
+	/** Build the (action, binding index) to mapping slot table for the active context */
+	void BuildMappingSlots();
+
+	/** Set the key of one binding's mapping in place and queue a rebuild */
+	void SetMappingKey(UInputAction* Action, int32 BindingIndex, const FKey& NewKey);
+
+	/** Make an action's mappings match its current bindings */
+	void SyncActionMappings(UInputAction* Action);
+
+	/** Drop mappings removed since the last flush and renumber the slot table */
+	void CompactMappings();
+
+	/** End-of-frame hook that flushes batched mapping changes */
+	void HandleEndFrame();
+
+	/** Replace an action's current bindings, keeping the key index in sync */
+	void SetCurrentBindings(UInputAction* Action, const TArray<FKey>& Keys);
+
+	/** Remove an action's current bindings, keeping the key index in sync */
+	void ClearCurrentBindings(UInputAction* Action);
+
+	/** Record that an action is bound to a key */
+	void AddKeyToIndex(UInputAction* Action, const FKey& Key);
+
+	/** Remove one binding of an action to a key */
+	void RemoveKeyFromIndex(UInputAction* Action, const FKey& Key);
+
+	/** Rebuild the key index from CurrentBindings */
+	void RebuildKeyIndex();
+
+	/** Get the Enhanced Input subsystem of this player */
+	UEnhancedInputLocalPlayerSubsystem* GetEnhancedInputSubsystem() const;
+
+	/** Check if a Slate input event came from this player */
+	bool IsEventFromPlayer(uint32 SlateUserIndex) const;
+
+	/** Broadcast a captured key on this player and on the shared manager */
+	void NotifyAnyKeyPressed(const FKey& Key);
+
+	/** Notify the listeners of one action that its bindings changed */
+	void NotifyActionBindingsChanged(UInputAction* Action);
+
+	/** Per-action binding change listeners */
+	TMap<FObjectKey, FOnActionBindingsChanged> ActionBindingsChangedDelegates;
+
+	/** Shared registration data */
+	UPROPERTY(Transient)
+	TObjectPtr<UInputRebindingManager> SharedManager;
+
+	/** The action currently being rebound */
+	UPROPERTY(Transient)
+	TObjectPtr<UInputAction> PendingRebindAction;
+
+	/** Index of the binding being changed */
+	int32 PendingBindingIndex = 0;
+
+	/** Profile last switched to, cleared by manual binding changes */
+	FName ActiveBindingProfile;
+
+	/** Current custom bindings (not UPROPERTY - TMap<TArray> not supported) */
+	TMap<TObjectPtr<UInputAction>, TArray<FKey>> CurrentBindings;
+
+	/** Reverse of CurrentBindings: actions bound to each key (once per binding) */
+	TMap<FKey, TArray<TObjectPtr<UInputAction>>> ActionsByKey;
+
+	/** Save data */
+	UPROPERTY(Transient)
+	FInputBindingSaveData SaveData;
+
+	/** Index into SaveData.Bindings by action name */
+	TMap<FName, int32> SavedBindingIndexByName;
+
+	/** The mapping context asset passed to SetMappingContext; never modified */
+	UPROPERTY(Transient)
+	TObjectPtr<UInputMappingContext> SourceMappingContext;
+
+	/** This player's transient copy of the source context, the one rebinding modifies */
+	UPROPERTY(Transient)
+	TObjectPtr<UInputMappingContext> ActiveMappingContext;
+
+	/** True until the copy has been added to the player's Enhanced Input subsystem */
+	bool bMappingContextPendingAdd = false;
+
+	/** Priority used when the manager adds the mapping context itself */
+	int32 MappingContextPriority = 0;
+
+	/** Mapping slot of each of an action's bindings in the active context (INDEX_NONE if unmapped) */
+	TMap<TObjectPtr<const UInputAction>, TArray<int32>> MappingSlotsByAction;
+
+	/** The context's mappings as the copy was made, so compacted bindings come back with their modifiers and triggers */
+	UPROPERTY(Transient)
+	TArray<FEnhancedActionKeyMapping> MappingTemplates;
+
+	/** Index into MappingTemplates of each of an action's bindings */
+	TMap<TObjectPtr<const UInputAction>, TArray<int32>> MappingTemplateSlotsByAction;
+
+	/** Number of mappings whose key was cleared since the last compaction */
+	int32 NumDeadMappings = 0;
+
+	/** Actions whose mappings changed since the last rebuild */
+	TSet<TObjectPtr<UInputAction>> DirtyActions;
+
+	/** Handle for the end-of-frame flush */
+	FDelegateHandle EndFrameHandle;
+
+	/** Background write of the bindings file */
+	UE::Tasks::FTask PendingSaveTask;
+
+	/** CRC of the bindings file as last read or written */
+	uint32 LastSavedCrc = 0;
+	bool bHasLastSavedCrc = false;
+
+	/** Set by the background write when it fails, so the next save retries */
+	std::atomic<bool> bLastSaveFailed = false;
+
+	/** Input processor for capturing rebind keys */
+	TSharedPtr<class FRebindInputProcessor> RebindInputProcessor;
+};
+
+/**
+ * Input processor that captures key presses during rebinding
+ */
+class FRebindInputProcessor : public IInputProcessor
+{
+public:
+	FRebindInputProcessor(ULocalPlayerRebindingManager* InManager) : Manager(InManager) {}
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override { return false; }
+	virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override;
+	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return false; }
+	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+	virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override { return false; }
+	virtual bool HandleMouseWheelOrGestureEvent(FSlateApplication& SlateApp, const FPointerEvent& InWheelEvent, const FPointerEvent* InGestureEvent) override;
+
+private:
+	TWeakObjectPtr<ULocalPlayerRebindingManager> Manager;
+};
@@ -4,7 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
-#include "InputRebindingManager.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "LocalPlayerRebindingManager.h"
 #include "RebindingSettingsWidget.generated.h"
 
 class UVerticalBox;
@@ -13,20 +14,51 @@ class UTextBlock;
 class USlider;
 class UCheckBox;
 class UScrollBox;
+class UListView;
 class UInputAction;
 
 /**
- * Individual row for displaying and rebinding a single action
+ * List item for one action in the rebinding list; the display name is computed once
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINERRUNTIME_API URebindActionListItem : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Build the display name of an action ("IA_JumpHigh" -> "Jump High") */
+	static FText MakeDisplayName(const UInputAction* Action);
+
+	/** The action this item represents */
+	UPROPERTY(BlueprintReadOnly, Category = "Rebinding")
+	TObjectPtr<UInputAction> Action;
+
+	/** Cached display name */
+	UPROPERTY(BlueprintReadOnly, Category = "Rebinding")
+	FText DisplayName;
+
+	/** Rebinding state the row edits */
+	UPROPERTY(BlueprintReadOnly, Category = "Rebinding")
+	TObjectPtr<ULocalPlayerRebindingManager> RebindingManager;
+};
+
+/**
+ * Individual row for displaying and rebinding a single action.
+ * Can be used as a UListView entry, in which case rows are recycled between actions.
  */
 UCLASS()
-class INPUTSTREAMLINERRUNTIME_API URebindActionRow : public UUserWidget
+class INPUTSTREAMLINERRUNTIME_API URebindActionRow : public UUserWidget, public IUserObjectListEntry
 {
 	GENERATED_BODY()
 
 public:
 	/** Initialize this row with an action */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
-	void SetupAction(UInputAction* InAction, UInputRebindingManager* InManager);
+	void SetupAction(UInputAction* InAction, ULocalPlayerRebindingManager* InManager);
+
+	/** Initialize this row from a list item, reusing its cached display name */
+	UFUNCTION(BlueprintCallable, Category = "Rebinding")
+	void SetupItem(URebindActionListItem* Item);
 
 	/** Update the displayed key text */
 	UFUNCTION(BlueprintCallable, Category = "Rebinding")
@@ -38,6 +70,11 @@ public:
 
 protected:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+
+	//~ Begin IUserObjectListEntry Interface
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+	//~ End IUserObjectListEntry Interface
 
 	UFUNCTION()
 	void OnRebindClicked();
@@ -45,16 +82,13 @@ protected:
 	UFUNCTION()
 	void OnResetClicked();
 
-	UFUNCTION()
-	void OnRebindComplete(UInputAction* Action, FKey NewKey);
-
 	/** The action this row represents */
 	UPROPERTY(BlueprintReadOnly, Category = "Rebinding")
 	TObjectPtr<UInputAction> Action;
 
 	/** Reference to the rebinding manager */
 	UPROPERTY()
-	TObjectPtr<UInputRebindingManager> RebindingManager;
+	TObjectPtr<ULocalPlayerRebindingManager> RebindingManager;
 
 	/** Action name text */
 	UPROPERTY(meta = (BindWidgetOptional))
@@ -80,6 +114,18 @@ private:
 	/** Programmatically created widgets (when not using Blueprint) */
 	void CreateWidgets();
 
+	/** Point this row at an action and listen for that action's binding changes */
+	void SetupRow(UInputAction* InAction, ULocalPlayerRebindingManager* InManager, const FText& DisplayName);
+
+	/** Called when the bindings of this row's action change */
+	void HandleBindingsChanged(UInputAction* ChangedAction);
+
+	/** Stop listening to the current action */
+	void UnbindFromManager();
+
+	/** Handle for the per-action binding change listener */
+	FDelegateHandle BindingsChangedHandle;
+
 	bool bWidgetsCreated = false;
 };
 
@@ -134,6 +180,9 @@ protected:
 	UFUNCTION()
 	void OnBindingConflict(UInputAction* ExistingAction, FKey ConflictingKey);
 
+	UFUNCTION()
+	void OnBindingProfileApplied(FName ProfileName, const TArray<UInputAction*>& ChangedActions);
+
 	UFUNCTION()
 	void OnMouseSensitivityChanged(float Value);
 
@@ -160,6 +209,10 @@ protected:
 	UPROPERTY(meta = (BindWidgetOptional))
 	TObjectPtr<UVerticalBox> ActionsContainer;
 
+	/** List of action rows; entries are pooled and recycled as the list scrolls (used instead of ActionsContainer) */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UListView> ActionsListView;
+
 	/** Mouse sensitivity slider */
 	UPROPERTY(meta = (BindWidgetOptional))
 	TObjectPtr<USlider> MouseSensitivitySlider;
@@ -200,26 +253,47 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Rebinding")
 	TSubclassOf<URebindActionRow> ActionRowClass;
 
+	/** Build the generated layout with a pooled list view instead of one widget per action */
+	UPROPERTY(EditDefaultsOnly, Category = "Rebinding")
+	bool bUseListView = true;
+
 private:
 	/** Create all widgets programmatically */
 	void CreateWidgets();
 
-	/** Create a single action row */
-	URebindActionRow* CreateActionRow(UInputAction* Action);
+	/** Create the list item for an action and show it */
+	void AddActionItem(UInputAction* Action);
+
+	/** Create a single action row (when not using the list view) */
+	URebindActionRow* CreateActionRow(URebindActionListItem* Item);
+
+	/** Find the row currently showing an action, if any */
+	URebindActionRow* FindActionRow(UInputAction* Action) const;
 
 	/** Update status text */
 	void SetStatus(const FString& Message);
 
-	/** Get the rebinding manager */
-	UInputRebindingManager* GetRebindingManager() const;
+	/** Get the rebinding state of the owning player */
+	ULocalPlayerRebindingManager* GetRebindingManager() const;
+
+	/** Get the manager that holds the registered actions */
+	UInputRebindingManager* GetSharedRebindingManager() const;
+
+	/** List items of the registered actions, in registration order */
+	UPROPERTY()
+	TArray<TObjectPtr<URebindActionListItem>> ActionItems;
+
+	/** Map of actions to their list items */
+	UPROPERTY()
+	TMap<TObjectPtr<UInputAction>, TObjectPtr<URebindActionListItem>> ActionItemsByAction;
 
-	/** Map of actions to their row widgets */
+	/** Map of actions to their row widgets (when not using the list view) */
 	UPROPERTY()
 	TMap<TObjectPtr<UInputAction>, TObjectPtr<URebindActionRow>> ActionRows;
 
 	/** Cached reference to rebinding manager */
 	UPROPERTY()
-	TObjectPtr<UInputRebindingManager> CachedManager;
+	TObjectPtr<ULocalPlayerRebindingManager> CachedManager;
 
 	/** Currently rebinding action (for UI feedback) */
 	UPROPERTY()
@@ -0,0 +1,230 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "InputCoreTypes.h"
+#include "InputAction.h"
+#include "TouchControlRouter.generated.h"
+
+class UEnhancedInputLocalPlayerSubsystem;
+
+/**
+ * Touch controls handled by the router
+ */
+UENUM(BlueprintType)
+enum class ETouchRouterControlType : uint8
+{
+	Joystick			UMETA(DisplayName = "Virtual Joystick (Fixed)"),
+	FloatingJoystick	UMETA(DisplayName = "Virtual Joystick (Floating)"),
+	Button				UMETA(DisplayName = "Virtual Button"),
+	DPad				UMETA(DisplayName = "Virtual D-Pad"),
+	TouchRegion			UMETA(DisplayName = "Touch Region"),
+	GestureZone			UMETA(DisplayName = "Gesture Zone")
+};
+
+/**
+ * Gesture recognized by a gesture zone
+ */
+UENUM(BlueprintType)
+enum class ETouchRouterGesture : uint8
+{
+	Tap				UMETA(DisplayName = "Tap"),
+	LongPress		UMETA(DisplayName = "Long Press"),
+	Swipe			UMETA(DisplayName = "Swipe (4 Directions)")
+};
+
+/**
+ * Layout of a touch control, in the same normalized space as FTouchControlDefinition
+ */
+USTRUCT(BlueprintType)
+struct INPUTSTREAMLINERRUNTIME_API FTouchControlLayout
+{
+	GENERATED_BODY()
+
+	/** Unique identifier for this control */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Control")
+	FName ControlName;
+
+	/** Type of touch control */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Control")
+	ETouchRouterControlType ControlType = ETouchRouterControlType::Joystick;
+
+	/** Center of the control (0-1 normalized, origin bottom-left) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	FVector2D ScreenPosition = FVector2D(0.15f, 0.3f);
+
+	/** Size (0-1 normalized relative to screen) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Layout", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	FVector2D Size = FVector2D(0.2f, 0.2f);
+
+	/** The input action this control drives */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Control")
+	TObjectPtr<UInputAction> Action;
+
+	/** Dead zone for joystick and d-pad input (0-1) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Joystick", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float DeadZone = 0.15f;
+
+	/** Whether the joystick returns to center when released */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Joystick")
+	bool bAutoCenter = true;
+
+	/** Gesture a gesture zone reports */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gesture")
+	ETouchRouterGesture Gesture = ETouchRouterGesture::Tap;
+
+	/** Minimum swipe distance in pixels; shorter movements still count as taps and long presses */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gesture", meta = (ClampMin = "10.0", ClampMax = "200.0"))
+	float SwipeThreshold = 50.0f;
+
+	/** Long press duration in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gesture", meta = (ClampMin = "0.1", ClampMax = "2.0"))
+	float LongPressDuration = 0.5f;
+};
+
+/**
+ * Routes every touch on the game viewport to on-screen controls from one place.
+ * Touches are hit-tested once against a flat array of control rectangles and update compact
+ * per-control state, so UMG widgets only draw the controls (GetControlValue/IsControlActive)
+ * instead of each handling and capturing touch events.
+ * Values are injected into Enhanced Input at most once per frame per control.
+ */
+UCLASS(BlueprintType)
+class INPUTSTREAMLINERRUNTIME_API UTouchControlRouter : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	/** Replace the routed controls; routing starts with the first control and stops when cleared */
+	UFUNCTION(BlueprintCallable, Category = "Touch")
+	void SetControls(const TArray<FTouchControlLayout>& InControls);
+
+	/** Remove every control and stop routing touches */
+	UFUNCTION(BlueprintCallable, Category = "Touch")
+	void ClearControls();
+
+	/** Get the routed controls */
+	UFUNCTION(BlueprintPure, Category = "Touch")
+	const TArray<FTouchControlLayout>& GetControls() const { return Controls; }
+
+	/** Get the current output of a control (normalized -1 to 1 per axis for sticks) */
+	UFUNCTION(BlueprintPure, Category = "Touch")
+	FVector2D GetControlValue(FName ControlName) const;
+
+	/** Check if a finger is on a control */
+	UFUNCTION(BlueprintPure, Category = "Touch")
+	bool IsControlActive(FName ControlName) const;
+
+	friend class FTouchControlInputProcessor;
+
+private:
+	/** Per-control runtime state, kept apart from the layout so the routing loop stays small */
+	struct FControlState
+	{
+		/** Joystick center or touch start, in viewport pixels */
+		FVector2f Origin = FVector2f::ZeroVector;
+
+		/** Latest touch position, in viewport pixels */
+		FVector2f Position = FVector2f::ZeroVector;
+
+		/** Output value */
+		FVector2f Value = FVector2f::ZeroVector;
+
+		/** Time the current touch started */
+		double PressTime = 0.0;
+
+		/** Frame of the last injection */
+		uint64 LastInjectionFrame = MAX_uint64;
+
+		/** Time of the first touch event since the last injection, or 0 */
+		double PendingTouchTime = 0.0;
+
+		/** Touch controlling this control */
+		int32 PointerIndex = INDEX_NONE;
+
+		/** Value is a one-shot output (tap, swipe, region delta) still to be injected */
+		bool bPendingPulse = false;
+	};
+
+	/** Handle touch events from the input processor; return true to consume */
+	bool HandleTouchStarted(const FPointerEvent& TouchEvent);
+	bool HandleTouchMoved(const FPointerEvent& TouchEvent);
+	bool HandleTouchEnded(const FPointerEvent& TouchEvent);
+
+	/** Check if a touch came from this router's player; with several local players only its own user's touches count */
+	bool IsEventFromPlayer(const FPointerEvent& TouchEvent) const;
+
+	/** Convert a touch to viewport pixels and normalized viewport space (origin top-left), updating ViewportSize */
+	bool ToViewportSpace(const FPointerEvent& TouchEvent, FVector2f& OutPixels, FVector2f& OutNormalized);
+
+	/** Find the topmost free control under a normalized viewport position */
+	int32 HitTest(const FVector2f& NormalizedPosition) const;
+
+	/** Recompute a control's output from its touch */
+	void UpdateControlValue(int32 ControlIndex);
+
+	/** Inject a control's value if it has one and was not injected this frame */
+	void InjectControl(int32 ControlIndex);
+
+	/** Keep held controls injecting and detect long presses */
+	void HandleEndFrame();
+
+	/** Register or unregister the input processor and end-of-frame handler */
+	void StartRouting();
+	void StopRouting();
+
+	/** Get the owning player's Enhanced Input subsystem */
+	UEnhancedInputLocalPlayerSubsystem* GetInputSubsystem();
+
+	/** Routed control layouts */
+	UPROPERTY(Transient)
+	TArray<FTouchControlLayout> Controls;
+
+	/** Control rectangles in normalized viewport space (origin top-left), parallel to Controls */
+	TArray<FBox2f> HitRects;
+
+	/** Control state, parallel to Controls */
+	TArray<FControlState> States;
+
+	/** Viewport size in pixels at the last touch */
+	FVector2f ViewportSize = FVector2f::UnitVector;
+
+	/** Control owning each touch, or INDEX_NONE */
+	int32 ControlByPointer[EKeys::NUM_TOUCH_KEYS];
+
+	/** Enhanced Input subsystem of the owning player */
+	TWeakObjectPtr<UEnhancedInputLocalPlayerSubsystem> CachedInputSubsystem;
+
+	/** Handle for the end-of-frame injection pass */
+	FDelegateHandle EndFrameHandle;
+
+	/** Input processor receiving touch events */
+	TSharedPtr<class FTouchControlInputProcessor> TouchInputProcessor;
+};
+
+/**
+ * Input processor that hands touch events to the router before any widget sees them
+ */
+class FTouchControlInputProcessor : public IInputProcessor
+{
+public:
+	FTouchControlInputProcessor(UTouchControlRouter* InRouter) : Router(InRouter) {}
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+
+	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+	virtual bool HandleMouseButtonUpEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+
+	virtual const TCHAR* GetDebugName() const override { return TEXT("TouchControlRouter"); }
+
+private:
+	TWeakObjectPtr<UTouchControlRouter> Router;
+};
@@ -7,6 +7,8 @@
 #include "InputAction.h"
 #include "VirtualJoystickWidget.generated.h"
 
+class UEnhancedInputLocalPlayerSubsystem;
+
 /**
  * Virtual joystick widget for touch-based movement input
  * Can be configured as fixed position or floating (appears where touched)
@@ -55,6 +57,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
 	TObjectPtr<UInputAction> LinkedAction;
 
+	/**
+	 * Inject the latest touch sample from the world's OnWorldTickStart, after Slate has processed this frame's touches
+	 * and before player input runs, instead of in the widget tick, so the action sees it a frame sooner.
+	 * Touch events only record the value; either way it is injected at most once per frame.
+	 * Formerly bInjectOnTouchMove; the plugin config redirects the old name.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input")
+	bool bInjectAtWorldTickStart = false;
+
 	// State (read-only)
 
 	/** Current joystick output value (normalized -1 to 1 per axis) */
@@ -89,8 +100,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Joystick")
 	FVector2D GetValueWithDeadZone() const;
 
+	/** Set the Input Action this joystick controls */
+	UFUNCTION(BlueprintCallable, Category = "Input")
+	void SetLinkedAction(UInputAction* Action);
+
 protected:
 	// UUserWidget interface
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 	virtual FReply NativeOnTouchStarted(const FGeometry& InGeometry, const FPointerEvent& InGestureEvent) override;
 	virtual FReply NativeOnTouchMoved(const FGeometry& InGeometry, const FPointerEvent& InGestureEvent) override;
 	virtual FReply NativeOnTouchEnded(const FGeometry& InGeometry, const FPointerEvent& InGestureEvent) override;
@@ -100,9 +117,33 @@ private:
 	/** Update joystick position based on touch location */
 	void UpdateJoystickPosition(const FVector2D& TouchPosition, const FGeometry& Geometry);
 
-	/** Inject the input value into the Enhanced Input system */
+	/** Inject the input value into the Enhanced Input system, at most once per frame */
 	void InjectInputValue(const FVector2D& Value);
 
+	/** World tick start hook that injects the touch sample recorded this frame */
+	void HandleWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** Get the owning player's Enhanced Input subsystem, resolving it only when the cache is stale */
+	UEnhancedInputLocalPlayerSubsystem* GetInputSubsystem();
+
+	/** Resolve the owning player's Enhanced Input subsystem */
+	void RefreshInputSubsystem();
+
+	/** Enhanced Input subsystem of the owning player */
+	TWeakObjectPtr<UEnhancedInputLocalPlayerSubsystem> CachedInputSubsystem;
+
+	/** Frame of the last injection, so the world tick hook and the widget tick inject at most once per frame */
+	uint64 LastInjectionFrame = MAX_uint64;
+
+	/** A touch move has been recorded since the last injection */
+	bool bTouchSamplePending = false;
+
+	/** Handle for the world tick start hook */
+	FDelegateHandle WorldTickStartHandle;
+
+	/** Time of the first touch event since the last injection, or 0 */
+	double PendingTouchTime = 0.0;
+
 	/** The center position of the joystick (for floating mode) */
 	FVector2D CenterPosition;
 
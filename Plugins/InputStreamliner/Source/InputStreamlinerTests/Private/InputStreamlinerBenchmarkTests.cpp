@@ -0,0 +1,505 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputStreamlinerConfiguration.h"
+#include "InputAssetGenerator.h"
+#include "LLMIntentParser.h"
+#include "LocalPlayerRebindingManager.h"
+#include "VirtualJoystickWidget.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Blueprint/UserWidget.h"
+#include "Editor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Input/Events.h"
+#include "Layout/Geometry.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Widgets/SWidget.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Timings of the parser, generator, rebinding and virtual joystick hot paths.
+ * Run from the Session Frontend or with "Automation RunTests InputStreamliner.Benchmark".
+ * Each case checks its output, fails if its average exceeds its regression threshold, and appends a row to
+ * Saved/InputStreamliner/Benchmarks/Benchmark-<date>.csv. Nothing is written to content or saved bindings.
+ */
+static TAutoConsoleVariable<float> CVarBenchmarkThresholdScale(
+	TEXT("InputStreamliner.BenchmarkThresholdScale"),
+	1.0f,
+	TEXT("Multiplier applied to every Input Streamliner benchmark threshold, for slower machines."));
+
+namespace InputStreamlinerBenchmark
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter;
+
+	/** Regression threshold for the average of a case at a scale, in ms */
+	struct FThreshold
+	{
+		const TCHAR* Case;
+		int32 Scale;
+		double Milliseconds;
+	};
+
+	const FThreshold Thresholds[] =
+	{
+		{ TEXT("ParseJSONResponse"), 10, 1.0 },
+		{ TEXT("ParseJSONResponse"), 100, 5.0 },
+		{ TEXT("ParseJSONResponse"), 1000, 50.0 },
+		{ TEXT("GenerateInputAssets"), 10, 50.0 },
+		{ TEXT("GenerateInputAssets"), 100, 300.0 },
+		{ TEXT("GenerateInputAssets"), 1000, 3000.0 },
+		{ TEXT("HasConflict"), 500, 1.0 },
+		{ TEXT("ApplyBinding"), 500, 20.0 },
+		{ TEXT("SetMappingContext"), 500, 20.0 },
+		{ TEXT("TouchMoved"), 1000, 2.0 },
+		{ TEXT("GetValueWithDeadZone"), 1000, 3.0 },
+	};
+
+	/** Action scales for the parser and generator suites */
+	const int32 ConfigurationScales[] = { 10, 100, 1000 };
+
+	/** Registered actions in the rebinding suite */
+	constexpr int32 RebindingActions = 500;
+
+	/** Touch events per joystick iteration */
+	constexpr int32 JoystickEvents = 1000;
+
+	/** Object root of the generator suite's in-memory assets */
+	const TCHAR* GeneratorRoot = TEXT("/Temp/InputStreamlinerBenchmark");
+
+	/** List the configuration scales as test variants */
+	void GetScaleTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands)
+	{
+		for (const int32 Scale : ConfigurationScales)
+		{
+			OutBeautifiedNames.Add(FString::Printf(TEXT("%d Actions"), Scale));
+			OutTestCommands.Add(FString::FromInt(Scale));
+		}
+	}
+
+	/** Scaled threshold of a case, or 0 if it has none */
+	double FindThreshold(const TCHAR* Case, int32 Scale)
+	{
+		for (const FThreshold& Threshold : Thresholds)
+		{
+			if (Threshold.Scale == Scale && FCString::Strcmp(Threshold.Case, Case) == 0)
+			{
+				return Threshold.Milliseconds * CVarBenchmarkThresholdScale.GetValueOnGameThread();
+			}
+		}
+		return 0.0;
+	}
+
+	/** CSV file shared by every benchmark run in this editor session */
+	const FString& GetCsvPath()
+	{
+		static const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("InputStreamliner") / TEXT("Benchmarks")
+			/ FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString());
+		return CsvPath;
+	}
+
+	/** Append one case to the session CSV, writing the header first if the file is new */
+	void AppendCsvRow(FAutomationTestBase& Test, const TCHAR* Case, int32 Scale, int32 Iterations, double AverageMs, double MinMs, double MaxMs, double ThresholdMs, const TCHAR* Result)
+	{
+		const FString& CsvPath = GetCsvPath();
+
+		TStringBuilder<512> Row;
+		if (!IFileManager::Get().FileExists(*CsvPath))
+		{
+			IFileManager::Get().MakeDirectory(*FPaths::GetPath(CsvPath), true);
+			Row << TEXT("Case,Scale,Iterations,AverageMs,MinMs,MaxMs,ThresholdMs,Result\n");
+		}
+		Row.Appendf(TEXT("%s,%d,%d,%.4f,%.4f,%.4f,%.4f,%s\n"), Case, Scale, Iterations, AverageMs, MinMs, MaxMs, ThresholdMs, Result);
+
+		if (!FFileHelper::SaveStringToFile(Row.ToView(), *CsvPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			Test.AddWarning(FString::Printf(TEXT("Failed to write benchmark results to: %s"), *CsvPath));
+		}
+	}
+
+	/**
+	 * Time Body over Iterations runs after one warm-up run, append the timings to the session CSV,
+	 * and fail if the average exceeds the case's threshold. The warm-up run fills caches and lazily
+	 * created tables; every run must return true.
+	 */
+	bool Measure(FAutomationTestBase& Test, const TCHAR* Case, int32 Scale, int32 Iterations, TFunctionRef<bool()> Body)
+	{
+		const double ThresholdMs = FindThreshold(Case, Scale);
+		if (ThresholdMs <= 0.0)
+		{
+			Test.AddError(FString::Printf(TEXT("%s (%d) has no regression threshold"), Case, Scale));
+			return false;
+		}
+
+		if (!Body())
+		{
+			Test.AddError(FString::Printf(TEXT("%s (%d) produced the wrong output"), Case, Scale));
+			AppendCsvRow(Test, Case, Scale, 0, 0.0, 0.0, 0.0, ThresholdMs, TEXT("Failed"));
+			return false;
+		}
+
+		double TotalMs = 0.0;
+		double MinMs = TNumericLimits<double>::Max();
+		double MaxMs = 0.0;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			const bool bCorrect = Body();
+			const double Milliseconds = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+			if (!bCorrect)
+			{
+				Test.AddError(FString::Printf(TEXT("%s (%d) produced the wrong output on run %d"), Case, Scale, Iteration + 1));
+				AppendCsvRow(Test, Case, Scale, Iteration + 1, 0.0, 0.0, 0.0, ThresholdMs, TEXT("Failed"));
+				return false;
+			}
+
+			TotalMs += Milliseconds;
+			MinMs = FMath::Min(MinMs, Milliseconds);
+			MaxMs = FMath::Max(MaxMs, Milliseconds);
+		}
+
+		const double AverageMs = Iterations > 0 ? TotalMs / Iterations : 0.0;
+		MinMs = FMath::Min(MinMs, MaxMs);
+		const bool bRegressed = AverageMs > ThresholdMs;
+		AppendCsvRow(Test, Case, Scale, Iterations, AverageMs, MinMs, MaxMs, ThresholdMs, bRegressed ? TEXT("Regressed") : TEXT("Passed"));
+
+		const FString Summary = FString::Printf(TEXT("%s (%d): %.3f ms average, %.3f ms min, %.3f ms max over %d runs, limit %.3f ms"),
+			Case, Scale, AverageMs, MinMs, MaxMs, Iterations, ThresholdMs);
+		if (bRegressed)
+		{
+			Test.AddError(Summary);
+			return false;
+		}
+
+		Test.AddInfo(Summary);
+		return true;
+	}
+
+	/** An LLM response in the few-shot format with NumActions actions, fenced and wrapped in prose */
+	FString BuildRecordedResponse(int32 NumActions)
+	{
+		// Alternates the two action shapes of the first few-shot example, as models return them
+		TStringBuilder<65536> Response;
+		Response << TEXT("Here is the input configuration for your game:\n\n```json\n{\"actions\":[");
+		for (int32 i = 0; i < NumActions; i++)
+		{
+			if (i > 0)
+			{
+				Response << TEXT(",");
+			}
+
+			if (i % 2 == 0)
+			{
+				Response.Appendf(TEXT("{\"name\":\"Move%d\",\"displayName\":\"Move %d\",\"type\":\"Axis2D\",\"category\":\"Movement\",\"allowRebinding\":true,\"bindings\":{\"PC_Keyboard\":[{\"key\":\"A\",\"axis\":\"-X\"},{\"key\":\"D\",\"axis\":\"+X\"}],\"PC_Gamepad\":[{\"key\":\"Gamepad_LeftStick\"}],\"iOS\":{\"touchControl\":\"VirtualJoystick_Fixed\"},\"Android\":{\"touchControl\":\"VirtualJoystick_Fixed\"}}}"), i, i);
+			}
+			else
+			{
+				Response.Appendf(TEXT("{\"name\":\"Jump%d\",\"displayName\":\"Jump %d\",\"type\":\"Bool\",\"category\":\"Movement\",\"allowRebinding\":true,\"bindings\":{\"PC_Keyboard\":[{\"key\":\"SpaceBar\"}],\"PC_Gamepad\":[{\"key\":\"Gamepad_FaceButton_Bottom\"}],\"iOS\":{\"touchControl\":\"VirtualButton\"},\"Android\":{\"touchControl\":\"VirtualButton\"}}}"), i, i);
+			}
+		}
+		Response << TEXT("]}\n```\n\nLet me know if you want to adjust any bindings.");
+		return FString(Response.ToView());
+	}
+
+	/** Digital keys that can be bound, each usable once in the rebinding suite */
+	TArray<FKey> GetBindableKeys()
+	{
+		TArray<FKey> AllKeys;
+		EKeys::GetAllKeys(AllKeys);
+
+		TArray<FKey> Keys;
+		for (const FKey& Key : AllKeys)
+		{
+			if (Key.IsValid() && Key.IsBindableInBlueprints() && !Key.IsAxis1D() && !Key.IsAxis2D() && !Key.IsAxis3D()
+				&& !Key.IsTouch() && !Key.IsGesture() && !Key.IsDeprecated())
+			{
+				Keys.Add(Key);
+			}
+		}
+		return Keys;
+	}
+
+	/** Key of the first mapping of an action in a context, or an invalid key */
+	FKey FindMappedKey(const UInputMappingContext* Context, const UInputAction* Action)
+	{
+		if (Context)
+		{
+			for (const FEnhancedActionKeyMapping& Mapping : Context->GetMappings())
+			{
+				if (Mapping.Action == Action)
+				{
+					return Mapping.Key;
+				}
+			}
+		}
+		return EKeys::Invalid;
+	}
+
+	/** Drop objects made only for a benchmark so the next garbage collection frees them */
+	void DiscardObjects(const TArray<UObject*>& Objects)
+	{
+		for (UObject* Object : Objects)
+		{
+			if (Object)
+			{
+				if (Object->IsAsset())
+				{
+					FAssetRegistryModule::AssetDeleted(Object);
+				}
+				Object->ClearFlags(RF_Public | RF_Standalone);
+				Object->MarkAsGarbage();
+			}
+		}
+	}
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FInputStreamlinerParserBenchmark, "InputStreamliner.Benchmark.Parser", InputStreamlinerBenchmark::TestFlags)
+
+void FInputStreamlinerParserBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	InputStreamlinerBenchmark::GetScaleTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FInputStreamlinerParserBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Scale = FCString::Atoi(*Parameters);
+	const ULLMIntentParser* Parser = GetDefault<ULLMIntentParser>();
+	const FString Response = InputStreamlinerBenchmark::BuildRecordedResponse(Scale);
+
+	// Also checks that the fence and brace extraction recovered every action
+	return InputStreamlinerBenchmark::Measure(*this, TEXT("ParseJSONResponse"), Scale, 20, [Parser, &Response, Scale]()
+	{
+		FInputStreamlinerConfiguration Config;
+		FString Error;
+		return Parser->ParseJSONResponse(Response, Config, Error) && Config.Actions.Num() == Scale;
+	});
+}
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FInputStreamlinerGeneratorBenchmark, "InputStreamliner.Benchmark.Generator", InputStreamlinerBenchmark::TestFlags)
+
+void FInputStreamlinerGeneratorBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	InputStreamlinerBenchmark::GetScaleTests(OutBeautifiedNames, OutTestCommands);
+}
+
+bool FInputStreamlinerGeneratorBenchmark::RunTest(const FString& Parameters)
+{
+	const int32 Scale = FCString::Atoi(*Parameters);
+
+	FInputStreamlinerConfiguration Config;
+	FString Error;
+	if (!GetDefault<ULLMIntentParser>()->ParseJSONResponse(InputStreamlinerBenchmark::BuildRecordedResponse(Scale), Config, Error))
+	{
+		AddError(FString::Printf(TEXT("Configuration for %d actions failed to parse: %s"), Scale, *Error));
+		return false;
+	}
+
+	// In memory only: nothing is saved, and the generation manifest and undo buffer are left alone
+	UInputAssetGenerator* Generator = NewObject<UInputAssetGenerator>(GetTransientPackage());
+	Generator->SetTransientGeneration(true);
+
+	// Every run creates its assets from scratch under a fresh path
+	int32 Run = 0;
+	const bool bPassed = InputStreamlinerBenchmark::Measure(*this, TEXT("GenerateInputAssets"), Scale, 3, [Generator, &Config, Scale, &Run]()
+	{
+		const FString Root = FString::Printf(TEXT("%s/%d_%d"), InputStreamlinerBenchmark::GeneratorRoot, Scale, Run++);
+		Config.InputActionsPath = Root / TEXT("Actions");
+		Config.MappingContextsPath = Root / TEXT("Contexts");
+
+		TArray<UObject*> CreatedAssets;
+		const bool bGenerated = Generator->GenerateInputAssets(Config, CreatedAssets);
+		InputStreamlinerBenchmark::DiscardObjects(CreatedAssets);
+		return bGenerated && CreatedAssets.Num() >= Scale;
+	});
+
+	InputStreamlinerBenchmark::DiscardObjects({ Generator });
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	return bPassed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputStreamlinerRebindingBenchmark, "InputStreamliner.Benchmark.Rebinding", InputStreamlinerBenchmark::TestFlags)
+
+bool FInputStreamlinerRebindingBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace InputStreamlinerBenchmark;
+
+	// Half the keys are bound, the other half are free for ApplyBinding to move to
+	const TArray<FKey> Keys = GetBindableKeys();
+	const int32 NumBound = FMath::Min(Keys.Num() / 2, RebindingActions);
+	if (!TestTrue(TEXT("Bindable keys are available"), NumBound > 0))
+	{
+		return false;
+	}
+
+	// Standalone: no local player, game instance, Enhanced Input subsystem or save file
+	ULocalPlayerRebindingManager* Manager = NewObject<ULocalPlayerRebindingManager>(GetTransientPackage());
+
+	// The two contexts map every bound action to different keys, so each switch brings every mapping back in line
+	UInputMappingContext* ContextA = NewObject<UInputMappingContext>(GetTransientPackage());
+	UInputMappingContext* ContextB = NewObject<UInputMappingContext>(GetTransientPackage());
+
+	TArray<UInputAction*> Actions;
+	Actions.Reserve(RebindingActions);
+	for (int32 i = 0; i < RebindingActions; i++)
+	{
+		UInputAction* Action = NewObject<UInputAction>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UInputAction::StaticClass(), TEXT("IA_Benchmark")));
+		Actions.Add(Action);
+
+		if (i < NumBound)
+		{
+			ContextA->MapKey(Action, Keys[i]);
+			ContextB->MapKey(Action, Keys[i + NumBound]);
+			Manager->ApplyBinding(Action, Keys[i], 0);
+		}
+	}
+	Manager->SetMappingContext(ContextA, 0);
+
+	bool bPassed = TestTrue(TEXT("Mapping context copy uses the current binding"), FindMappedKey(Manager->GetMappingContext(), Actions[0]) == Keys[0]);
+
+	// Each action asks for the next action's key: the first NumBound keys belong to Actions[KeyIndex], the rest are free
+	bPassed &= Measure(*this, TEXT("HasConflict"), RebindingActions, 50, [Manager, &Actions, &Keys, NumBound]()
+	{
+		for (int32 i = 0; i < Actions.Num(); i++)
+		{
+			const int32 KeyIndex = (i + 1) % Keys.Num();
+			UInputAction* const Expected = KeyIndex < NumBound ? Actions[KeyIndex] : nullptr;
+
+			UInputAction* Conflicting = nullptr;
+			const bool bConflict = Manager->HasConflict(Actions[i], Keys[KeyIndex], Conflicting);
+			if (bConflict != (Expected != nullptr) || Conflicting != Expected)
+			{
+				return false;
+			}
+
+			// The reported action really holds the key
+			if (Conflicting && !Manager->GetBindingsForAction(Conflicting).Contains(Keys[KeyIndex]))
+			{
+				return false;
+			}
+		}
+		return true;
+	});
+
+	// Each pass moves every bound action between its key and a free one, so nothing conflicts
+	int32 Pass = 0;
+	bPassed &= Measure(*this, TEXT("ApplyBinding"), RebindingActions, 10, [Manager, &Actions, &Keys, NumBound, &Pass]()
+	{
+		const int32 Offset = (Pass++ % 2 == 0) ? NumBound : 0;
+		for (int32 i = 0; i < NumBound; i++)
+		{
+			if (!Manager->ApplyBinding(Actions[i], Keys[i + Offset], 0))
+			{
+				return false;
+			}
+		}
+		return FindMappedKey(Manager->GetMappingContext(), Actions[0]) == Keys[Offset];
+	});
+
+	// Switching contexts copies the new one and applies the current bindings to the copy
+	int32 SwitchPass = 0;
+	bPassed &= Measure(*this, TEXT("SetMappingContext"), RebindingActions, 10, [Manager, ContextA, ContextB, &Actions, &SwitchPass]()
+	{
+		Manager->SetMappingContext(SwitchPass++ % 2 == 0 ? ContextB : ContextA, 0);
+
+		const TArray<FKey> Bindings = Manager->GetBindingsForAction(Actions[0]);
+		return Manager->GetMappingContext() != Manager->GetSourceMappingContext()
+			&& Bindings.Num() > 0 && FindMappedKey(Manager->GetMappingContext(), Actions[0]) == Bindings[0];
+	});
+
+	bPassed &= TestTrue(TEXT("Source context A is untouched"), FindMappedKey(ContextA, Actions[0]) == Keys[0]);
+	bPassed &= TestTrue(TEXT("Source context B is untouched"), FindMappedKey(ContextB, Actions[0]) == Keys[NumBound]);
+
+	TArray<UObject*> Objects(Actions);
+	Objects.Add(Manager->GetMappingContext());
+	Objects.Add(ContextA);
+	Objects.Add(ContextB);
+	Objects.Add(Manager);
+	DiscardObjects(Objects);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	return bPassed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputStreamlinerJoystickBenchmark, "InputStreamliner.Benchmark.Joystick", InputStreamlinerBenchmark::TestFlags)
+
+bool FInputStreamlinerJoystickBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace InputStreamlinerBenchmark;
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!TestNotNull(TEXT("Editor world"), World))
+	{
+		return false;
+	}
+
+	// No owning player or linked action: measures touch handling and value processing, not Enhanced Input injection
+	UVirtualJoystickWidget* Joystick = CreateWidget<UVirtualJoystickWidget>(World);
+	if (!TestNotNull(TEXT("Joystick widget"), Joystick))
+	{
+		return false;
+	}
+
+	bool bPassed = true;
+	{
+		// Touch events reach the widget through its Slate widget, as they do on a device
+		TSharedRef<SWidget> SlateWidget = Joystick->TakeWidget();
+
+		const FVector2D Size(Joystick->VisualSize, Joystick->VisualSize);
+		const FGeometry Geometry = FGeometry::MakeRoot(Size, FSlateLayoutTransform());
+		const FVector2D Center = Size * 0.5;
+
+		const FPointerEvent Press(0, 0, Center, Center, 1.0f, false);
+		bPassed &= TestTrue(TEXT("Touch start is handled"), SlateWidget->OnTouchStarted(Geometry, Press).IsEventHandled());
+		bPassed &= TestTrue(TEXT("Touch in the dead zone gives no value"), Joystick->GetValueWithDeadZone().IsNearlyZero());
+
+		// A touch circling past the edge of the joystick, so both clamped and unclamped offsets are covered
+		TArray<FPointerEvent> Events;
+		Events.Reserve(JoystickEvents);
+		for (int32 i = 0; i < JoystickEvents; i++)
+		{
+			const double Angle = i * (UE_TWO_PI / 64.0);
+			const double Radius = Joystick->VisualSize * (0.1 + 0.6 * (i % 10) / 10.0);
+			const FVector2D Position = Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius;
+			Events.Emplace(0, 0, Position, Position, 1.0f, false);
+		}
+
+		bPassed &= Measure(*this, TEXT("TouchMoved"), JoystickEvents, 50, [&SlateWidget, &Geometry, &Events]()
+		{
+			bool bHandled = true;
+			for (const FPointerEvent& Event : Events)
+			{
+				bHandled &= SlateWidget->OnTouchMoved(Geometry, Event).IsEventHandled();
+			}
+			return bHandled;
+		});
+
+		// Remaps the value of each touch position in turn, so every dead zone branch is taken
+		bPassed &= Measure(*this, TEXT("GetValueWithDeadZone"), JoystickEvents, 50, [Joystick, &SlateWidget, &Geometry, &Events]()
+		{
+			for (const FPointerEvent& Event : Events)
+			{
+				SlateWidget->OnTouchMoved(Geometry, Event);
+				const FVector2D Value = Joystick->GetValueWithDeadZone();
+				if (Value.ContainsNaN() || Value.Size() > 1.0 + KINDA_SMALL_NUMBER)
+				{
+					return false;
+				}
+			}
+			return true;
+		});
+
+		const FPointerEvent Release(0, 0, Center, Center, 0.0f, false);
+		bPassed &= TestTrue(TEXT("Touch end is handled"), SlateWidget->OnTouchEnded(Geometry, Release).IsEventHandled());
+		bPassed &= TestTrue(TEXT("Releasing recenters the joystick"), Joystick->GetValueWithDeadZone().IsNearlyZero());
+	}
+
+	Joystick->ReleaseSlateResources(true);
+	DiscardObjects({ Joystick });
+	return bPassed;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS